@@ -1,6 +1,7 @@
 #pragma once
 #include "core/core_types.h"
 #include <memory>
+#include <cstdlib>
 #include <vector>
 
 namespace Audio
@@ -33,12 +34,27 @@ namespace Audio
 	template <typename T, typename S> // Target, Source
 	constexpr T ScaleSampleILinear_Clamped(S v, f32 linear) { return ClampSampleI<T>(v * linear); }
 
+	// NOTE: Decoded samples are adopted as is from the decoding libraries (which allocate using malloc) instead of being copied into a new[] allocation
+	struct SampleBufferDeleter
+	{
+		b8 IsMallocAllocated = false;
+
+		template <typename SampleType>
+		void operator()(SampleType* samples) const { if (IsMallocAllocated) ::free(samples); else delete[] samples; }
+	};
+
+	template <typename SampleType>
+	using UniqueSampleBuffer = std::unique_ptr<SampleType[], SampleBufferDeleter>;
+
+	template <typename SampleType>
+	inline UniqueSampleBuffer<SampleType> AdoptMallocAllocatedSampleBuffer(SampleType* mallocAllocatedSamples) { return UniqueSampleBuffer<SampleType>(mallocAllocatedSamples, SampleBufferDeleter { true }); }
+
 	struct PCMSampleBuffer
 	{
 		u32 ChannelCount;
 		u32 SampleRate;
 		i64 FrameCount;
-		std::unique_ptr<i16[]> InterleavedSamples;
+		UniqueSampleBuffer<i16> InterleavedSamples;
 
 		constexpr size_t SampleCount() const { return (FrameCount * ChannelCount); }
 		constexpr size_t ByteSize() const { return (FrameCount * ChannelCount * sizeof(i16)); }
@@ -180,51 +196,6 @@ namespace Audio
 		return sampleTypeResult;
 	}
 
-	// NOTE: Low quallity linear resampling lacking a low pass filter, should however still be better than having sped up audio for now
-	template <typename SampleType>
-	void LinearlyResampleBuffer(std::unique_ptr<SampleType[]>& inOutSamples, size_t& inOutFrameCount, u32& inOutSampleRate, const u32 inChannelCount, const u32 targetSampleRate)
-	{
-		if (inOutSampleRate == targetSampleRate) { assert(false); return; }
-
-		const SampleType* inSamples = inOutSamples.get();
-		const size_t inSampleCount = (inOutFrameCount * inChannelCount);
-
-		const f64 sourceRate = static_cast<f64>(inOutSampleRate);
-		const f64 targetRate = static_cast<f64>(targetSampleRate);
-
-		const size_t inFrameCount = (inSampleCount / inChannelCount);
-		const size_t outFrameCount = static_cast<size_t>(inFrameCount * targetRate / sourceRate + 0.5);
-
-		const size_t outSampleCount = (outFrameCount * inChannelCount);
-		// auto outSamples = std::make_unique<SampleType[]>(outSampleCount);
-		auto outSamples = std::unique_ptr<SampleType[]>(new SampleType[outSampleCount]);
-
-		const f64 outFrameToSecond = (1.0 / targetRate);
-		SampleType* outSampleWriteHead = outSamples.get();
-
-		for (size_t frame = 0; frame < outFrameCount; frame++)
-		{
-			const f64 second = (static_cast<f64>(frame) * outFrameToSecond);
-
-			for (u32 channel = 0; channel < inChannelCount; channel++)
-				outSampleWriteHead[channel] = LinearSampleAtTimeOrZero<SampleType>(second, channel, inSamples, inSampleCount, sourceRate, inChannelCount);
-
-			outSampleWriteHead += inChannelCount;
-		}
-
-		inOutSamples = std::move(outSamples);
-		inOutFrameCount = outFrameCount;
-		inOutSampleRate = targetSampleRate;
-	}
-
-	template <typename SampleType>
-	void LinearlyResampleBuffer(std::unique_ptr<SampleType[]>& inOutSamples, i64& inOutFrameCount, u32& inOutSampleRate, const u32 inChannelCount, const u32 targetSampleRate)
-	{
-		size_t inOutFrameCountSizeT = static_cast<size_t>(inOutFrameCount);
-		Audio::LinearlyResampleBuffer(inOutSamples, inOutFrameCountSizeT, inOutSampleRate, inChannelCount, targetSampleRate);
-		inOutFrameCount = static_cast<i64>(inOutFrameCountSizeT);
-	}
-
 	template <typename T>
 	constexpr T NextRingBufferIndex(T index, size_t size) {
 		auto res = (index + 1 >= size) ? index + 1 - static_cast<T>(size) : index + 1;
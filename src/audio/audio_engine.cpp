@@ -1,8 +1,11 @@
 #include "audio_engine.h"
 #include "audio_file_formats.h"
 #include "audio_backend.h"
+#include "audio_simd.h"
+#include "audio_stream.h"
 #include "core_io.h"
 #include <mutex>
+#include <thread>
 
 namespace Audio
 {
@@ -33,8 +36,23 @@ namespace Audio
 		VoiceFlags_RemoveOnEnd = 1 << 4,
 		VoiceFlags_PauseOnEnd = 1 << 5,
 		VoiceFlags_VariablePlaybackSpeed = 1 << 6,
+		// NOTE: Set by the main thread on RemoveVoice(), the slot only becomes reusable once the render thread has processed the remove command
+		VoiceFlags_PendingRemove = 1 << 7,
 	};
 
+	// NOTE: Only modify the flags of a voice that is still alive so that a voice concurrently killed by the render thread is never resurrected
+	static b8 TryUpdateAliveVoiceFlags(std::atomic<VoiceFlags>& flags, VoiceFlags flagsToSet, VoiceFlags flagsToClear)
+	{
+		VoiceFlags expected = flags.load();
+		do
+		{
+			if (!(expected & VoiceFlags_Alive))
+				return false;
+		}
+		while (!flags.compare_exchange_weak(expected, static_cast<VoiceFlags>((expected | flagsToSet) & ~flagsToClear)));
+		return true;
+	}
+
 	// NOTE: Indexed into by VoiceHandle, slot valid if Flags != VoiceFlags_Dead
 	struct VoiceData
 	{
@@ -67,17 +85,75 @@ namespace Audio
 		} VolumeMap;
 
 		char Name[64];
+
+		// NOTE: Only ever accessed by the render thread (or by the main thread while the stream is closed),
+		//		 set once the AddVoice command has been processed and cleared again once the voice is dead.
+		//		 Mirrors whether or not the voice is part of the CallbackActiveVoices list
+		b8 CallbackActive;
 	};
 
 	// NOTE: Indexed into by SourceHandle, slot valid if SlotUsed
 	struct SourceData
 	{
 		std::atomic<bool> SlotUsed;
+		std::atomic<bool> PendingUnload;
+		// NOTE: For streaming sources the buffer only describes the format while the samples are read from the stream instead
 		PCMSampleBuffer Buffer;
+		std::unique_ptr<PCMSampleStream> Stream;
 		std::atomic<f32> BaseVolume = 0.0f;
 		char Name[256];
 	};
 
+	// NOTE: Lock-free single-producer single-consumer ring buffer, the producer being the main thread and the consumer the render thread
+	template <typename T, size_t Capacity>
+	struct SPSCRingBuffer
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+		std::array<T, Capacity> Items = {};
+		alignas(64) std::atomic<size_t> WriteIndex = 0;
+		alignas(64) std::atomic<size_t> ReadIndex = 0;
+
+		b8 TryPush(const T& item)
+		{
+			const size_t writeIndex = WriteIndex.load(std::memory_order_relaxed);
+			if ((writeIndex - ReadIndex.load(std::memory_order_acquire)) >= Capacity)
+				return false;
+
+			Items[writeIndex & (Capacity - 1)] = item;
+			WriteIndex.store(writeIndex + 1, std::memory_order_release);
+			return true;
+		}
+
+		b8 TryPop(T& outItem)
+		{
+			const size_t readIndex = ReadIndex.load(std::memory_order_relaxed);
+			if (readIndex == WriteIndex.load(std::memory_order_acquire))
+				return false;
+
+			outItem = Items[readIndex & (Capacity - 1)];
+			ReadIndex.store(readIndex + 1, std::memory_order_release);
+			return true;
+		}
+	};
+
+	enum class VoiceCommandType : u8
+	{
+		AddVoice,
+		RemoveVoice,
+		SetFlags,
+		ClearFlags,
+		UnloadSource,
+	};
+
+	struct VoiceCommand
+	{
+		VoiceCommandType Type;
+		VoiceFlags Flags;
+		VoiceHandle Voice;
+		SourceHandle Source;
+	};
+
 	struct AudioEngine::Impl
 	{
 	public:
@@ -91,7 +167,12 @@ namespace Audio
 		std::unique_ptr<IAudioBackend> CurrentBackend = nullptr;
 
 	public:
-		std::mutex VoiceRenderMutex;
+		// NOTE: Structural voice / source changes are sent to the render thread instead of locking it out, so that the callback never blocks.
+		//		 Commands are pushed by the main thread only, while the stream is closed they are processed immediately on the main thread instead
+		SPSCRingBuffer<VoiceCommand, 1024> VoiceCommands;
+
+		// NOTE: Only guards source slot allocation between (async) loading threads and is never taken by the render thread
+		std::mutex SourceSlotMutex;
 
 		// NOTE: Slot maps indexed into via handles
 		std::array<VoiceData, MaxSimultaneousVoices> VoicePool;
@@ -100,7 +181,14 @@ namespace Audio
 	public:
 		std::array<i16, (MaxBufferFrameCount * OutputChannelCount)> TempOutputBuffer = {};
 		std::array<f32, (MaxBufferFrameCount* OutputChannelCount)> MasterBuffer = {};
-		std::array<f32, (MaxBufferFrameCount* OutputChannelCount)> SoundGroupBuffer = {};
+		std::array<std::array<f32, (MaxBufferFrameCount* OutputChannelCount)>, MaxSoundGroups> SoundGroupBuffers = {};
+		std::array<f32, MaxBufferFrameCount> FrameGainBuffer = {};
+		std::array<f32, MaxBufferFrameCount> FramePeakBuffer = {};
+
+		// NOTE: Compact list of all voices that have been added on the render thread side, so that the callback cost scales with the number of live voices
+		//		 instead of the pool size. Unordered, removal swaps in the last element
+		std::array<VoiceHandle, MaxSimultaneousVoices> CallbackActiveVoices = {};
+		size_t CallbackActiveVoiceCount = 0;
 		u32 CurrentBufferFrameSize = DefaultBufferFrameCount;
 		u32 TargetBufferFrameSize = DefaultBufferFrameCount;
 
@@ -129,7 +217,8 @@ namespace Audio
 				return nullptr;
 
 			VoiceData* voiceData = &VoicePool[handleIndex];
-			return (voiceData->Flags & VoiceFlags_Alive) ? voiceData : nullptr;
+			const VoiceFlags flags = voiceData->Flags;
+			return ((flags & VoiceFlags_Alive) && !(flags & VoiceFlags_PendingRemove)) ? voiceData : nullptr;
 		}
 
 		enum class GetSourceDataParam : u8 { None, ValidateBuffer };
@@ -144,7 +233,7 @@ namespace Audio
 				return nullptr;
 
 			if (param == GetSourceDataParam::ValidateBuffer)
-				return (sourceData->Buffer.InterleavedSamples != nullptr) && (sourceData->Buffer.SampleRate > 0) ? sourceData : nullptr;
+				return (sourceData->Buffer.InterleavedSamples != nullptr || sourceData->Stream != nullptr) && (sourceData->Buffer.SampleRate > 0) ? sourceData : nullptr;
 			else
 				return sourceData;
 		}
@@ -175,6 +264,111 @@ namespace Audio
 				CopyStringViewIntoFixedBuffer(sourceData->Name, newName);
 		}
 
+		void PushVoiceCommand(const VoiceCommand& command)
+		{
+			while (!VoiceCommands.TryPush(command))
+			{
+				// NOTE: Only possible if the render thread has stalled for over a thousand commands, so rather wait here than lose track of a slot
+				if (!IsStreamOpenRunning)
+					CallbackProcessVoiceCommands();
+				else
+					std::this_thread::yield();
+			}
+
+			if (!IsStreamOpenRunning)
+				CallbackProcessVoiceCommands();
+		}
+
+		void CallbackProcessVoiceCommands()
+		{
+			VoiceCommand command;
+			while (VoiceCommands.TryPop(command))
+			{
+				switch (command.Type)
+				{
+				case VoiceCommandType::AddVoice:
+				{
+					VoiceData& voiceData = VoicePool[VoiceHandleToIndex(command.Voice)];
+					if (!voiceData.CallbackActive)
+					{
+						voiceData.CallbackActive = true;
+						CallbackActiveVoices[CallbackActiveVoiceCount++] = command.Voice;
+					}
+				} break;
+				case VoiceCommandType::RemoveVoice:
+				{
+					// NOTE: Might have already been killed by VoiceFlags_RemoveOnEnd in which case the slot could now be pending to be reused
+					VoiceData& voiceData = VoicePool[VoiceHandleToIndex(command.Voice)];
+					if (voiceData.CallbackActive)
+					{
+						for (size_t i = 0; i < CallbackActiveVoiceCount; i++)
+						{
+							if (CallbackActiveVoices[i] == command.Voice)
+							{
+								CallbackRemoveActiveVoiceAt(i);
+								break;
+							}
+						}
+					}
+				} break;
+				case VoiceCommandType::SetFlags:
+				case VoiceCommandType::ClearFlags:
+				{
+					// NOTE: Reapply the latest requested state at the buffer boundary, so that an end-of-source transition
+					//		 of the previous buffer can't override a change requested by the main thread mid-render
+					VoiceData& voiceData = VoicePool[VoiceHandleToIndex(command.Voice)];
+					if (!voiceData.CallbackActive)
+						break;
+
+					const b8 set = (command.Type == VoiceCommandType::SetFlags);
+					if (TryUpdateAliveVoiceFlags(voiceData.Flags, set ? command.Flags : 0, set ? 0 : command.Flags) && (command.Flags & VoiceFlags_Playing))
+						voiceData.SmoothTime.RequestUpdate = true;
+				} break;
+				case VoiceCommandType::UnloadSource:
+				{
+					for (VoiceData& voiceData : VoicePool)
+					{
+						if ((voiceData.Flags & VoiceFlags_Alive) && voiceData.Source == command.Source)
+							voiceData.Source = SourceHandle::Invalid;
+					}
+
+					// NOTE: No voice references the buffer anymore so the slot (and with it the old buffer) can now be reused by the loading threads
+					SourceData& sourceData = LoadedSources[SourceHandleToIndex(command.Source)];
+					sourceData.PendingUnload = false;
+					sourceData.SlotUsed = false;
+				} break;
+				}
+			}
+		}
+
+		SourceHandle LoadSourceIntoFreeSlot(std::string_view sourceName, PCMSampleBuffer bufferToMove, std::unique_ptr<PCMSampleStream> streamToMove)
+		{
+			const auto lock = std::scoped_lock(SourceSlotMutex);
+			for (HandleBaseType index = 0; index < static_cast<HandleBaseType>(LoadedSources.size()); index++)
+			{
+				SourceData& sourceData = LoadedSources[index];
+				if (sourceData.SlotUsed)
+					continue;
+
+				// NOTE: Fully initialize before publishing the slot to the render thread.
+				//		 Destroying a previous stream stops its worker thread, which is fine to wait for here as the render thread has already let go of it
+				sourceData.Stream = std::move(streamToMove);
+				sourceData.Buffer = std::move(bufferToMove);
+				sourceData.BaseVolume = 1.0f;
+				CopyStringViewIntoFixedBuffer(sourceData.Name, sourceName);
+				sourceData.PendingUnload = false;
+				sourceData.SlotUsed = true;
+
+				return static_cast<SourceHandle>(index);
+			}
+
+#if PEEPO_DEBUG
+			assert(!"Consider increasing MaxLoadedSources");
+#endif
+
+			return SourceHandle::Invalid;
+		}
+
 		template <typename T>
 		void CallbackClearOutBuffer(T* outputBuffer, const size_t sampleCount)
 		{
@@ -197,6 +391,8 @@ namespace Audio
 
 		void CallbackApplyVoiceVolumeAndMixTempBufferIntoOutput(f32* outputBuffer, const i64 frameCount, const VoiceData& voiceData, const u32 sampleRate)
 		{
+			static_assert(OutputChannelCount == 2, "Mixing kernels only support interleaved stereo");
+
 			const f32 voiceVolume = voiceData.Volume * GetSourceBaseVolume(voiceData.Source);
 			const f32 startVolume = voiceData.VolumeMap.StartVolume;
 			const f32 endVolume = voiceData.VolumeMap.EndVolume;
@@ -204,14 +400,10 @@ namespace Audio
 			// NOTE: currently pan as L/R balance rather than true stereo pan for simplicity
 			const b8 doPan = (OutputChannelCount >= 2) && !ApproxmiatelySame(voiceData.Pan, 0);
 			const auto panGain = doPan ? GetPanGain(voiceData.Pan, PanLaw) : std::array{ 1.0f, 1.0f };
-			auto channelGain = [&](u32 iCh, f32 vol) { return (doPan && iCh < 2) ? vol * panGain[iCh] : vol; };
 
 			if (startVolume == endVolume)
 			{
-				for (i64 i = 0, n = (frameCount * OutputChannelCount); i < n;) {
-					for (u32 c = 0; c < OutputChannelCount; ++c, ++i)
-						outputBuffer[i] += TempOutputBuffer[i] * channelGain(c, voiceVolume);
-				}
+				MixStereoI16WithGain(outputBuffer, TempOutputBuffer.data(), frameCount, voiceVolume * panGain[0], voiceVolume * panGain[1]);
 			}
 			else
 			{
@@ -224,39 +416,40 @@ namespace Audio
 					const Time bufferDuration = Time::FromSec(frameDuration.ToSec() * frameCount);
 					const Time voiceStartTime = Time::FromSec(voiceData.TimePositionSec) - bufferDuration;
 
-					for (i64 f = 0, i = 0; f < frameCount; ++f)
+					for (i64 f = 0; f < frameCount; ++f)
 					{
 						const Time frameTime = Time::FromSec(voiceStartTime.ToSec() + (f * frameDuration.ToSec()));
-						const f32 frameVolume = SampleVolumeMapAt(volumeMapStartFrame, volumeMapEndFrame, startVolume, endVolume, TimeToFrames(frameTime, sampleRate)) * voiceVolume;
-						for (u32 c = 0; c < OutputChannelCount; ++c, ++i)
-							outputBuffer[i] += TempOutputBuffer[i] * channelGain(c, frameVolume);
+						FrameGainBuffer[f] = SampleVolumeMapAt(volumeMapStartFrame, volumeMapEndFrame, startVolume, endVolume, TimeToFrames(frameTime, sampleRate)) * voiceVolume;
 					}
 				}
 				else
 				{
 					const i64 voiceStartFrame = (voiceData.FramePosition - frameCount);
 
-					for (i64 f = 0, i = 0; f < frameCount; ++f)
-					{
-						const f32 frameVolume = SampleVolumeMapAt(volumeMapStartFrame, volumeMapEndFrame, startVolume, endVolume, voiceStartFrame + f) * voiceVolume;
-						for (u32 c = 0; c < OutputChannelCount; ++c, ++i)
-							outputBuffer[i] += TempOutputBuffer[i] * channelGain(c, frameVolume);
-					}
+					for (i64 f = 0; f < frameCount; ++f)
+						FrameGainBuffer[f] = SampleVolumeMapAt(volumeMapStartFrame, volumeMapEndFrame, startVolume, endVolume, voiceStartFrame + f) * voiceVolume;
 				}
+
+				MixStereoI16WithFrameGains(outputBuffer, TempOutputBuffer.data(), FrameGainBuffer.data(), frameCount, panGain[0], panGain[1]);
 			}
 		}
 
-		void CallbackProcessVoices(f32* outputBuffer, const u32 bufferFrameCount, const u32 bufferSampleCount, i32 soundGroup)
+		void CallbackRemoveActiveVoiceAt(size_t activeIndex)
 		{
-			const auto lock = std::scoped_lock(VoiceRenderMutex);
+			VoiceData& voiceData = VoicePool[VoiceHandleToIndex(CallbackActiveVoices[activeIndex])];
+			voiceData.CallbackActive = false;
+			voiceData.Flags = VoiceFlags_Dead;
+			CallbackActiveVoices[activeIndex] = CallbackActiveVoices[--CallbackActiveVoiceCount];
+		}
 
-			for (size_t voiceIndex = 0; voiceIndex < VoicePool.size(); voiceIndex++)
+		// NOTE: Renders every active voice exactly once into the accumulation buffer of its sound group (sound group 0 or any invalid group mixing directly into master)
+		void CallbackProcessVoices(const u32 bufferFrameCount)
+		{
+			for (size_t activeIndex = 0; activeIndex < CallbackActiveVoiceCount;)
 			{
-				VoiceData& voiceData = VoicePool[voiceIndex];
-				if (i32 group = voiceData.SoundGroup; !(group == soundGroup || ((soundGroup == 0) && !(group >= 0 && group < MaxSoundGroups))))
-					continue;
-				if (!(voiceData.Flags & VoiceFlags_Alive))
-					continue;
+				VoiceData& voiceData = VoicePool[VoiceHandleToIndex(CallbackActiveVoices[activeIndex])];
+				const i32 group = voiceData.SoundGroup;
+				f32* outputBuffer = (group > 0 && group < MaxSoundGroups) ? SoundGroupBuffers[group].data() : MasterBuffer.data();
 
 				// TODO: Handle sample rate mismatch (by always setting variable playback speed?)
 				SourceData* sourceData = TryGetSourceData(voiceData.Source, GetSourceDataParam::ValidateBuffer);
@@ -290,19 +483,27 @@ namespace Audio
 				{
 					if (!playPastEnd && (voiceData.Flags & VoiceFlags_RemoveOnEnd))
 					{
-						voiceData.Flags = VoiceFlags_Dead;
+						CallbackRemoveActiveVoiceAt(activeIndex);
 						continue;
 					}
 					else if (voiceData.Flags & VoiceFlags_PauseOnEnd)
 					{
 						voiceData.Flags &= ~VoiceFlags_Playing;
-						continue;
 					}
 				}
+
+				activeIndex++;
 			}
 
-			if (soundGroup == 0)
-				TotalRenderedFrames += bufferFrameCount;
+			TotalRenderedFrames += bufferFrameCount;
+		}
+
+		i64 CallbackReadSourceAtOrFillSilence(SourceData& sourceData, i64 frameOffset, i64 frameCount, i16 outSamples[])
+		{
+			if (sourceData.Stream != nullptr)
+				return sourceData.Stream->ReadAtOrFillSilence(frameOffset, frameCount, outSamples);
+			else
+				return sourceData.Buffer.ReadAtOrFillSilence(frameOffset, frameCount, outSamples);
 		}
 
 		void CallbackProcessNormalSpeedVoiceSamples(f32* outputBuffer, const u32 bufferFrameCount, const b8 playPastEnd, const b8 hasReachedEnd, VoiceData& voiceData, SourceData* sourceData)
@@ -314,10 +515,16 @@ namespace Audio
 			}
 
 			i64 framesRead = 0;
-			if (sourceData->Buffer.ChannelCount != 0 && sourceData->Buffer.ChannelCount != OutputChannelCount)
-				framesRead = ChannelMixer.MixChannels(sourceData->Buffer, TempOutputBuffer.data(), voiceData.FramePosition, bufferFrameCount);
+			if (const u32 sourceChannelCount = sourceData->Buffer.ChannelCount; sourceChannelCount != 0 && sourceChannelCount != OutputChannelCount)
+			{
+				i16* mixBuffer = ChannelMixer.GetMixSampleBufferWithMinSize(bufferFrameCount * sourceChannelCount);
+				const i64 mixFramesRead = CallbackReadSourceAtOrFillSilence(*sourceData, voiceData.FramePosition, bufferFrameCount, mixBuffer);
+				framesRead = ChannelMixer.MixChannels(sourceChannelCount, mixBuffer, mixFramesRead, TempOutputBuffer.data(), voiceData.FramePosition, bufferFrameCount);
+			}
 			else
-				framesRead = sourceData->Buffer.ReadAtOrFillSilence(voiceData.FramePosition, bufferFrameCount, TempOutputBuffer.data());
+			{
+				framesRead = CallbackReadSourceAtOrFillSilence(*sourceData, voiceData.FramePosition, bufferFrameCount, TempOutputBuffer.data());
+			}
 
 			voiceData.FramePosition += framesRead;
 			if (hasReachedEnd && !playPastEnd)
@@ -331,7 +538,30 @@ namespace Audio
 			const u32 sampleRate = (sourceData != nullptr) ? sourceData->Buffer.SampleRate : OutputSampleRate;
 			const f64 bufferDurationSec = (FramesToTime(bufferFrameCount, sampleRate).ToSec() * voiceData.PlaybackSpeed);
 
+			const f64 sampleDurationSec = (1.0 / static_cast<i64>(sampleRate)) * voiceData.PlaybackSpeed;
+			const i64 framesRead = static_cast<i64>(Round(bufferDurationSec / sampleDurationSec));
+
+			const f64 sampleRateF64 = static_cast<f64>(sampleRate);
+			const f64 voiceStartTimeSec = voiceData.TimePositionSec;
+
 			const i16* rawSamples = (sourceData != nullptr) ? sourceData->Buffer.InterleavedSamples.get() : nullptr;
+			size_t providerSampleCount = (sourceData != nullptr) ? sourceData->Buffer.SampleCount() : 0;
+			f64 rawSamplesStartTimeSec = 0.0;
+
+			if (sourceData != nullptr && sourceData->Stream != nullptr)
+			{
+				// NOTE: Read the entire range of frames to interpolate between upfront and then sample relative to its start
+				PCMSampleStream& stream = *sourceData->Stream;
+				const i64 firstFrame = static_cast<i64>(Floor(voiceStartTimeSec * sampleRateF64)) - 1;
+				const i64 frameSpan = static_cast<i64>(Ceil(framesRead * voiceData.PlaybackSpeed)) + 3;
+				if (frameSpan <= PCMSampleStream::MaxScratchFrameCount)
+				{
+					stream.ReadAtOrFillSilence(firstFrame, frameSpan, stream.ScratchSamples.get());
+					rawSamples = stream.ScratchSamples.get();
+					providerSampleCount = static_cast<size_t>(frameSpan * stream.ChannelCount);
+					rawSamplesStartTimeSec = FramesToTime(firstFrame, sampleRate).ToSec();
+				}
+			}
 
 			if (sourceData == nullptr || rawSamples == nullptr)
 			{
@@ -339,22 +569,15 @@ namespace Audio
 				return;
 			}
 
-			const f64 sampleDurationSec = (1.0 / static_cast<i64>(sampleRate)) * voiceData.PlaybackSpeed;
-			const i64 framesRead = static_cast<i64>(Round(bufferDurationSec / sampleDurationSec));
-
-			const size_t providerSampleCount = sourceData->Buffer.SampleCount();
 			const u32 providerChannelCount = sourceData->Buffer.ChannelCount;
 
-			const f64 sampleRateF64 = static_cast<f64>(sampleRate);
-			const f64 voiceStartTimeSec = voiceData.TimePositionSec;
-
 			if (providerChannelCount != OutputChannelCount)
 			{
 				i16* mixBuffer = ChannelMixer.GetMixSampleBufferWithMinSize(framesRead * providerChannelCount);
 
 				for (i64 f = 0; f < framesRead; f++)
 				{
-					const f64 frameTimeSec = voiceStartTimeSec + (f * sampleDurationSec);
+					const f64 frameTimeSec = (voiceStartTimeSec + (f * sampleDurationSec)) - rawSamplesStartTimeSec;
 					for (u32 c = 0; c < providerChannelCount; c++)
 						mixBuffer[(f * providerChannelCount) + c] = LinearSampleAtTimeOrZero<i16>(frameTimeSec, c, rawSamples, providerSampleCount, sampleRateF64, providerChannelCount);
 				}
@@ -365,7 +588,7 @@ namespace Audio
 			{
 				for (i64 f = 0; f < framesRead; f++)
 				{
-					const f64 frameTimeSec = voiceStartTimeSec + (f * sampleDurationSec);
+					const f64 frameTimeSec = (voiceStartTimeSec + (f * sampleDurationSec)) - rawSamplesStartTimeSec;
 					for (u32 c = 0; c < OutputChannelCount; c++)
 						TempOutputBuffer[(f * OutputChannelCount) + c] = LinearSampleAtTimeOrZero<i16>(frameTimeSec, c, rawSamples, providerSampleCount, sampleRateF64, OutputChannelCount);
 				}
@@ -383,24 +606,16 @@ namespace Audio
 		{
 			const f32 limitMin = (std::is_integral_v<T> || soundGroup == 0) ? I16Min : SoundGroupVolumeLimit * I16Min;
 			const f32 limitMax = (std::is_integral_v<T> || soundGroup == 0) ? I16Max : SoundGroupVolumeLimit * I16Max;
-			std::array<f32, OutputChannelCount> frame;
-			for (size_t f = 0, i = 0; f < frameCount; ++f) {
-				// get gain for all channels first
-				f32 frameMaxValue = 0;
-				for (i32 c = 0; c < OutputChannelCount; ++c) {
-					frame[c] = mixedBuffer[i + c] * preGain;
-					if (std::abs(frame[c]) > std::abs(frameMaxValue))
-						frameMaxValue = frame[c];
-				}
-				auto gain = Limiter[soundGroup].GetGain(frameMaxValue, limitMin, limitMax);
-				// apply gain
-				for (i32 c = 0; c < OutputChannelCount; ++c, ++i) {
-					if constexpr (std::is_integral_v<T>)
-						outputBuffer[i] += ClampSampleI<T>(frame[c] * gain * postGain);
-					else
-						outputBuffer[i] += frame[c] * gain * postGain;
-				}
-			}
+
+			// NOTE: The limiter is stateful and has to step through the frames serially, so only the peak detection and the gain application are vectorized
+			FindStereoFramePeaks(FramePeakBuffer.data(), mixedBuffer, frameCount, preGain);
+			for (size_t f = 0; f < frameCount; ++f)
+				FrameGainBuffer[f] = Limiter[soundGroup].GetGain(FramePeakBuffer[f], limitMin, limitMax);
+
+			if constexpr (std::is_integral_v<T>)
+				MixStereoF32WithFrameGainsClampI16(outputBuffer, mixedBuffer, FrameGainBuffer.data(), frameCount, preGain, postGain);
+			else
+				MixStereoF32WithFrameGains(outputBuffer, mixedBuffer, FrameGainBuffer.data(), frameCount, preGain, postGain);
 		}
 
 		void CallbackUpdateLastPlayedSamplesRingBuffer(i16* outputBuffer, const size_t frameCount)
@@ -454,18 +669,21 @@ namespace Audio
 			CallbackFrequency = (CallbackStreamTime - LastCallbackStreamTime);
 			LastCallbackStreamTime = CallbackStreamTime;
 
+			CallbackProcessVoiceCommands();
+
 			CallbackClearOutBuffer(outputBuffer, bufferSampleCount);
 			CallbackClearOutBuffer(MasterBuffer.data(), bufferSampleCount);
 
-			// render each sound group separately, adjust volume, and then to master (except group 0)
-			for (i32 g = 1; g < MaxSoundGroups; ++g) {
-				CallbackClearOutBuffer(SoundGroupBuffer.data(), bufferSampleCount);
-				CallbackProcessVoices(SoundGroupBuffer.data(), bufferFrameCount, bufferSampleCount, g);
-				CallbackAdjustVolumeAndMix(MasterBuffer.data(), SoundGroupBuffer.data(), bufferFrameCount, 1, SoundGroupVolume[g], g);
-			}
+			for (i32 g = 1; g < MaxSoundGroups; ++g)
+				CallbackClearOutBuffer(SoundGroupBuffers[g].data(), bufferSampleCount);
+
+			// render all voices in a single pass, sound group 0 (or any invalid group) renders directly to master
+			CallbackProcessVoices(bufferFrameCount);
+
+			// adjust volume of each other sound group separately and then mix to master
+			for (i32 g = 1; g < MaxSoundGroups; ++g)
+				CallbackAdjustVolumeAndMix(MasterBuffer.data(), SoundGroupBuffers[g].data(), bufferFrameCount, 1, SoundGroupVolume[g], g);
 
-			// sound group 0 (or any invalid group) renders directly to master
-			CallbackProcessVoices(MasterBuffer.data(), bufferFrameCount, bufferSampleCount, 0);
 			CallbackAdjustVolumeAndMix(outputBuffer, MasterBuffer.data(), bufferFrameCount, SoundGroupVolume[0], 1, 0);
 			CallbackUpdateLastPlayedSamplesRingBuffer(outputBuffer, bufferFrameCount);
 			CallbackUpdateCallbackDurationRingBuffer(stopwatch.Stop());
@@ -543,6 +761,7 @@ namespace Audio
 		impl->StreamTimeStopwatch.Stop();
 
 		impl->IsStreamOpenRunning = false;
+		impl->CallbackProcessVoiceCommands();
 	}
 
 	void AudioEngine::EnsureStreamRunning()
@@ -581,29 +800,22 @@ namespace Audio
 		return LoadSourceFromBufferMove(fileName, std::move(sampleBuffer));
 	}
 
-	SourceHandle AudioEngine::LoadSourceFromBufferMove(std::string_view sourceName, PCMSampleBuffer bufferToMove)
+	SourceHandle AudioEngine::LoadSourceFromStreamMove(std::string_view sourceName, std::unique_ptr<PCMSampleStream> streamToMove)
 	{
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
-		for (HandleBaseType index = 0; index < static_cast<HandleBaseType>(impl->LoadedSources.size()); index++)
-		{
-			const SourceHandle handleIt = IndexToSourceHandle(index);
-			SourceData& sourceData = impl->LoadedSources[index];
-			if (sourceData.SlotUsed)
-				continue;
-
-			sourceData.SlotUsed = true;
-			sourceData.Buffer = std::move(bufferToMove);
-			sourceData.BaseVolume = 1.0f;
-			CopyStringViewIntoFixedBuffer(sourceData.Name, sourceName);
-
-			return static_cast<SourceHandle>(index);
-		}
+		// NOTE: Streams are played back as is so resampling (if needed) has to be done by decoding the entire file instead
+		if (streamToMove == nullptr || streamToMove->SampleRate != OutputSampleRate)
+			return SourceHandle::Invalid;
 
-#if PEEPO_DEBUG
-		assert(!"Consider increasing MaxLoadedSources");
-#endif
+		PCMSampleBuffer formatOnlyBuffer = {};
+		formatOnlyBuffer.ChannelCount = streamToMove->ChannelCount;
+		formatOnlyBuffer.SampleRate = streamToMove->SampleRate;
+		formatOnlyBuffer.FrameCount = streamToMove->FrameCount;
+		return impl->LoadSourceIntoFreeSlot(sourceName, std::move(formatOnlyBuffer), std::move(streamToMove));
+	}
 
-		return SourceHandle::Invalid;
+	SourceHandle AudioEngine::LoadSourceFromBufferMove(std::string_view sourceName, PCMSampleBuffer bufferToMove)
+	{
+		return impl->LoadSourceIntoFreeSlot(sourceName, std::move(bufferToMove), nullptr);
 	}
 
 	void AudioEngine::UnloadSource(SourceHandle source)
@@ -611,17 +823,15 @@ namespace Audio
 		if (source == SourceHandle::Invalid)
 			return;
 
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
 		SourceData* sourceData = impl->TryGetSourceData(source, Impl::GetSourceDataParam::None);
-		if (sourceData == nullptr)
+		if (sourceData == nullptr || sourceData->PendingUnload.exchange(true))
 			return;
 
-		sourceData->SlotUsed = false;
-		for (VoiceData& voice : impl->VoicePool)
-		{
-			if ((voice.Flags & VoiceFlags_Alive) && voice.Source == source)
-				voice.Source = SourceHandle::Invalid;
-		}
+		// NOTE: Stop decoding right away, the worker thread itself is only joined once the slot gets reused
+		if (sourceData->Stream != nullptr)
+			sourceData->Stream->RequestStop();
+
+		impl->PushVoiceCommand(VoiceCommand { VoiceCommandType::UnloadSource, VoiceFlags_Dead, VoiceHandle::Invalid, source });
 	}
 
 	const PCMSampleBuffer* AudioEngine::GetSourceSampleBufferView(SourceHandle source)
@@ -652,18 +862,13 @@ namespace Audio
 
 	VoiceHandle AudioEngine::AddVoice(SourceHandle source, std::string_view name, b8 playing, f32 volume, f32 pan, b8 playPastEnd, i32 soundGroup)
 	{
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
-
 		for (size_t i = 0; i < impl->VoicePool.size(); i++)
 		{
+			// NOTE: Only the render thread turns alive voices back into dead ones, so a dead slot is guaranteed to no longer be in use
 			VoiceData& voiceToUpdate = impl->VoicePool[i];
-			if (voiceToUpdate.Flags & VoiceFlags_Alive)
+			if (voiceToUpdate.Flags != VoiceFlags_Dead)
 				continue;
 
-			voiceToUpdate.Flags = VoiceFlags_Alive;
-			if (playing) voiceToUpdate.Flags |= VoiceFlags_Playing;
-			if (playPastEnd) voiceToUpdate.Flags |= VoiceFlags_PlayPastEnd;
-
 			voiceToUpdate.Source = source;
 			voiceToUpdate.SoundGroup = soundGroup;
 			voiceToUpdate.Volume = volume;
@@ -672,7 +877,9 @@ namespace Audio
 			voiceToUpdate.VolumeMap.StartVolume = 0.0f;
 			voiceToUpdate.VolumeMap.EndVolume = 0.0f;
 			CopyStringViewIntoFixedBuffer(voiceToUpdate.Name, name);
+			voiceToUpdate.Flags = static_cast<VoiceFlags>(VoiceFlags_Alive | (playing ? VoiceFlags_Playing : 0) | (playPastEnd ? VoiceFlags_PlayPastEnd : 0));
 
+			impl->PushVoiceCommand(VoiceCommand { VoiceCommandType::AddVoice, VoiceFlags_Dead, IndexToVoiceHandle(static_cast<HandleBaseType>(i)), source });
 			return static_cast<VoiceHandle>(i);
 		}
 
@@ -688,12 +895,9 @@ namespace Audio
 		if (voice == VoiceHandle::Invalid)
 			return;
 
-		// TODO: Think these locks through again
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
-
 		VoiceData* voiceData = impl->TryGetVoiceData(voice);
-		if (voiceData != nullptr)
-			voiceData->Flags = VoiceFlags_Dead;
+		if (voiceData != nullptr && TryUpdateAliveVoiceFlags(voiceData->Flags, VoiceFlags_PendingRemove, 0))
+			impl->PushVoiceCommand(VoiceCommand { VoiceCommandType::RemoveVoice, VoiceFlags_Dead, voice, SourceHandle::Invalid });
 	}
 
 	void AudioEngine::PlayOneShotSound(SourceHandle source, std::string_view name, f32 volume, f32 pan, i32 soundGroup)
@@ -701,14 +905,12 @@ namespace Audio
 		if (source == SourceHandle::Invalid)
 			return;
 
-		const auto lock = std::scoped_lock(impl->VoiceRenderMutex);
-
-		for (VoiceData& voiceToUpdate : impl->VoicePool)
+		for (size_t i = 0; i < impl->VoicePool.size(); i++)
 		{
-			if (voiceToUpdate.Flags & VoiceFlags_Alive)
+			VoiceData& voiceToUpdate = impl->VoicePool[i];
+			if (voiceToUpdate.Flags != VoiceFlags_Dead)
 				continue;
 
-			voiceToUpdate.Flags = VoiceFlags_Alive | VoiceFlags_Playing | VoiceFlags_RemoveOnEnd;
 			voiceToUpdate.Source = source;
 			voiceToUpdate.SoundGroup = soundGroup;
 			voiceToUpdate.Volume = volume;
@@ -717,6 +919,9 @@ namespace Audio
 			voiceToUpdate.VolumeMap.StartVolume = 0.0f;
 			voiceToUpdate.VolumeMap.EndVolume = 0.0f;
 			CopyStringViewIntoFixedBuffer(voiceToUpdate.Name, name);
+			voiceToUpdate.Flags = (VoiceFlags_Alive | VoiceFlags_Playing | VoiceFlags_RemoveOnEnd);
+
+			impl->PushVoiceCommand(VoiceCommand { VoiceCommandType::AddVoice, VoiceFlags_Dead, IndexToVoiceHandle(static_cast<HandleBaseType>(i)), source });
 			return;
 		}
 	}
@@ -912,14 +1117,14 @@ namespace Audio
 				if (voice->Flags & VoiceFlags_VariablePlaybackSpeed)
 					voice->FramePosition = TimeToFrames(Time::FromSec(voice->TimePositionSec), sampleRate);
 
-				voice->Flags &= ~VoiceFlags_VariablePlaybackSpeed;
+				TryUpdateAliveVoiceFlags(voice->Flags, 0, VoiceFlags_VariablePlaybackSpeed);
 			}
 			else
 			{
 				if (!(voice->Flags & VoiceFlags_VariablePlaybackSpeed))
 					voice->TimePositionSec = FramesToTime(voice->FramePosition, sampleRate).ToSec();
 
-				voice->Flags |= VoiceFlags_VariablePlaybackSpeed;
+				TryUpdateAliveVoiceFlags(voice->Flags, VoiceFlags_VariablePlaybackSpeed, 0);
 			}
 
 			voice->PlaybackSpeed = value;
@@ -1007,12 +1212,6 @@ namespace Audio
 
 	void Voice::SetIsPlaying(b8 value)
 	{
-		// TODO: Allow manual render thread locking from outside code to then be used for playback sounds
-		//		 This should then become lockfree again!
-
-		// HACK: Prevent randomly "stacking" playback button sounds... need to find a better solution, definitely don't want any locks like this
-		const auto lock = std::scoped_lock(Engine.impl->VoiceRenderMutex);
-
 		SetInternalFlag(VoiceFlags_Playing, value);
 	}
 
@@ -1107,15 +1306,23 @@ namespace Audio
 		static_assert(sizeof(flag) == sizeof(VoiceFlags));
 		const auto voiceFlag = static_cast<VoiceFlags>(flag);
 
-		if (VoiceData* voice = Engine.impl->TryGetVoiceData(Handle); voice != nullptr)
+		auto& impl = Engine.impl;
+
+		if (VoiceData* voice = impl->TryGetVoiceData(Handle); voice != nullptr)
 		{
-			if (value)
-				voice->Flags |= voiceFlag;
-			else
-				voice->Flags &= ~voiceFlag;
+			// NOTE: Setters like SetIsPlaying() are called every frame, so don't flood the command queue with ones that wouldn't change anything
+			const VoiceFlags currentFlags = voice->Flags.load();
+			if (value ? ((currentFlags & voiceFlag) == voiceFlag) : ((currentFlags & voiceFlag) == 0))
+				return;
+
+			// NOTE: Update immediately so the new state can be read back right away, the render thread then reapplies it at the start of its next buffer
+			if (!TryUpdateAliveVoiceFlags(voice->Flags, value ? voiceFlag : 0, value ? 0 : voiceFlag))
+				return;
 
 			if (flag & VoiceFlags_Playing)
 				voice->SmoothTime.RequestUpdate = true;
+
+			impl->PushVoiceCommand(VoiceCommand { value ? VoiceCommandType::SetFlags : VoiceCommandType::ClearFlags, voiceFlag, Handle, SourceHandle::Invalid });
 		}
 	}
 }
@@ -129,6 +129,8 @@ namespace Audio
 		}
 	}
 
+	struct PCMSampleStream;
+
 	class AudioEngine : NonCopyable
 	{
 	public:
@@ -169,6 +171,9 @@ namespace Audio
 		SourceHandle LoadSourceFromFileSync(std::string_view filePath);
 		SourceHandle LoadSourceFromFileContentSync(std::string_view fileName, const void* fileContent, size_t fileSize);
 		SourceHandle LoadSourceFromBufferMove(std::string_view sourceName, PCMSampleBuffer bufferToMove);
+		// NOTE: Takes ownership of an already opened stream which keeps decoding incrementally on its background thread while playing instead of upfront.
+		//		 Returns an invalid handle if the stream doesn't already match the output sample rate, in which case the file has to be decoded entirely instead
+		SourceHandle LoadSourceFromStreamMove(std::string_view sourceName, std::unique_ptr<PCMSampleStream> streamToMove);
 		void UnloadSource(SourceHandle source);
 
 		const PCMSampleBuffer* GetSourceSampleBufferView(SourceHandle source);
@@ -179,6 +184,7 @@ namespace Audio
 		std::string_view GetSourceName(SourceHandle source);
 		void SetSourceName(SourceHandle source, std::string_view newName);
 
+		// NOTE: Voice add / remove and source unload are queued to the render thread lock-free and must only be called from the main thread
 		// NOTE: Add a voice and keep a handle to it
 		VoiceHandle AddVoice(SourceHandle source, std::string_view name, b8 playing, f32 volume = MaxVolume, f32 pan = 0, b8 playPastEnd = false, i32 soundGroup = 0);
 		void RemoveVoice(VoiceHandle voice);
@@ -12,6 +12,17 @@
 // TODO: Forward declare because visual studio is having a stroke parsing the C header (something about the typedef union { ... } Floor; ???)
 //		 even though it was working perfectly fine in a different C++ project before :PeepoShrug:
 extern "C" int stb_vorbis_decode_memory(const u8 *mem, int len, int *channels, int *sample_rate, short **output);
+extern "C"
+{
+	struct stb_vorbis;
+	struct stb_vorbis_info_forward_declared { unsigned int sample_rate; int channels; unsigned int setup_memory_required, setup_temp_memory_required, temp_memory_required; int max_frame_size; };
+	stb_vorbis* stb_vorbis_open_memory(const unsigned char* data, int len, int* error, const void* alloc_buffer);
+	stb_vorbis_info_forward_declared stb_vorbis_get_info(stb_vorbis* f);
+	unsigned int stb_vorbis_stream_length_in_samples(stb_vorbis* f);
+	int stb_vorbis_seek(stb_vorbis* f, unsigned int sample_number);
+	int stb_vorbis_get_samples_short_interleaved(stb_vorbis* f, int channels, short* buffer, int num_shorts);
+	void stb_vorbis_close(stb_vorbis* f);
+}
 
 namespace Audio
 {
@@ -45,21 +56,16 @@ namespace Audio
 			i32 outSampleRate = {};
 			i16* outSamplesI16 = {};
 			i32 outFrameCount = ::stb_vorbis_decode_memory(static_cast<const unsigned char*>(inFileContent), static_cast<int>(inFileSize), &outChannels, &outSampleRate, &outSamplesI16);
-			defer { ::free(outSamplesI16); };
 			if (outSamplesI16 == nullptr || outFrameCount < 0)
+			{
+				::free(outSamplesI16);
 				return DecodeFileResult::Sadge;
+			}
 
-			const size_t totalSampleCount = static_cast<size_t>(outFrameCount * outChannels);
 			outBuffer.ChannelCount = static_cast<u32>(outChannels);
 			outBuffer.SampleRate = static_cast<u32>(outSampleRate);
 			outBuffer.FrameCount = static_cast<i64>(outFrameCount);
-			// outBuffer.InterleavedSamples = std::make_unique<i16[]>(totalSampleCount);
-			outBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[totalSampleCount]);
-			if (outBuffer.InterleavedSamples == nullptr)
-				return DecodeFileResult::Sadge;
-
-			// TODO: Prevent copy by.. overwriting malloc? or manually read chunks
-			::memcpy(outBuffer.InterleavedSamples.get(), outSamplesI16, totalSampleCount * sizeof(i16));
+			outBuffer.InterleavedSamples = AdoptMallocAllocatedSampleBuffer<i16>(outSamplesI16);
 		} break;
 
 		case SupportedFileFormat::WAV:
@@ -68,21 +74,13 @@ namespace Audio
 			u32 outSampleRate = {};
 			u64 outFrameCount = {};
 			i16* outSamplesI16 = ::drwav_open_memory_and_read_pcm_frames_s16(inFileContent, inFileSize, &outChannels, &outSampleRate, &outFrameCount, nullptr);
-			defer { ::drwav_free(outSamplesI16, nullptr); };
 			if (outSamplesI16 == nullptr)
 				return DecodeFileResult::Sadge;
 
-			const size_t totalSampleCount = static_cast<size_t>(outFrameCount * outChannels);
 			outBuffer.ChannelCount = static_cast<u32>(outChannels);
 			outBuffer.SampleRate = static_cast<u32>(outSampleRate);
 			outBuffer.FrameCount = static_cast<i64>(outFrameCount);
-			// outBuffer.InterleavedSamples = std::make_unique<i16[]>(totalSampleCount);
-			outBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[totalSampleCount]);
-			if (outBuffer.InterleavedSamples == nullptr)
-				return DecodeFileResult::Sadge;
-
-			// TODO: Prevent copy by passing down custom allocator or manually read chunks
-			::memcpy(outBuffer.InterleavedSamples.get(), outSamplesI16, totalSampleCount * sizeof(i16));
+			outBuffer.InterleavedSamples = AdoptMallocAllocatedSampleBuffer<i16>(outSamplesI16);
 		} break;
 
 		case SupportedFileFormat::FLAC:
@@ -91,21 +89,13 @@ namespace Audio
 			u32 outSampleRate = {};
 			u64 outFrameCount = {};
 			i16* outSamplesI16 = ::drflac_open_memory_and_read_pcm_frames_s16(inFileContent, inFileSize, &outChannels, &outSampleRate, &outFrameCount, nullptr);
-			defer { ::drflac_free(outSamplesI16, nullptr); };
 			if (outSamplesI16 == nullptr)
 				return DecodeFileResult::Sadge;
 
-			const size_t totalSampleCount = static_cast<size_t>(outFrameCount * outChannels);
 			outBuffer.ChannelCount = static_cast<u32>(outChannels);
 			outBuffer.SampleRate = static_cast<u32>(outSampleRate);
 			outBuffer.FrameCount = static_cast<i64>(outFrameCount);
-			// outBuffer.InterleavedSamples = std::make_unique<i16[]>(totalSampleCount);
-			outBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[totalSampleCount]);
-			if (outBuffer.InterleavedSamples == nullptr)
-				return DecodeFileResult::Sadge;
-
-			// TODO: Prevent copy by passing down custom allocator or manually read chunks
-			::memcpy(outBuffer.InterleavedSamples.get(), outSamplesI16, totalSampleCount * sizeof(i16));
+			outBuffer.InterleavedSamples = AdoptMallocAllocatedSampleBuffer<i16>(outSamplesI16);
 		} break;
 
 		case SupportedFileFormat::MP3:
@@ -113,21 +103,13 @@ namespace Audio
 			::drmp3_config outConfig = {};
 			::drmp3_uint64 outFrameCount = {};
 			::drmp3d_sample_t* outSamplesI16 = ::drmp3_open_memory_and_read_pcm_frames_s16(inFileContent, inFileSize, &outConfig, &outFrameCount, nullptr);
-			defer { ::drmp3_free(outSamplesI16, nullptr); };
 			if (outSamplesI16 == nullptr)
 				return DecodeFileResult::Sadge;
 
-			const size_t totalSampleCount = static_cast<size_t>(outFrameCount * outConfig.channels);
 			outBuffer.ChannelCount = static_cast<u32>(outConfig.channels);
 			outBuffer.SampleRate = static_cast<u32>(outConfig.sampleRate);
 			outBuffer.FrameCount = static_cast<i64>(outFrameCount);
-			// outBuffer.InterleavedSamples = std::make_unique<i16[]>(totalSampleCount);
-			outBuffer.InterleavedSamples = std::unique_ptr<i16[]>(new i16[totalSampleCount]);
-			if (outBuffer.InterleavedSamples == nullptr)
-				return DecodeFileResult::Sadge;
-
-			// TODO: Prevent copy by passing down custom allocator or manually read chunks
-			::memcpy(outBuffer.InterleavedSamples.get(), outSamplesI16, totalSampleCount * sizeof(i16));
+			outBuffer.InterleavedSamples = AdoptMallocAllocatedSampleBuffer<i16>(outSamplesI16);
 		} break;
 
 		default:
@@ -139,4 +121,148 @@ namespace Audio
 
 		return DecodeFileResult::FeelsGoodMan;
 	}
+
+	struct StreamingFileDecoder::Impl
+	{
+		SupportedFileFormat Format = SupportedFileFormat::Count;
+		::stb_vorbis* Vorbis = nullptr;
+		::drwav WAV = {};
+		::drflac* FLAC = nullptr;
+		::drmp3 MP3 = {};
+	};
+
+	StreamingFileDecoder::StreamingFileDecoder() : impl(std::make_unique<Impl>()) {}
+	StreamingFileDecoder::~StreamingFileDecoder() { Close(); }
+
+	DecodeFileResult StreamingFileDecoder::Open(std::string_view fileNameWithExtension, const void* inFileContent, size_t inFileSize)
+	{
+		Close();
+
+		if (inFileContent == nullptr || inFileSize == 0)
+			return DecodeFileResult::Sadge;
+
+		const SupportedFileFormat fileFormat = TryToDetermineFileFormatFromExtension(fileNameWithExtension);
+		switch (fileFormat)
+		{
+		case SupportedFileFormat::OggVorbis:
+		{
+			i32 outError = {};
+			impl->Vorbis = ::stb_vorbis_open_memory(static_cast<const unsigned char*>(inFileContent), static_cast<int>(inFileSize), &outError, nullptr);
+			if (impl->Vorbis == nullptr)
+				return DecodeFileResult::Sadge;
+
+			const auto info = ::stb_vorbis_get_info(impl->Vorbis);
+			ChannelCount = static_cast<u32>(info.channels);
+			SampleRate = static_cast<u32>(info.sample_rate);
+			FrameCount = static_cast<i64>(::stb_vorbis_stream_length_in_samples(impl->Vorbis));
+		} break;
+
+		case SupportedFileFormat::WAV:
+		{
+			if (!::drwav_init_memory(&impl->WAV, inFileContent, inFileSize, nullptr))
+				return DecodeFileResult::Sadge;
+
+			ChannelCount = static_cast<u32>(impl->WAV.channels);
+			SampleRate = static_cast<u32>(impl->WAV.sampleRate);
+			FrameCount = static_cast<i64>(impl->WAV.totalPCMFrameCount);
+		} break;
+
+		case SupportedFileFormat::FLAC:
+		{
+			impl->FLAC = ::drflac_open_memory(inFileContent, inFileSize, nullptr);
+			if (impl->FLAC == nullptr)
+				return DecodeFileResult::Sadge;
+
+			ChannelCount = static_cast<u32>(impl->FLAC->channels);
+			SampleRate = static_cast<u32>(impl->FLAC->sampleRate);
+			FrameCount = static_cast<i64>(impl->FLAC->totalPCMFrameCount);
+		} break;
+
+		case SupportedFileFormat::MP3:
+		{
+			if (!::drmp3_init_memory(&impl->MP3, inFileContent, inFileSize, nullptr))
+				return DecodeFileResult::Sadge;
+
+			ChannelCount = static_cast<u32>(impl->MP3.channels);
+			SampleRate = static_cast<u32>(impl->MP3.sampleRate);
+			// NOTE: Has to scan through the entire file (without fully decoding it) and then seeks back to the start
+			FrameCount = static_cast<i64>(::drmp3_get_pcm_frame_count(&impl->MP3));
+		} break;
+
+		default:
+			return DecodeFileResult::Sadge;
+		}
+
+		impl->Format = fileFormat;
+		if (ChannelCount == 0 || SampleRate == 0)
+		{
+			Close();
+			return DecodeFileResult::Sadge;
+		}
+
+		return DecodeFileResult::FeelsGoodMan;
+	}
+
+	void StreamingFileDecoder::Close()
+	{
+		switch (impl->Format)
+		{
+		case SupportedFileFormat::OggVorbis: { ::stb_vorbis_close(impl->Vorbis); impl->Vorbis = nullptr; } break;
+		case SupportedFileFormat::WAV: { ::drwav_uninit(&impl->WAV); impl->WAV = {}; } break;
+		case SupportedFileFormat::FLAC: { ::drflac_close(impl->FLAC); impl->FLAC = nullptr; } break;
+		case SupportedFileFormat::MP3: { ::drmp3_uninit(&impl->MP3); impl->MP3 = {}; } break;
+		default: {} break;
+		}
+
+		impl->Format = SupportedFileFormat::Count;
+		ChannelCount = 0;
+		SampleRate = 0;
+		FrameCount = 0;
+	}
+
+	b8 StreamingFileDecoder::IsOpen() const
+	{
+		return (impl->Format != SupportedFileFormat::Count);
+	}
+
+	i64 StreamingFileDecoder::ReadFrames(i16* outInterleavedSamples, i64 frameCount)
+	{
+		if (frameCount <= 0)
+			return 0;
+
+		switch (impl->Format)
+		{
+		case SupportedFileFormat::OggVorbis:
+		{
+			// NOTE: Might return less than requested even before the end of the file, so keep going until it doesn't return anything at all
+			i64 framesRead = 0;
+			while (framesRead < frameCount)
+			{
+				const i32 shortsToRead = static_cast<i32>(Min<i64>(frameCount - framesRead, I32Max / ChannelCount) * ChannelCount);
+				const i32 framesReadNow = ::stb_vorbis_get_samples_short_interleaved(impl->Vorbis, static_cast<int>(ChannelCount), &outInterleavedSamples[framesRead * ChannelCount], shortsToRead);
+				if (framesReadNow <= 0)
+					break;
+				framesRead += framesReadNow;
+			}
+			return framesRead;
+		}
+		case SupportedFileFormat::WAV: { return static_cast<i64>(::drwav_read_pcm_frames_s16(&impl->WAV, static_cast<drwav_uint64>(frameCount), outInterleavedSamples)); }
+		case SupportedFileFormat::FLAC: { return static_cast<i64>(::drflac_read_pcm_frames_s16(impl->FLAC, static_cast<drflac_uint64>(frameCount), outInterleavedSamples)); }
+		case SupportedFileFormat::MP3: { return static_cast<i64>(::drmp3_read_pcm_frames_s16(&impl->MP3, static_cast<drmp3_uint64>(frameCount), outInterleavedSamples)); }
+		default: { return 0; }
+		}
+	}
+
+	b8 StreamingFileDecoder::SeekToFrame(i64 frameIndex)
+	{
+		frameIndex = Clamp<i64>(frameIndex, 0, FrameCount);
+		switch (impl->Format)
+		{
+		case SupportedFileFormat::OggVorbis: { return ::stb_vorbis_seek(impl->Vorbis, static_cast<unsigned int>(frameIndex)) != 0; }
+		case SupportedFileFormat::WAV: { return ::drwav_seek_to_pcm_frame(&impl->WAV, static_cast<drwav_uint64>(frameIndex)); }
+		case SupportedFileFormat::FLAC: { return ::drflac_seek_to_pcm_frame(impl->FLAC, static_cast<drflac_uint64>(frameIndex)); }
+		case SupportedFileFormat::MP3: { return ::drmp3_seek_to_pcm_frame(&impl->MP3, static_cast<drmp3_uint64>(frameIndex)); }
+		default: { return false; }
+		}
+	}
 }
@@ -33,8 +33,32 @@ namespace Audio
 
 	SupportedFileFormat TryToDetermineFileFormatFromExtension(std::string_view fileName);
 
-	// TODO: Also expose file streaming API if / when it's needed
-	//		 but for now everything will be stored in one big continuous buffer since it greatly reduces complexity.
-	//		 Instead of constantly reading a streamed file from disk it might also be an option to read the entire file upfront but then only decode chunks on demand (?)
+	// NOTE: Decodes the entire file into one big continuous buffer, see StreamingFileDecoder for decoding chunks on demand instead
 	DecodeFileResult DecodeEntireFile(std::string_view fileNameWithExtension, const void* inFileContent, size_t inFileSize, PCMSampleBuffer& outBuffer);
+
+	// NOTE: Reads the entire (still encoded) file upfront but then only decodes chunks on demand.
+	//		 The file content has to outlive the decoder and a single decoder must not be used from multiple threads at once
+	struct StreamingFileDecoder
+	{
+		u32 ChannelCount = 0;
+		u32 SampleRate = 0;
+		i64 FrameCount = 0;
+
+		StreamingFileDecoder();
+		~StreamingFileDecoder();
+		StreamingFileDecoder(const StreamingFileDecoder&) = delete;
+		StreamingFileDecoder& operator=(const StreamingFileDecoder&) = delete;
+
+		DecodeFileResult Open(std::string_view fileNameWithExtension, const void* inFileContent, size_t inFileSize);
+		void Close();
+		b8 IsOpen() const;
+
+		// NOTE: Returns the number of frames actually decoded, which is only less than requested at the end of the file (or on error)
+		i64 ReadFrames(i16* outInterleavedSamples, i64 frameCount);
+		b8 SeekToFrame(i64 frameIndex);
+
+	private:
+		struct Impl;
+		std::unique_ptr<Impl> impl;
+	};
 }
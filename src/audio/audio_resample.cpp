@@ -0,0 +1,165 @@
+#include "audio_resample.h"
+#include "audio_simd.h"
+#include <numeric>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace Audio
+{
+	// NOTE: Number of sinc zero crossings on each side of the center tap at the lower of the two sample rates
+	static constexpr i64 FilterZeroCrossingCount = 16;
+	// NOTE: Start of the transition band relative to the lower nyquist frequency, i.e. ~20.9 kHz for 44.1 kHz output
+	static constexpr f64 FilterCutoffRolloff = 0.95;
+	// NOTE: Results in roughly -90 dB stopband attenuation which is below what 16-bit samples can represent anyway
+	static constexpr f64 FilterKaiserBeta = 8.6;
+	// NOTE: Uncommon sample rate ratios would otherwise require an unreasonably large number of phases, so round to the closest phase instead
+	static constexpr i64 MaxFilterPhaseCount = 1024;
+	static constexpr i64 MinOutputFramesPerBlock = (1 << 16);
+
+	static f64 BesselI0(f64 x)
+	{
+		f64 sum = 1.0, term = 1.0;
+		for (i32 k = 1; k < 64 && term > (sum * 1e-12); k++)
+		{
+			const f64 halfXOverK = (x * 0.5) / static_cast<f64>(k);
+			term *= (halfXOverK * halfXOverK);
+			sum += term;
+		}
+		return sum;
+	}
+
+	static f64 NormalizedSinc(f64 x)
+	{
+		constexpr f64 pi = 3.14159265358979323846;
+		return (x == 0.0) ? 1.0 : (::sin(pi * x) / (pi * x));
+	}
+
+	struct PolyphaseFilter
+	{
+		// NOTE: Reduced resampling ratio, output frame n is located at input frame (n * DownFactor / UpFactor)
+		i64 UpFactor, DownFactor;
+		i64 PhaseCount;
+		i64 HalfWidth;
+		// NOTE: Padded to a multiple of 8 for the dot product kernel (with zero coefficients for the padding)
+		i64 TapCount;
+		std::vector<f32> Coefficients;
+
+		inline const f32* PhaseCoefficients(i64 phase) const { return &Coefficients[phase * TapCount]; }
+		// NOTE: Position of the output frame in units of filter phases, rounded to the closest phase (exact whenever PhaseCount == UpFactor)
+		//		 so that a position rounding up to the next phase wraps around to phase zero of the next input frame
+		inline i64 PhasePosition(i64 outputFrame) const { return ((outputFrame * DownFactor * PhaseCount) + (UpFactor / 2)) / UpFactor; }
+		inline i64 FirstInputFrame(i64 outputFrame) const { return (PhasePosition(outputFrame) / PhaseCount) - HalfWidth + 1; }
+		inline i64 Phase(i64 outputFrame) const { return PhasePosition(outputFrame) % PhaseCount; }
+	};
+
+	static PolyphaseFilter CreatePolyphaseFilter(u32 sourceRate, u32 targetRate)
+	{
+		PolyphaseFilter filter = {};
+		const i64 gcd = std::gcd(static_cast<i64>(sourceRate), static_cast<i64>(targetRate));
+		filter.UpFactor = (targetRate / gcd);
+		filter.DownFactor = (sourceRate / gcd);
+		filter.PhaseCount = Min(filter.UpFactor, MaxFilterPhaseCount);
+
+		// NOTE: When downsampling the cutoff has to be moved down to the target nyquist frequency and the filter widened accordingly
+		const f64 cutoff = Min(1.0, static_cast<f64>(targetRate) / static_cast<f64>(sourceRate)) * FilterCutoffRolloff;
+		filter.HalfWidth = static_cast<i64>(Ceil(static_cast<f64>(FilterZeroCrossingCount) / cutoff));
+		filter.TapCount = (((filter.HalfWidth * 2) + 7) / 8) * 8;
+		filter.Coefficients.resize(filter.PhaseCount * filter.TapCount, 0.0f);
+
+		const f64 windowNormalization = 1.0 / BesselI0(FilterKaiserBeta);
+		std::vector<f64> phaseCoefficients(filter.TapCount);
+		for (i64 phase = 0; phase < filter.PhaseCount; phase++)
+		{
+			const f64 fraction = static_cast<f64>(phase) / static_cast<f64>(filter.PhaseCount);
+
+			f64 coefficientSum = 0.0;
+			for (i64 tap = 0; tap < filter.TapCount; tap++)
+			{
+				const f64 distance = static_cast<f64>(tap - filter.HalfWidth + 1) - fraction;
+				const f64 windowPosition = distance / static_cast<f64>(filter.HalfWidth);
+				const f64 window = (Absolute(windowPosition) < 1.0) ? (BesselI0(FilterKaiserBeta * ::sqrt(1.0 - (windowPosition * windowPosition))) * windowNormalization) : 0.0;
+
+				phaseCoefficients[tap] = cutoff * NormalizedSinc(cutoff * distance) * window;
+				coefficientSum += phaseCoefficients[tap];
+			}
+
+			// NOTE: Normalize each phase individually for unity gain at DC, otherwise the truncated kernels would add a slight ripple
+			for (i64 tap = 0; tap < filter.TapCount; tap++)
+				filter.Coefficients[(phase * filter.TapCount) + tap] = static_cast<f32>(phaseCoefficients[tap] / coefficientSum);
+		}
+
+		return filter;
+	}
+
+	static void ResampleBlock(const PolyphaseFilter& filter, const i16* inSamples, i64 inFrameCount, u32 channelCount, i16* outSamples, i64 outFrameBegin, i64 outFrameEnd)
+	{
+		// NOTE: Convert the range of input frames read by this block to planar f32 once upfront (zero padded past either end)
+		//		 so that every output sample is just a single contiguous dot product
+		const i64 inFrameBegin = filter.FirstInputFrame(outFrameBegin);
+		const i64 inFrameEnd = filter.FirstInputFrame(outFrameEnd - 1) + filter.TapCount;
+		const i64 planarFrameCount = (inFrameEnd - inFrameBegin);
+
+		std::vector<f32> planarSamples(planarFrameCount * channelCount, 0.0f);
+		for (u32 c = 0; c < channelCount; c++)
+		{
+			f32* planarChannel = &planarSamples[c * planarFrameCount];
+			for (i64 frame = Max<i64>(inFrameBegin, 0); frame < Min(inFrameEnd, inFrameCount); frame++)
+				planarChannel[frame - inFrameBegin] = static_cast<f32>(inSamples[(frame * channelCount) + c]);
+		}
+
+		for (i64 outFrame = outFrameBegin; outFrame < outFrameEnd; outFrame++)
+		{
+			const f32* coefficients = filter.PhaseCoefficients(filter.Phase(outFrame));
+			const i64 planarOffset = (filter.FirstInputFrame(outFrame) - inFrameBegin);
+
+			for (u32 c = 0; c < channelCount; c++)
+			{
+				const f32 sample = DotProductF32x8(&planarSamples[(c * planarFrameCount) + planarOffset], coefficients, static_cast<size_t>(filter.TapCount));
+				outSamples[(outFrame * channelCount) + c] = ClampSampleI<i16>(static_cast<i32>(Round(sample)));
+			}
+		}
+	}
+
+	void ResampleBuffer(UniqueSampleBuffer<i16>& inOutSamples, i64& inOutFrameCount, u32& inOutSampleRate, const u32 inChannelCount, const u32 targetSampleRate)
+	{
+		if (inOutSampleRate == targetSampleRate || inOutSampleRate == 0 || targetSampleRate == 0) { assert(false); return; }
+
+		const PolyphaseFilter filter = CreatePolyphaseFilter(inOutSampleRate, targetSampleRate);
+		const i64 inFrameCount = inOutFrameCount;
+		const i64 outFrameCount = ((inFrameCount * filter.UpFactor) + (filter.DownFactor / 2)) / filter.DownFactor;
+
+		auto outSamples = UniqueSampleBuffer<i16>(new i16[outFrameCount * inChannelCount]);
+
+		if (outFrameCount > 0 && inChannelCount > 0)
+		{
+			const i64 maxBlockCount = ClampBot<i64>(static_cast<i64>(std::thread::hardware_concurrency()), 1);
+			const i64 blockCount = Clamp<i64>(outFrameCount / MinOutputFramesPerBlock, 1, maxBlockCount);
+			const i64 framesPerBlock = (outFrameCount + blockCount - 1) / blockCount;
+
+			std::vector<std::future<void>> blockFutures;
+			blockFutures.reserve(blockCount);
+
+			// NOTE: Process the last block on the calling thread instead of leaving it idle
+			for (i64 block = 0; block < blockCount; block++)
+			{
+				const i64 outFrameBegin = (block * framesPerBlock);
+				const i64 outFrameEnd = Min(outFrameBegin + framesPerBlock, outFrameCount);
+				if (outFrameBegin >= outFrameEnd)
+					break;
+
+				if (block + 1 < blockCount)
+					blockFutures.push_back(std::async(std::launch::async, ResampleBlock, std::cref(filter), inOutSamples.get(), inFrameCount, inChannelCount, outSamples.get(), outFrameBegin, outFrameEnd));
+				else
+					ResampleBlock(filter, inOutSamples.get(), inFrameCount, inChannelCount, outSamples.get(), outFrameBegin, outFrameEnd);
+			}
+
+			for (auto& future : blockFutures)
+				future.get();
+		}
+
+		inOutSamples = std::move(outSamples);
+		inOutFrameCount = outFrameCount;
+		inOutSampleRate = targetSampleRate;
+	}
+}
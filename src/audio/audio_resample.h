@@ -0,0 +1,11 @@
+#pragma once
+#include "core_types.h"
+#include "audio_common.h"
+
+namespace Audio
+{
+	// NOTE: Band-limited polyphase resampling using a Kaiser windowed sinc filter, so that unlike plain linear interpolation
+	//		 downsampling doesn't alias and upsampling doesn't produce imaging artifacts.
+	//		 Longer buffers are split into blocks of output frames (each reading a slightly overlapping range of input frames) which are resampled in parallel
+	void ResampleBuffer(UniqueSampleBuffer<i16>& inOutSamples, i64& inOutFrameCount, u32& inOutSampleRate, const u32 inChannelCount, const u32 targetSampleRate);
+}
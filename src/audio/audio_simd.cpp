@@ -0,0 +1,562 @@
+#include "audio_simd.h"
+#include "audio_common.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define PEEPO_SIMD_X64 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#else
+#define PEEPO_SIMD_X64 0
+#endif
+
+// NOTE: MSVC allows using any intrinsics without changing the target, GCC and Clang need the AVX2 functions to be marked explicitly
+#if PEEPO_SIMD_X64 && (defined(__GNUC__) || defined(__clang__))
+#define PEEPO_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define PEEPO_TARGET_AVX2
+#endif
+
+namespace Audio
+{
+	namespace ScalarKernels
+	{
+		static void MixStereoI16WithGain(f32* outSamples, const i16* inSamples, size_t frameCount, f32 gainL, f32 gainR)
+		{
+			for (size_t f = 0, i = 0; f < frameCount; f++, i += 2)
+			{
+				outSamples[i + 0] += inSamples[i + 0] * gainL;
+				outSamples[i + 1] += inSamples[i + 1] * gainR;
+			}
+		}
+
+		static void MixStereoI16WithFrameGains(f32* outSamples, const i16* inSamples, const f32* frameGains, size_t frameCount, f32 gainL, f32 gainR)
+		{
+			for (size_t f = 0, i = 0; f < frameCount; f++, i += 2)
+			{
+				outSamples[i + 0] += inSamples[i + 0] * (frameGains[f] * gainL);
+				outSamples[i + 1] += inSamples[i + 1] * (frameGains[f] * gainR);
+			}
+		}
+
+		static void FindStereoFramePeaks(f32* outFramePeaks, const f32* inSamples, size_t frameCount, f32 preGain)
+		{
+			for (size_t f = 0, i = 0; f < frameCount; f++, i += 2)
+			{
+				const f32 l = inSamples[i + 0] * preGain;
+				const f32 r = inSamples[i + 1] * preGain;
+				outFramePeaks[f] = (std::abs(r) > std::abs(l)) ? r : l;
+			}
+		}
+
+		static void MixStereoF32WithFrameGains(f32* outSamples, const f32* inSamples, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+		{
+			for (size_t f = 0, i = 0; f < frameCount; f++)
+			{
+				for (size_t c = 0; c < 2; c++, i++)
+					outSamples[i] += ((inSamples[i] * preGain) * frameGains[f]) * postGain;
+			}
+		}
+
+		static void MixStereoF32WithFrameGainsClampI16(i16* outSamples, const f32* inSamples, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+		{
+			for (size_t f = 0, i = 0; f < frameCount; f++)
+			{
+				for (size_t c = 0; c < 2; c++, i++)
+					outSamples[i] += ClampSampleI<i16>(((inSamples[i] * preGain) * frameGains[f]) * postGain);
+			}
+		}
+
+		static f32 DotProductF32x8(const f32* a, const f32* b, size_t count)
+		{
+			// NOTE: Eight separate accumulators reduced pairwise to match the order of the vectorized versions
+			f32 sums[8] = {};
+			for (size_t i = 0; i < count; i += 8)
+			{
+				for (size_t lane = 0; lane < 8; lane++)
+					sums[lane] += a[i + lane] * b[i + lane];
+			}
+			return ((sums[0] + sums[4]) + (sums[2] + sums[6])) + ((sums[1] + sums[5]) + (sums[3] + sums[7]));
+		}
+
+		static i16 AbsoluteI16Saturated(i16 v) { return (v == I16Min) ? static_cast<i16>(I16Max) : Absolute(v); }
+		static i16 RootMeanSquareI16(i32 sumOfTwoSquares) { return static_cast<i16>(Min<i32>(static_cast<i32>(::sqrtf(static_cast<f32>(sumOfTwoSquares) * 0.5f) + 0.5f), I16Max)); }
+
+		static void ReduceWaveformBucketPairs(i16* outPeaks, i16* outRMS, const i16* inPeaks, const i16* inRMS, size_t outCount)
+		{
+			for (size_t i = 0; i < outCount; i++)
+			{
+				outPeaks[i] = Max(inPeaks[i * 2 + 0], inPeaks[i * 2 + 1]);
+				outRMS[i] = RootMeanSquareI16((static_cast<i32>(inRMS[i * 2 + 0]) * inRMS[i * 2 + 0]) + (static_cast<i32>(inRMS[i * 2 + 1]) * inRMS[i * 2 + 1]));
+			}
+		}
+
+		static void ComputeStereoWaveformBuckets(i16* outPeaksL, i16* outRMSL, i16* outPeaksR, i16* outRMSR, const i16* inSamples, size_t outCount)
+		{
+			for (size_t i = 0; i < outCount; i++)
+			{
+				// NOTE: Saturating -32768 also keeps the sum of two squares from overflowing
+				const i16 l0 = AbsoluteI16Saturated(inSamples[i * 4 + 0]), r0 = AbsoluteI16Saturated(inSamples[i * 4 + 1]);
+				const i16 l1 = AbsoluteI16Saturated(inSamples[i * 4 + 2]), r1 = AbsoluteI16Saturated(inSamples[i * 4 + 3]);
+				outPeaksL[i] = Max(l0, l1);
+				outPeaksR[i] = Max(r0, r1);
+				outRMSL[i] = RootMeanSquareI16((static_cast<i32>(l0) * l0) + (static_cast<i32>(l1) * l1));
+				outRMSR[i] = RootMeanSquareI16((static_cast<i32>(r0) * r0) + (static_cast<i32>(r1) * r1));
+			}
+		}
+	}
+
+#if PEEPO_SIMD_X64
+	// NOTE: SSE2 is part of the x64 baseline so these never need to be guarded by a runtime check
+	namespace SSE2Kernels
+	{
+		static void MixStereoI16WithGain(f32* outSamples, const i16* inSamples, size_t frameCount, f32 gainL, f32 gainR)
+		{
+			const __m128 gain = _mm_setr_ps(gainL, gainR, gainL, gainR);
+
+			size_t f = 0;
+			for (; (f + 4) <= frameCount; f += 4)
+			{
+				const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inSamples[f * 2]));
+				const __m128 in0 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16));
+				const __m128 in1 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16));
+				_mm_storeu_ps(&outSamples[f * 2 + 0], _mm_add_ps(_mm_loadu_ps(&outSamples[f * 2 + 0]), _mm_mul_ps(in0, gain)));
+				_mm_storeu_ps(&outSamples[f * 2 + 4], _mm_add_ps(_mm_loadu_ps(&outSamples[f * 2 + 4]), _mm_mul_ps(in1, gain)));
+			}
+
+			ScalarKernels::MixStereoI16WithGain(&outSamples[f * 2], &inSamples[f * 2], frameCount - f, gainL, gainR);
+		}
+
+		static void MixStereoI16WithFrameGains(f32* outSamples, const i16* inSamples, const f32* frameGains, size_t frameCount, f32 gainL, f32 gainR)
+		{
+			const __m128 gain = _mm_setr_ps(gainL, gainR, gainL, gainR);
+
+			size_t f = 0;
+			for (; (f + 4) <= frameCount; f += 4)
+			{
+				const __m128 frameGain = _mm_loadu_ps(&frameGains[f]);
+				const __m128 gain0 = _mm_mul_ps(_mm_unpacklo_ps(frameGain, frameGain), gain);
+				const __m128 gain1 = _mm_mul_ps(_mm_unpackhi_ps(frameGain, frameGain), gain);
+
+				const __m128i in = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inSamples[f * 2]));
+				const __m128 in0 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(in, in), 16));
+				const __m128 in1 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(in, in), 16));
+				_mm_storeu_ps(&outSamples[f * 2 + 0], _mm_add_ps(_mm_loadu_ps(&outSamples[f * 2 + 0]), _mm_mul_ps(in0, gain0)));
+				_mm_storeu_ps(&outSamples[f * 2 + 4], _mm_add_ps(_mm_loadu_ps(&outSamples[f * 2 + 4]), _mm_mul_ps(in1, gain1)));
+			}
+
+			ScalarKernels::MixStereoI16WithFrameGains(&outSamples[f * 2], &inSamples[f * 2], &frameGains[f], frameCount - f, gainL, gainR);
+		}
+
+		static void FindStereoFramePeaks(f32* outFramePeaks, const f32* inSamples, size_t frameCount, f32 preGain)
+		{
+			const __m128 gain = _mm_set1_ps(preGain);
+			const __m128 signMask = _mm_set1_ps(-0.0f);
+
+			size_t f = 0;
+			for (; (f + 4) <= frameCount; f += 4)
+			{
+				const __m128 in0 = _mm_mul_ps(_mm_loadu_ps(&inSamples[f * 2 + 0]), gain);
+				const __m128 in1 = _mm_mul_ps(_mm_loadu_ps(&inSamples[f * 2 + 4]), gain);
+				const __m128 l = _mm_shuffle_ps(in0, in1, _MM_SHUFFLE(2, 0, 2, 0));
+				const __m128 r = _mm_shuffle_ps(in0, in1, _MM_SHUFFLE(3, 1, 3, 1));
+				const __m128 rightIsLarger = _mm_cmpgt_ps(_mm_andnot_ps(signMask, r), _mm_andnot_ps(signMask, l));
+				_mm_storeu_ps(&outFramePeaks[f], _mm_or_ps(_mm_and_ps(rightIsLarger, r), _mm_andnot_ps(rightIsLarger, l)));
+			}
+
+			ScalarKernels::FindStereoFramePeaks(&outFramePeaks[f], &inSamples[f * 2], frameCount - f, preGain);
+		}
+
+		static void MixStereoF32WithFrameGains(f32* outSamples, const f32* inSamples, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+		{
+			const __m128 pre = _mm_set1_ps(preGain);
+			const __m128 post = _mm_set1_ps(postGain);
+
+			size_t f = 0;
+			for (; (f + 4) <= frameCount; f += 4)
+			{
+				const __m128 frameGain = _mm_loadu_ps(&frameGains[f]);
+				const __m128 in0 = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&inSamples[f * 2 + 0]), pre), _mm_unpacklo_ps(frameGain, frameGain)), post);
+				const __m128 in1 = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&inSamples[f * 2 + 4]), pre), _mm_unpackhi_ps(frameGain, frameGain)), post);
+				_mm_storeu_ps(&outSamples[f * 2 + 0], _mm_add_ps(_mm_loadu_ps(&outSamples[f * 2 + 0]), in0));
+				_mm_storeu_ps(&outSamples[f * 2 + 4], _mm_add_ps(_mm_loadu_ps(&outSamples[f * 2 + 4]), in1));
+			}
+
+			ScalarKernels::MixStereoF32WithFrameGains(&outSamples[f * 2], &inSamples[f * 2], &frameGains[f], frameCount - f, preGain, postGain);
+		}
+
+		static void MixStereoF32WithFrameGainsClampI16(i16* outSamples, const f32* inSamples, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+		{
+			const __m128 pre = _mm_set1_ps(preGain);
+			const __m128 post = _mm_set1_ps(postGain);
+			const __m128 sampleMin = _mm_set1_ps(static_cast<f32>(I16Min));
+			const __m128 sampleMax = _mm_set1_ps(static_cast<f32>(I16Max));
+
+			size_t f = 0;
+			for (; (f + 4) <= frameCount; f += 4)
+			{
+				// NOTE: Clamp before truncating to integers so that out of range values can't wrap around
+				const __m128 frameGain = _mm_loadu_ps(&frameGains[f]);
+				const __m128 in0 = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&inSamples[f * 2 + 0]), pre), _mm_unpacklo_ps(frameGain, frameGain)), post);
+				const __m128 in1 = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&inSamples[f * 2 + 4]), pre), _mm_unpackhi_ps(frameGain, frameGain)), post);
+				const __m128i clamped0 = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(in0, sampleMin), sampleMax));
+				const __m128i clamped1 = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(in1, sampleMin), sampleMax));
+
+				__m128i* out = reinterpret_cast<__m128i*>(&outSamples[f * 2]);
+				_mm_storeu_si128(out, _mm_add_epi16(_mm_loadu_si128(out), _mm_packs_epi32(clamped0, clamped1)));
+			}
+
+			ScalarKernels::MixStereoF32WithFrameGainsClampI16(&outSamples[f * 2], &inSamples[f * 2], &frameGains[f], frameCount - f, preGain, postGain);
+		}
+
+		static f32 ReduceSumF32x4(__m128 sums)
+		{
+			const __m128 pairs = _mm_add_ps(sums, _mm_movehl_ps(sums, sums));
+			return _mm_cvtss_f32(_mm_add_ss(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 1, 1, 1))));
+		}
+
+		static f32 DotProductF32x8(const f32* a, const f32* b, size_t count)
+		{
+			__m128 sumsLo = _mm_setzero_ps(), sumsHi = _mm_setzero_ps();
+			for (size_t i = 0; i < count; i += 8)
+			{
+				sumsLo = _mm_add_ps(sumsLo, _mm_mul_ps(_mm_loadu_ps(&a[i + 0]), _mm_loadu_ps(&b[i + 0])));
+				sumsHi = _mm_add_ps(sumsHi, _mm_mul_ps(_mm_loadu_ps(&a[i + 4]), _mm_loadu_ps(&b[i + 4])));
+			}
+			return ReduceSumF32x4(_mm_add_ps(sumsLo, sumsHi));
+		}
+
+		static __m128i AbsoluteI16Saturated(__m128i v)
+		{
+			return _mm_max_epi16(v, _mm_subs_epi16(_mm_setzero_si128(), v));
+		}
+
+		// NOTE: Max of the two (non-negative) i16 halves of each i32 lane, zero extended
+		static __m128i MaxOfI16PairsPerI32(__m128i v)
+		{
+			return _mm_and_si128(_mm_max_epi16(v, _mm_srli_epi32(v, 16)), _mm_set1_epi32(0xFFFF));
+		}
+
+		static __m128i RootMeanSquareI32(__m128i sumsOfTwoSquares)
+		{
+			const __m128 rms = _mm_add_ps(_mm_sqrt_ps(_mm_mul_ps(_mm_cvtepi32_ps(sumsOfTwoSquares), _mm_set1_ps(0.5f))), _mm_set1_ps(0.5f));
+			return _mm_cvttps_epi32(rms);
+		}
+
+		static void ReduceWaveformBucketPairs(i16* outPeaks, i16* outRMS, const i16* inPeaks, const i16* inRMS, size_t outCount)
+		{
+			size_t i = 0;
+			for (; (i + 8) <= outCount; i += 8)
+			{
+				const __m128i peaks0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inPeaks[i * 2 + 0]));
+				const __m128i peaks1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inPeaks[i * 2 + 8]));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&outPeaks[i]), _mm_packs_epi32(MaxOfI16PairsPerI32(peaks0), MaxOfI16PairsPerI32(peaks1)));
+
+				const __m128i rms0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inRMS[i * 2 + 0]));
+				const __m128i rms1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inRMS[i * 2 + 8]));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&outRMS[i]), _mm_packs_epi32(RootMeanSquareI32(_mm_madd_epi16(rms0, rms0)), RootMeanSquareI32(_mm_madd_epi16(rms1, rms1))));
+			}
+
+			ScalarKernels::ReduceWaveformBucketPairs(&outPeaks[i], &outRMS[i], &inPeaks[i * 2], &inRMS[i * 2], outCount - i);
+		}
+
+		static void ComputeStereoWaveformBuckets(i16* outPeaksL, i16* outRMSL, i16* outPeaksR, i16* outRMSR, const i16* inSamples, size_t outCount)
+		{
+			size_t i = 0;
+			for (; (i + 8) <= outCount; i += 8)
+			{
+				// NOTE: Reorder L0 R0 L1 R1 into L0 L1 R0 R1 so that each i32 lane holds one frame pair of a single channel
+				__m128 peaks[4], rms[4];
+				for (size_t k = 0; k < 4; k++)
+				{
+					const __m128i frames = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&inSamples[i * 4 + (k * 8)]));
+					const __m128i paired = AbsoluteI16Saturated(_mm_shufflehi_epi16(_mm_shufflelo_epi16(frames, _MM_SHUFFLE(3, 1, 2, 0)), _MM_SHUFFLE(3, 1, 2, 0)));
+					peaks[k] = _mm_castsi128_ps(MaxOfI16PairsPerI32(paired));
+					rms[k] = _mm_castsi128_ps(RootMeanSquareI32(_mm_madd_epi16(paired, paired)));
+				}
+
+				const auto storeDeinterleaved = [](i16* outL, i16* outR, const __m128* lanes)
+				{
+					const __m128i l0 = _mm_castps_si128(_mm_shuffle_ps(lanes[0], lanes[1], _MM_SHUFFLE(2, 0, 2, 0)));
+					const __m128i r0 = _mm_castps_si128(_mm_shuffle_ps(lanes[0], lanes[1], _MM_SHUFFLE(3, 1, 3, 1)));
+					const __m128i l1 = _mm_castps_si128(_mm_shuffle_ps(lanes[2], lanes[3], _MM_SHUFFLE(2, 0, 2, 0)));
+					const __m128i r1 = _mm_castps_si128(_mm_shuffle_ps(lanes[2], lanes[3], _MM_SHUFFLE(3, 1, 3, 1)));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(outL), _mm_packs_epi32(l0, l1));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(outR), _mm_packs_epi32(r0, r1));
+				};
+				storeDeinterleaved(&outPeaksL[i], &outPeaksR[i], peaks);
+				storeDeinterleaved(&outRMSL[i], &outRMSR[i], rms);
+			}
+
+			ScalarKernels::ComputeStereoWaveformBuckets(&outPeaksL[i], &outRMSL[i], &outPeaksR[i], &outRMSR[i], &inSamples[i * 4], outCount - i);
+		}
+	}
+
+	namespace AVX2Kernels
+	{
+		PEEPO_TARGET_AVX2 static __m256 LoadI16x8AsF32(const i16* inSamples)
+		{
+			return _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(inSamples))));
+		}
+
+		PEEPO_TARGET_AVX2 static void MixStereoI16WithGain(f32* outSamples, const i16* inSamples, size_t frameCount, f32 gainL, f32 gainR)
+		{
+			const __m256 gain = _mm256_setr_ps(gainL, gainR, gainL, gainR, gainL, gainR, gainL, gainR);
+
+			size_t f = 0;
+			for (; (f + 8) <= frameCount; f += 8)
+			{
+				const __m256 in0 = LoadI16x8AsF32(&inSamples[f * 2 + 0]);
+				const __m256 in1 = LoadI16x8AsF32(&inSamples[f * 2 + 8]);
+				_mm256_storeu_ps(&outSamples[f * 2 + 0], _mm256_add_ps(_mm256_loadu_ps(&outSamples[f * 2 + 0]), _mm256_mul_ps(in0, gain)));
+				_mm256_storeu_ps(&outSamples[f * 2 + 8], _mm256_add_ps(_mm256_loadu_ps(&outSamples[f * 2 + 8]), _mm256_mul_ps(in1, gain)));
+			}
+
+			SSE2Kernels::MixStereoI16WithGain(&outSamples[f * 2], &inSamples[f * 2], frameCount - f, gainL, gainR);
+		}
+
+		PEEPO_TARGET_AVX2 static void MixStereoI16WithFrameGains(f32* outSamples, const i16* inSamples, const f32* frameGains, size_t frameCount, f32 gainL, f32 gainR)
+		{
+			const __m256 gain = _mm256_setr_ps(gainL, gainR, gainL, gainR, gainL, gainR, gainL, gainR);
+			const __m256i duplicateLow = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+			const __m256i duplicateHigh = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+
+			size_t f = 0;
+			for (; (f + 8) <= frameCount; f += 8)
+			{
+				const __m256 frameGain = _mm256_loadu_ps(&frameGains[f]);
+				const __m256 gain0 = _mm256_mul_ps(_mm256_permutevar8x32_ps(frameGain, duplicateLow), gain);
+				const __m256 gain1 = _mm256_mul_ps(_mm256_permutevar8x32_ps(frameGain, duplicateHigh), gain);
+
+				const __m256 in0 = LoadI16x8AsF32(&inSamples[f * 2 + 0]);
+				const __m256 in1 = LoadI16x8AsF32(&inSamples[f * 2 + 8]);
+				_mm256_storeu_ps(&outSamples[f * 2 + 0], _mm256_add_ps(_mm256_loadu_ps(&outSamples[f * 2 + 0]), _mm256_mul_ps(in0, gain0)));
+				_mm256_storeu_ps(&outSamples[f * 2 + 8], _mm256_add_ps(_mm256_loadu_ps(&outSamples[f * 2 + 8]), _mm256_mul_ps(in1, gain1)));
+			}
+
+			SSE2Kernels::MixStereoI16WithFrameGains(&outSamples[f * 2], &inSamples[f * 2], &frameGains[f], frameCount - f, gainL, gainR);
+		}
+
+		PEEPO_TARGET_AVX2 static void FindStereoFramePeaks(f32* outFramePeaks, const f32* inSamples, size_t frameCount, f32 preGain)
+		{
+			const __m256 gain = _mm256_set1_ps(preGain);
+			const __m256 signMask = _mm256_set1_ps(-0.0f);
+
+			size_t f = 0;
+			for (; (f + 8) <= frameCount; f += 8)
+			{
+				// NOTE: In-lane shuffles leave the frames ordered as 0 1 4 5 2 3 6 7, fixed up by a 64-bit cross-lane permute at the end
+				const __m256 in0 = _mm256_mul_ps(_mm256_loadu_ps(&inSamples[f * 2 + 0]), gain);
+				const __m256 in1 = _mm256_mul_ps(_mm256_loadu_ps(&inSamples[f * 2 + 8]), gain);
+				const __m256 l = _mm256_shuffle_ps(in0, in1, _MM_SHUFFLE(2, 0, 2, 0));
+				const __m256 r = _mm256_shuffle_ps(in0, in1, _MM_SHUFFLE(3, 1, 3, 1));
+				const __m256 rightIsLarger = _mm256_cmp_ps(_mm256_andnot_ps(signMask, r), _mm256_andnot_ps(signMask, l), _CMP_GT_OQ);
+				const __m256 peaks = _mm256_blendv_ps(l, r, rightIsLarger);
+				_mm256_storeu_ps(&outFramePeaks[f], _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(peaks), _MM_SHUFFLE(3, 1, 2, 0))));
+			}
+
+			SSE2Kernels::FindStereoFramePeaks(&outFramePeaks[f], &inSamples[f * 2], frameCount - f, preGain);
+		}
+
+		PEEPO_TARGET_AVX2 static void MixStereoF32WithFrameGains(f32* outSamples, const f32* inSamples, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+		{
+			const __m256 pre = _mm256_set1_ps(preGain);
+			const __m256 post = _mm256_set1_ps(postGain);
+			const __m256i duplicateLow = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+			const __m256i duplicateHigh = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+
+			size_t f = 0;
+			for (; (f + 8) <= frameCount; f += 8)
+			{
+				const __m256 frameGain = _mm256_loadu_ps(&frameGains[f]);
+				const __m256 in0 = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&inSamples[f * 2 + 0]), pre), _mm256_permutevar8x32_ps(frameGain, duplicateLow)), post);
+				const __m256 in1 = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&inSamples[f * 2 + 8]), pre), _mm256_permutevar8x32_ps(frameGain, duplicateHigh)), post);
+				_mm256_storeu_ps(&outSamples[f * 2 + 0], _mm256_add_ps(_mm256_loadu_ps(&outSamples[f * 2 + 0]), in0));
+				_mm256_storeu_ps(&outSamples[f * 2 + 8], _mm256_add_ps(_mm256_loadu_ps(&outSamples[f * 2 + 8]), in1));
+			}
+
+			SSE2Kernels::MixStereoF32WithFrameGains(&outSamples[f * 2], &inSamples[f * 2], &frameGains[f], frameCount - f, preGain, postGain);
+		}
+
+		PEEPO_TARGET_AVX2 static void MixStereoF32WithFrameGainsClampI16(i16* outSamples, const f32* inSamples, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+		{
+			const __m256 pre = _mm256_set1_ps(preGain);
+			const __m256 post = _mm256_set1_ps(postGain);
+			const __m256 sampleMin = _mm256_set1_ps(static_cast<f32>(I16Min));
+			const __m256 sampleMax = _mm256_set1_ps(static_cast<f32>(I16Max));
+			const __m256i duplicateLow = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+			const __m256i duplicateHigh = _mm256_setr_epi32(4, 4, 5, 5, 6, 6, 7, 7);
+
+			size_t f = 0;
+			for (; (f + 8) <= frameCount; f += 8)
+			{
+				const __m256 frameGain = _mm256_loadu_ps(&frameGains[f]);
+				const __m256 in0 = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&inSamples[f * 2 + 0]), pre), _mm256_permutevar8x32_ps(frameGain, duplicateLow)), post);
+				const __m256 in1 = _mm256_mul_ps(_mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(&inSamples[f * 2 + 8]), pre), _mm256_permutevar8x32_ps(frameGain, duplicateHigh)), post);
+				const __m256i clamped0 = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(in0, sampleMin), sampleMax));
+				const __m256i clamped1 = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(in1, sampleMin), sampleMax));
+
+				// NOTE: In-lane packing leaves the samples ordered as 0-3 8-11 4-7 12-15
+				const __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(clamped0, clamped1), _MM_SHUFFLE(3, 1, 2, 0));
+
+				__m256i* out = reinterpret_cast<__m256i*>(&outSamples[f * 2]);
+				_mm256_storeu_si256(out, _mm256_add_epi16(_mm256_loadu_si256(out), packed));
+			}
+
+			SSE2Kernels::MixStereoF32WithFrameGainsClampI16(&outSamples[f * 2], &inSamples[f * 2], &frameGains[f], frameCount - f, preGain, postGain);
+		}
+
+		PEEPO_TARGET_AVX2 static f32 DotProductF32x8(const f32* a, const f32* b, size_t count)
+		{
+			__m256 sums = _mm256_setzero_ps();
+			for (size_t i = 0; i < count; i += 8)
+				sums = _mm256_add_ps(sums, _mm256_mul_ps(_mm256_loadu_ps(&a[i]), _mm256_loadu_ps(&b[i])));
+			return SSE2Kernels::ReduceSumF32x4(_mm_add_ps(_mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1)));
+		}
+
+		PEEPO_TARGET_AVX2 static void ReduceWaveformBucketPairs(i16* outPeaks, i16* outRMS, const i16* inPeaks, const i16* inRMS, size_t outCount)
+		{
+			const __m256i lowHalfMask = _mm256_set1_epi32(0xFFFF);
+			const __m256 half = _mm256_set1_ps(0.5f);
+
+			size_t i = 0;
+			for (; (i + 16) <= outCount; i += 16)
+			{
+				// NOTE: In-lane packing leaves the samples ordered as 0-3 8-11 4-7 12-15
+				const __m256i peaks0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&inPeaks[i * 2 + 0]));
+				const __m256i peaks1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&inPeaks[i * 2 + 16]));
+				const __m256i maxPeaks0 = _mm256_and_si256(_mm256_max_epi16(peaks0, _mm256_srli_epi32(peaks0, 16)), lowHalfMask);
+				const __m256i maxPeaks1 = _mm256_and_si256(_mm256_max_epi16(peaks1, _mm256_srli_epi32(peaks1, 16)), lowHalfMask);
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&outPeaks[i]), _mm256_permute4x64_epi64(_mm256_packs_epi32(maxPeaks0, maxPeaks1), _MM_SHUFFLE(3, 1, 2, 0)));
+
+				const __m256i rms0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&inRMS[i * 2 + 0]));
+				const __m256i rms1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&inRMS[i * 2 + 16]));
+				const __m256i newRMS0 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_sqrt_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_madd_epi16(rms0, rms0)), half)), half));
+				const __m256i newRMS1 = _mm256_cvttps_epi32(_mm256_add_ps(_mm256_sqrt_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_madd_epi16(rms1, rms1)), half)), half));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(&outRMS[i]), _mm256_permute4x64_epi64(_mm256_packs_epi32(newRMS0, newRMS1), _MM_SHUFFLE(3, 1, 2, 0)));
+			}
+
+			SSE2Kernels::ReduceWaveformBucketPairs(&outPeaks[i], &outRMS[i], &inPeaks[i * 2], &inRMS[i * 2], outCount - i);
+		}
+
+		// NOTE: Deinterleaving doesn't map well onto 256-bit lanes and this is mostly bound by memory bandwidth anyway
+		static void ComputeStereoWaveformBuckets(i16* outPeaksL, i16* outRMSL, i16* outPeaksR, i16* outRMSR, const i16* inSamples, size_t outCount)
+		{
+			SSE2Kernels::ComputeStereoWaveformBuckets(outPeaksL, outRMSL, outPeaksR, outRMSR, inSamples, outCount);
+		}
+	}
+#endif
+
+	static SIMDInstructionSet DetectSupportedSIMDInstructionSet()
+	{
+#if PEEPO_SIMD_X64
+#if defined(_MSC_VER) && !defined(__clang__)
+		int cpuInfo[4] = {};
+		__cpuid(cpuInfo, 0);
+		const int maxFunctionID = cpuInfo[0];
+
+		__cpuid(cpuInfo, 1);
+		const b8 osUsesXSave = (cpuInfo[2] & (1 << 27)) != 0;
+		const b8 osSavesYMM = osUsesXSave && ((_xgetbv(0) & 0x6) == 0x6);
+
+		if (osSavesYMM && maxFunctionID >= 7)
+		{
+			__cpuidex(cpuInfo, 7, 0);
+			if (cpuInfo[1] & (1 << 5))
+				return SIMDInstructionSet::AVX2;
+		}
+#else
+		if (__builtin_cpu_supports("avx2"))
+			return SIMDInstructionSet::AVX2;
+#endif
+		return SIMDInstructionSet::SSE2;
+#else
+		return SIMDInstructionSet::Scalar;
+#endif
+	}
+
+	struct MixingKernelTable
+	{
+		SIMDInstructionSet InstructionSet;
+		decltype(&ScalarKernels::MixStereoI16WithGain) MixStereoI16WithGain;
+		decltype(&ScalarKernels::MixStereoI16WithFrameGains) MixStereoI16WithFrameGains;
+		decltype(&ScalarKernels::FindStereoFramePeaks) FindStereoFramePeaks;
+		decltype(&ScalarKernels::MixStereoF32WithFrameGains) MixStereoF32WithFrameGains;
+		decltype(&ScalarKernels::MixStereoF32WithFrameGainsClampI16) MixStereoF32WithFrameGainsClampI16;
+		decltype(&ScalarKernels::DotProductF32x8) DotProductF32x8;
+		decltype(&ScalarKernels::ReduceWaveformBucketPairs) ReduceWaveformBucketPairs;
+		decltype(&ScalarKernels::ComputeStereoWaveformBuckets) ComputeStereoWaveformBuckets;
+	};
+
+#define PEEPO_MIXING_KERNEL_TABLE(instructionSet, kernelNamespace) MixingKernelTable { instructionSet, \
+	&kernelNamespace::MixStereoI16WithGain, &kernelNamespace::MixStereoI16WithFrameGains, &kernelNamespace::FindStereoFramePeaks, \
+	&kernelNamespace::MixStereoF32WithFrameGains, &kernelNamespace::MixStereoF32WithFrameGainsClampI16, &kernelNamespace::DotProductF32x8, \
+	&kernelNamespace::ReduceWaveformBucketPairs, &kernelNamespace::ComputeStereoWaveformBuckets }
+
+	static MixingKernelTable CreateMixingKernelTable()
+	{
+		switch (DetectSupportedSIMDInstructionSet())
+		{
+#if PEEPO_SIMD_X64
+		case SIMDInstructionSet::AVX2: return PEEPO_MIXING_KERNEL_TABLE(SIMDInstructionSet::AVX2, AVX2Kernels);
+		case SIMDInstructionSet::SSE2: return PEEPO_MIXING_KERNEL_TABLE(SIMDInstructionSet::SSE2, SSE2Kernels);
+#endif
+		default: return PEEPO_MIXING_KERNEL_TABLE(SIMDInstructionSet::Scalar, ScalarKernels);
+		}
+	}
+
+#undef PEEPO_MIXING_KERNEL_TABLE
+
+	static const MixingKernelTable& GetMixingKernels()
+	{
+		static const MixingKernelTable table = CreateMixingKernelTable();
+		return table;
+	}
+
+	SIMDInstructionSet GetSupportedSIMDInstructionSet()
+	{
+		return GetMixingKernels().InstructionSet;
+	}
+
+	void MixStereoI16WithGain(f32* outSamples, const i16* inSamples, size_t frameCount, f32 gainL, f32 gainR)
+	{
+		GetMixingKernels().MixStereoI16WithGain(outSamples, inSamples, frameCount, gainL, gainR);
+	}
+
+	void MixStereoI16WithFrameGains(f32* outSamples, const i16* inSamples, const f32* frameGains, size_t frameCount, f32 gainL, f32 gainR)
+	{
+		GetMixingKernels().MixStereoI16WithFrameGains(outSamples, inSamples, frameGains, frameCount, gainL, gainR);
+	}
+
+	void FindStereoFramePeaks(f32* outFramePeaks, const f32* inSamples, size_t frameCount, f32 preGain)
+	{
+		GetMixingKernels().FindStereoFramePeaks(outFramePeaks, inSamples, frameCount, preGain);
+	}
+
+	void MixStereoF32WithFrameGains(f32* outSamples, const f32* inSamples, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+	{
+		GetMixingKernels().MixStereoF32WithFrameGains(outSamples, inSamples, frameGains, frameCount, preGain, postGain);
+	}
+
+	void MixStereoF32WithFrameGainsClampI16(i16* outSamples, const f32* inSamples, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain)
+	{
+		GetMixingKernels().MixStereoF32WithFrameGainsClampI16(outSamples, inSamples, frameGains, frameCount, preGain, postGain);
+	}
+
+	f32 DotProductF32x8(const f32* a, const f32* b, size_t count)
+	{
+		assert((count % 8) == 0);
+		return GetMixingKernels().DotProductF32x8(a, b, count);
+	}
+
+	void ReduceWaveformBucketPairs(i16* outPeaks, i16* outRMS, const i16* inPeaks, const i16* inRMS, size_t outCount)
+	{
+		GetMixingKernels().ReduceWaveformBucketPairs(outPeaks, outRMS, inPeaks, inRMS, outCount);
+	}
+
+	void ComputeStereoWaveformBuckets(i16* outPeaksL, i16* outRMSL, i16* outPeaksR, i16* outRMSR, const i16* inSamples, size_t outCount)
+	{
+		GetMixingKernels().ComputeStereoWaveformBuckets(outPeaksL, outRMSL, outPeaksR, outRMSR, inSamples, outCount);
+	}
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "core_types.h"
+
+namespace Audio
+{
+	// NOTE: Vectorized mixing kernels with a scalar fallback, the best supported instruction set is picked once at runtime.
+	//		 All mixing kernels operate on interleaved stereo buffers with counts given in frames (not samples)
+	//		 and produce the same results as their scalar counterparts (no fused multiply-add, identical operation order)
+	enum class SIMDInstructionSet : u8
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+		Count
+	};
+
+	constexpr cstr SIMDInstructionSetNames[EnumCount<SIMDInstructionSet>] =
+	{
+		"Scalar",
+		"SSE2",
+		"AVX2",
+	};
+
+	SIMDInstructionSet GetSupportedSIMDInstructionSet();
+
+	// NOTE: out[f][c] += in[f][c] * gain[c]
+	void MixStereoI16WithGain(f32* outSamples, const i16* inSamples, size_t frameCount, f32 gainL, f32 gainR);
+
+	// NOTE: out[f][c] += in[f][c] * (frameGains[f] * gain[c])
+	void MixStereoI16WithFrameGains(f32* outSamples, const i16* inSamples, const f32* frameGains, size_t frameCount, f32 gainL, f32 gainR);
+
+	// NOTE: outFramePeaks[f] = whichever of (in[f][0] * preGain) and (in[f][1] * preGain) has the larger absolute value, preferring the left channel
+	void FindStereoFramePeaks(f32* outFramePeaks, const f32* inSamples, size_t frameCount, f32 preGain);
+
+	// NOTE: out[f][c] += ((in[f][c] * preGain) * frameGains[f]) * postGain, clamping each added sample to the i16 range for integer output
+	void MixStereoF32WithFrameGains(f32* outSamples, const f32* inSamples, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain);
+	void MixStereoF32WithFrameGainsClampI16(i16* outSamples, const f32* inSamples, const f32* frameGains, size_t frameCount, f32 preGain, f32 postGain);
+
+	// NOTE: sum(a[i] * b[i]) over plain (non-interleaved) arrays, the count has to be a multiple of 8
+	f32 DotProductF32x8(const f32* a, const f32* b, size_t count);
+
+	// NOTE: outPeaks[i] = max(inPeaks[i * 2 + 0], inPeaks[i * 2 + 1]) and outRMS[i] = sqrt((inRMS[i * 2 + 0]^2 + inRMS[i * 2 + 1]^2) / 2), used to downsample waveform mip levels
+	void ReduceWaveformBucketPairs(i16* outPeaks, i16* outRMS, const i16* inPeaks, const i16* inRMS, size_t outCount);
+
+	// NOTE: Peak (absolute, saturated to I16Max) and RMS of each pair of frames, separately for the left and right channel, used for the base waveform mip level
+	void ComputeStereoWaveformBuckets(i16* outPeaksL, i16* outRMSL, i16* outPeaksR, i16* outRMSR, const i16* inSamples, size_t outCount);
+}
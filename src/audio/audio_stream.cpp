@@ -0,0 +1,227 @@
+#include "audio_stream.h"
+
+namespace Audio
+{
+	PCMSampleStream::~PCMSampleStream()
+	{
+		RequestStop();
+		if (workerThread.joinable())
+			workerThread.join();
+	}
+
+	DecodeFileResult PCMSampleStream::OpenAndStartDecoding(std::string_view fileNameWithExtension, std::shared_ptr<const u8[]> fileContentToShare, size_t fileSize, u32 waveformChannelCountToGenerate)
+	{
+		assert(!workerThread.joinable() && "Stream has already been started (?)");
+
+		fileContent = std::move(fileContentToShare);
+		if (decoder.Open(fileNameWithExtension, fileContent.get(), fileSize) != DecodeFileResult::FeelsGoodMan)
+			return DecodeFileResult::Sadge;
+
+		ChannelCount = decoder.ChannelCount;
+		SampleRate = decoder.SampleRate;
+		FrameCount = decoder.FrameCount;
+
+		ringSamples = std::unique_ptr<std::atomic<i16>[]>(new std::atomic<i16>[RingBufferFrameCount * ChannelCount]);
+		decodeSamples = std::unique_ptr<i16[]>(new i16[DecodeChunkFrameCount * ChannelCount]);
+		ScratchSamples = std::unique_ptr<i16[]>(new i16[MaxScratchFrameCount * ChannelCount]);
+
+		waveformChannelCount = Min(Min(waveformChannelCountToGenerate, ChannelCount), 2u);
+		isGeneratingWaveform = (waveformChannelCount > 0 && FrameCount > 0);
+		if (isGeneratingWaveform)
+		{
+			waveform.WaveformL.BeginIncrementalGeneration(FrameCount, SampleRate);
+			if (waveformChannelCount > 1) waveform.WaveformR.BeginIncrementalGeneration(FrameCount, SampleRate);
+		}
+		else if (waveformChannelCount > 0)
+		{
+			waveformPromise.set_value(WaveformResult {});
+		}
+
+		workerThread = std::thread([this] { WorkerThreadEntryPoint(); });
+		return DecodeFileResult::FeelsGoodMan;
+	}
+
+	void PCMSampleStream::RequestStop()
+	{
+		{
+			const auto lock = std::scoped_lock(workerMutex);
+			stopRequested = true;
+		}
+		workerWakeUp.notify_one();
+	}
+
+	std::future<PCMSampleStream::WaveformResult> PCMSampleStream::GetWaveformFuture()
+	{
+		assert(waveformChannelCount > 0 && "No waveform has been requested when opening the stream (?)");
+		return waveformPromise.get_future();
+	}
+
+	i64 PCMSampleStream::ReadAtOrFillSilence(i64 inFrameOffset, i64 inFrameCount, i16 outSamples[])
+	{
+		std::fill(outSamples, outSamples + (inFrameCount * ChannelCount), 0);
+
+		const i64 readStartFrame = Clamp<i64>(inFrameOffset, 0, FrameCount);
+		const i64 readEndFrame = Clamp<i64>(inFrameOffset + inFrameCount, 0, FrameCount);
+		if (readStartFrame >= readEndFrame)
+			return inFrameCount;
+
+		readerFrame.store(readStartFrame, std::memory_order_relaxed);
+
+		const u32 generationBefore = generation.load(std::memory_order_acquire);
+		const i64 windowStart = windowStartFrame.load(std::memory_order_acquire);
+		const i64 windowEnd = windowEndFrame.load(std::memory_order_acquire);
+
+		const b8 isSeeking = (generationBefore & 1);
+		if (isSeeking)
+			return inFrameCount;
+
+		if (readStartFrame < windowStart || readStartFrame > (windowEnd + MaxCatchUpFrameCount))
+		{
+			requestedSeekFrame.store(readStartFrame, std::memory_order_relaxed);
+			return inFrameCount;
+		}
+
+		// NOTE: Copy whatever part has already been decoded, the rest remains silent until the worker has caught up
+		const i64 copyStartFrame = readStartFrame;
+		const i64 copyEndFrame = Min(readEndFrame, windowEnd);
+		for (i64 frame = copyStartFrame; frame < copyEndFrame;)
+		{
+			const i64 ringFrameIndex = (frame % RingBufferFrameCount);
+			const i64 framesToCopy = Min(copyEndFrame - frame, RingBufferFrameCount - ringFrameIndex);
+			const std::atomic<i16>* ringSource = &ringSamples[ringFrameIndex * ChannelCount];
+			i16* outDestination = &outSamples[(frame - inFrameOffset) * ChannelCount];
+			for (i64 i = 0; i < (framesToCopy * ChannelCount); i++)
+				outDestination[i] = ringSource[i].load(std::memory_order_relaxed);
+			frame += framesToCopy;
+		}
+
+		// NOTE: The worker might have overwritten (part of) the copied frames in the meantime, in which case rather play silence than garbage
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const b8 wasOverwritten = (generation.load(std::memory_order_relaxed) != generationBefore) || (windowStartFrame.load(std::memory_order_relaxed) > copyStartFrame);
+		if (wasOverwritten && copyStartFrame < copyEndFrame)
+			std::fill(&outSamples[(copyStartFrame - inFrameOffset) * ChannelCount], &outSamples[(copyEndFrame - inFrameOffset) * ChannelCount], 0);
+
+		return inFrameCount;
+	}
+
+	void PCMSampleStream::WorkerThreadEntryPoint()
+	{
+		while (!stopRequested)
+		{
+			if (const i64 seekFrame = requestedSeekFrame.exchange(NoSeekRequest); seekFrame != NoSeekRequest)
+				WorkerSeekToFrame(seekFrame);
+
+			if (!WorkerDecodeNextChunk())
+			{
+				// NOTE: Polling instead of being notified by the render thread, which should never have to touch any synchronization primitives
+				auto lock = std::unique_lock(workerMutex);
+				workerWakeUp.wait_for(lock, std::chrono::milliseconds(2), [this] { return stopRequested.load(); });
+			}
+		}
+
+		// NOTE: Never leave the waveform future hanging, even if stopped halfway through
+		if (isGeneratingWaveform)
+			waveformPromise.set_value(WaveformResult {});
+	}
+
+	void PCMSampleStream::WorkerSeekToFrame(i64 frameIndex)
+	{
+		frameIndex = Clamp<i64>(frameIndex, 0, FrameCount);
+
+		generation.fetch_add(1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+
+		windowStartFrame.store(frameIndex, std::memory_order_relaxed);
+		windowEndFrame.store(frameIndex, std::memory_order_relaxed);
+		readerFrame.store(frameIndex, std::memory_order_relaxed);
+
+		generation.fetch_add(1, std::memory_order_release);
+	}
+
+	b8 PCMSampleStream::WorkerDecodeNextChunk()
+	{
+		const i64 windowStart = windowStartFrame.load(std::memory_order_relaxed);
+		const i64 windowEnd = windowEndFrame.load(std::memory_order_relaxed);
+		const i64 reader = Clamp(readerFrame.load(std::memory_order_relaxed), windowStart, windowEnd);
+
+		// NOTE: Fill as far ahead as possible while still keeping a few frames behind the reader around for small backwards jumps.
+		//		 While the waveform generation has moved the decoder elsewhere, only seek back once the ring buffer has drained to half its size
+		//		 so that the decoder isn't constantly jumping back and forth for every single chunk
+		const i64 decodeLimitFrame = Min(FrameCount, (reader - KeepBehindFrameCount) + RingBufferFrameCount);
+		const i64 framesToDecode = Min(DecodeChunkFrameCount, decodeLimitFrame - windowEnd);
+		const b8 isDecoderAtWindowEnd = (decoderFrame == windowEnd);
+		if (framesToDecode > 0 && (isDecoderAtWindowEnd || !isGeneratingWaveform || (windowEnd - reader) < (RingBufferFrameCount / 2)))
+		{
+			const i64 newWindowStart = Max(windowStart, (windowEnd + framesToDecode) - RingBufferFrameCount);
+			if (newWindowStart != windowStart)
+			{
+				windowStartFrame.store(newWindowStart, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_release);
+			}
+
+			WorkerDecodeFramesAt(windowEnd, framesToDecode);
+			for (i64 frame = 0; frame < framesToDecode;)
+			{
+				const i64 ringFrameIndex = ((windowEnd + frame) % RingBufferFrameCount);
+				const i64 framesToCopy = Min(framesToDecode - frame, RingBufferFrameCount - ringFrameIndex);
+				std::atomic<i16>* ringDestination = &ringSamples[ringFrameIndex * ChannelCount];
+				const i16* decodeSource = &decodeSamples[frame * ChannelCount];
+				for (i64 i = 0; i < (framesToCopy * ChannelCount); i++)
+					ringDestination[i].store(decodeSource[i], std::memory_order_relaxed);
+				frame += framesToCopy;
+			}
+			windowEndFrame.store(windowEnd + framesToDecode, std::memory_order_release);
+
+			if (isGeneratingWaveform && windowEnd == waveformFrame)
+				WorkerAppendWaveformFrames(windowEnd, framesToDecode);
+			return true;
+		}
+
+		// NOTE: Otherwise use the idle time to continue generating the waveform for the rest of the file
+		if (isGeneratingWaveform)
+		{
+			const i64 waveformFramesToDecode = Min(DecodeChunkFrameCount, FrameCount - waveformFrame);
+			WorkerDecodeFramesAt(waveformFrame, waveformFramesToDecode);
+			WorkerAppendWaveformFrames(waveformFrame, waveformFramesToDecode);
+			return true;
+		}
+
+		return false;
+	}
+
+	void PCMSampleStream::WorkerDecodeFramesAt(i64 frameIndex, i64 frameCount)
+	{
+		assert(frameCount <= DecodeChunkFrameCount);
+		if (decoderFrame != frameIndex)
+			decoder.SeekToFrame(frameIndex);
+
+		i64 framesDecoded = 0;
+		while (framesDecoded < frameCount)
+		{
+			const i64 framesRead = decoder.ReadFrames(&decodeSamples[framesDecoded * ChannelCount], frameCount - framesDecoded);
+			if (framesRead <= 0)
+				break;
+			framesDecoded += framesRead;
+		}
+
+		// NOTE: Reached the end of the file earlier than reported (or failed to decode), treat the rest as silence
+		std::fill(&decodeSamples[framesDecoded * ChannelCount], &decodeSamples[frameCount * ChannelCount], 0);
+		decoderFrame = (frameIndex + framesDecoded);
+	}
+
+	void PCMSampleStream::WorkerAppendWaveformFrames(i64 frameIndex, i64 frameCount)
+	{
+		assert(frameIndex == waveformFrame);
+		waveform.WaveformL.AppendIncrementalFrames(decodeSamples.get(), frameCount, ChannelCount, 0);
+		if (waveformChannelCount > 1) waveform.WaveformR.AppendIncrementalFrames(decodeSamples.get(), frameCount, ChannelCount, 1);
+		waveformFrame += frameCount;
+
+		if (waveformFrame >= FrameCount)
+		{
+			waveform.WaveformL.FinishIncrementalGeneration();
+			if (waveformChannelCount > 1) waveform.WaveformR.FinishIncrementalGeneration();
+			waveformPromise.set_value(std::move(waveform));
+			isGeneratingWaveform = false;
+		}
+	}
+}
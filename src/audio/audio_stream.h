@@ -0,0 +1,96 @@
+#pragma once
+#include "core_types.h"
+#include "audio_common.h"
+#include "audio_file_formats.h"
+#include "audio_waveform.h"
+#include <atomic>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+namespace Audio
+{
+	// NOTE: Keeps only a window of decoded PCM frames around the current read position resident (instead of the entire file),
+	//		 which is filled ahead of the reader by a background worker thread decoding chunks on demand.
+	//		 Reading is lock-free and meant to be done by the render thread. Reading outside of the decoded window returns silence
+	//		 and requests the worker to seek there, so that scrubbing around the song only causes a few milliseconds of silence
+	struct PCMSampleStream
+	{
+		struct WaveformResult
+		{
+			WaveformMipChain WaveformL, WaveformR;
+		};
+
+		static constexpr i64 RingBufferFrameCount = (1 << 18);
+		static constexpr i64 KeepBehindFrameCount = (1 << 15);
+		static constexpr i64 DecodeChunkFrameCount = (1 << 12);
+		// NOTE: Reading slightly past the end of the decoded window is expected to happen while the worker is still catching up, so don't restart decoding from scratch
+		static constexpr i64 MaxCatchUpFrameCount = (DecodeChunkFrameCount * 4);
+		static constexpr i64 MaxScratchFrameCount = (1 << 16);
+		static constexpr i64 NoSeekRequest = I64Min;
+
+	public:
+		PCMSampleStream() = default;
+		~PCMSampleStream();
+		PCMSampleStream(const PCMSampleStream&) = delete;
+		PCMSampleStream& operator=(const PCMSampleStream&) = delete;
+
+		// NOTE: Opens the decoder on the calling thread (so that the stream format is known upfront) and then starts the worker thread.
+		//		 For a non-zero waveform channel count the worker also generates the waveform of the first (up to two) channels
+		//		 from the same decoded chunks, continuing through the rest of the file whenever the ring buffer is full
+		DecodeFileResult OpenAndStartDecoding(std::string_view fileNameWithExtension, std::shared_ptr<const u8[]> fileContent, size_t fileSize, u32 waveformChannelCount = 0);
+		void RequestStop();
+
+		// NOTE: Only valid after requesting a waveform, fulfilled once the entire file has been decoded (or with empty waveforms if stopped before that)
+		std::future<WaveformResult> GetWaveformFuture();
+
+		// NOTE: Same semantics as PCMSampleBuffer::ReadAtOrFillSilence(), to be called from the render thread only
+		i64 ReadAtOrFillSilence(i64 inFrameOffset, i64 inFrameCount, i16 outSamples[]);
+
+	public:
+		u32 ChannelCount = 0;
+		u32 SampleRate = 0;
+		i64 FrameCount = 0;
+
+		// NOTE: Preallocated for the render thread to read a contiguous range of frames into, i.e. for variable playback speed interpolation
+		std::unique_ptr<i16[]> ScratchSamples;
+
+	private:
+		void WorkerThreadEntryPoint();
+		void WorkerSeekToFrame(i64 frameIndex);
+		b8 WorkerDecodeNextChunk();
+		void WorkerDecodeFramesAt(i64 frameIndex, i64 frameCount);
+		void WorkerAppendWaveformFrames(i64 frameIndex, i64 frameCount);
+
+	private:
+		std::shared_ptr<const u8[]> fileContent;
+		StreamingFileDecoder decoder;
+		// NOTE: Written by the worker while the render thread might still be reading the same frames, so every sample is accessed atomically (relaxed)
+		//		 with the acquire / release fences around the window updates then allowing the reader to validate its copy afterwards (seqlock style)
+		std::unique_ptr<std::atomic<i16>[]> ringSamples;
+		static_assert(std::atomic<i16>::is_always_lock_free);
+
+		// NOTE: Only ever accessed by the worker thread. The decoder is shared between filling the ring buffer and generating the waveform,
+		//		 so that sequentially playing back the song and generating its waveform only has to decode each frame once
+		std::unique_ptr<i16[]> decodeSamples;
+		i64 decoderFrame = 0;
+		u32 waveformChannelCount = 0;
+		b8 isGeneratingWaveform = false;
+		i64 waveformFrame = 0;
+		WaveformResult waveform;
+		std::promise<WaveformResult> waveformPromise;
+
+		// NOTE: Incremented before and after every seek (odd while seeking), so that the reader can detect reads that raced with a seek
+		std::atomic<u32> generation = 0;
+		// NOTE: Range of absolute frame indices currently available inside the ring buffer. The start is moved forward *before* overwriting old frames
+		std::atomic<i64> windowStartFrame = 0, windowEndFrame = 0;
+		std::atomic<i64> readerFrame = 0;
+		std::atomic<i64> requestedSeekFrame = NoSeekRequest;
+
+		std::atomic<b8> stopRequested = false;
+		std::mutex workerMutex;
+		std::condition_variable workerWakeUp;
+		std::thread workerThread;
+	};
+}
@@ -1,57 +1,73 @@
 #pragma once
 #include "core_types.h"
 #include "audio_common.h"
+#include "audio_simd.h"
+#include <future>
+#include <thread>
+#include <vector>
 
 // TODO: Texture cache (create interface for uploading texture pixels to have a clean separation from the actual rendering?)
 
 namespace Audio
 {
-	constexpr i16 AverageTwoI16SamplesTogether(i16 a, i16 b) { return static_cast<i16>((static_cast<i32>(a) + static_cast<i32>(b)) / 2); };
+	struct WaveformAmplitude
+	{
+		f32 Peak;
+		f32 RMS;
+	};
+
+	inline i16 AbsoluteSampleSaturated(i16 sample) { return (sample == I16Min) ? static_cast<i16>(I16Max) : Absolute(sample); }
+	inline f32 CombineTwoRMS(f32 a, f32 b) { return ::sqrtf(((a * a) + (b * b)) * 0.5f); }
 
+	// NOTE: Each sample (bucket) covers a fixed number of frames and stores both the absolute peak and the RMS of all of them
 	struct WaveformMip
 	{
 		size_t PowerOfTwoSampleCount = {};
 		Time TimePerSample = {};
 		f64 SamplesPerSecond = {};
-		std::vector<i16> AbsoluteSamples {};
+		// NOTE: Views into the single contiguous sample allocation owned by the parent mip chain
+		i16* PeakSamples = nullptr;
+		i16* RMSSamples = nullptr;
+		size_t SampleCount = 0;
 
 		inline Time GetDuration() const
 		{
-			return Time::FromSec(static_cast<f64>(AbsoluteSamples.size()) / SamplesPerSecond);
+			return Time::FromSec(static_cast<f64>(SampleCount) / SamplesPerSecond);
 		}
 
-		inline i16 SampleAtIndexOrZero(size_t sampleIndex) const
+		inline WaveformAmplitude NormalizedSampleAtIndexOrZero(i64 sampleIndex) const
 		{
-			return (sampleIndex < AbsoluteSamples.size()) ? AbsoluteSamples[sampleIndex] : static_cast<i16>(0);
+			if (sampleIndex < 0 || static_cast<size_t>(sampleIndex) >= SampleCount)
+				return WaveformAmplitude { 0.0f, 0.0f };
+			return WaveformAmplitude { PeakSamples[sampleIndex] / static_cast<f32>(I16Max), RMSSamples[sampleIndex] / static_cast<f32>(I16Max) };
 		}
 
-		inline i16 LinearSampleAtTimeOrZero(Time time) const
+		// NOTE: Reads at most two samples, which covers the entire range as long as it isn't any longer than TimePerSample (see WaveformMipChain::FindMipForTimeRange())
+		inline WaveformAmplitude NormalizedAmplitudeInTimeRange(Time startTime, Time endTime) const
 		{
-			const f32 sampleIndexF32 = static_cast<f32>(time.Seconds * SamplesPerSecond);
-			const f32 sampleIndexFraction = sampleIndexF32 - static_cast<i32>(sampleIndexF32);
+			const f64 startIndexF64 = (startTime.Seconds * SamplesPerSecond);
+			const i64 startIndex = static_cast<i64>(Floor(startIndexF64));
+			const i64 endIndex = static_cast<i64>(Floor(endTime.Seconds * SamplesPerSecond));
 
-			const size_t sampleIndexLo = (sampleIndexF32 <= 0.0f) ? 0 : static_cast<size_t>(sampleIndexF32);
-			const size_t sampleIndexHi = (sampleIndexLo + 1);
+			const WaveformAmplitude start = NormalizedSampleAtIndexOrZero(startIndex);
+			const WaveformAmplitude next = NormalizedSampleAtIndexOrZero(startIndex + 1);
 
-			const i16 sampleLo = SampleAtIndexOrZero(sampleIndexLo);
-			const i16 sampleHi = SampleAtIndexOrZero(sampleIndexHi);
-
-			const f32 normalizedSampleLo = static_cast<f32>(sampleLo / static_cast<f32>(I16Max));
-			const f32 normalizedSampleHi = static_cast<f32>(sampleHi / static_cast<f32>(I16Max));
-			const f32 normalizedSample = Lerp(normalizedSampleLo, normalizedSampleHi, sampleIndexFraction);
+			// NOTE: Zoomed in further than the resolution of the base mip so smoothly interpolate between neighboring samples instead
+			if (endIndex <= startIndex)
+			{
+				const f32 fraction = static_cast<f32>(startIndexF64 - static_cast<f64>(startIndex));
+				return WaveformAmplitude { Lerp(start.Peak, next.Peak, fraction), Lerp(start.RMS, next.RMS, fraction) };
+			}
 
-			return static_cast<i16>(normalizedSample * static_cast<f32>(I16Max));
+			return WaveformAmplitude { Max(start.Peak, next.Peak), CombineTwoRMS(start.RMS, next.RMS) };
 		}
 
-		f32 AverageNormalizedSampleInTimeRange(Time startTime, Time endTime) const
+		inline void SetSampleFromFramePair(size_t sampleIndex, i16 frameSampleA, i16 frameSampleB)
 		{
-			if (TimePerSample.Seconds <= 0.0) { assert(false); return 0.0f; }
-
-			i32 sampleSum = 0, sampleCount = 0;
-			for (Time timeIt = startTime; timeIt < endTime; timeIt += TimePerSample) { sampleSum += LinearSampleAtTimeOrZero(timeIt); sampleCount++; }
-
-			const i32 sampleAverage = (sampleSum / Max(sampleCount, 1));
-			return sampleAverage / static_cast<f32>(I16Max);
+			const i16 absoluteA = AbsoluteSampleSaturated(frameSampleA), absoluteB = AbsoluteSampleSaturated(frameSampleB);
+			const i32 sumOfSquares = (static_cast<i32>(absoluteA) * absoluteA) + (static_cast<i32>(absoluteB) * absoluteB);
+			PeakSamples[sampleIndex] = Max(absoluteA, absoluteB);
+			RMSSamples[sampleIndex] = static_cast<i16>(Min<i32>(static_cast<i32>(::sqrtf(static_cast<f32>(sumOfSquares) * 0.5f) + 0.5f), I16Max));
 		}
 
 		void Clear()
@@ -59,7 +75,9 @@ namespace Audio
 			PowerOfTwoSampleCount = {};
 			TimePerSample = {};
 			SamplesPerSecond = {};
-			AbsoluteSamples.clear();
+			PeakSamples = nullptr;
+			RMSSamples = nullptr;
+			SampleCount = 0;
 		}
 	};
 
@@ -67,10 +85,57 @@ namespace Audio
 	{
 		static constexpr size_t MaxMipLevels = 24;
 		static constexpr size_t MinMipSampleCount = 256;
+		// NOTE: Each worker generates the same power of two sized slice of every mip level, so that no synchronization between levels is needed.
+		//		 Because every level holds at least MinMipSampleCount samples it can always be evenly divided into that many slices
+		static constexpr size_t MaxWorkerSliceCount = MinMipSampleCount;
+		static constexpr size_t MinBaseSamplesPerWorkerSlice = (1 << 16);
 
 		WaveformMip AllMips[MaxMipLevels] {};
 		Time Duration {};
 
+	public:
+		WaveformMipChain() = default;
+		WaveformMipChain(const WaveformMipChain& other) { *this = other; }
+		WaveformMipChain(WaveformMipChain&& other) noexcept { *this = std::move(other); }
+
+		WaveformMipChain& operator=(const WaveformMipChain& other)
+		{
+			if (this == &other)
+				return *this;
+
+			std::copy(std::begin(other.AllMips), std::end(other.AllMips), std::begin(AllMips));
+			Duration = other.Duration;
+			sampleStorage = other.sampleStorage;
+			for (WaveformMip& mip : AllMips)
+			{
+				if (mip.PeakSamples != nullptr)
+					mip.PeakSamples = sampleStorage.data() + (mip.PeakSamples - other.sampleStorage.data());
+				if (mip.RMSSamples != nullptr)
+					mip.RMSSamples = sampleStorage.data() + (mip.RMSSamples - other.sampleStorage.data());
+			}
+			incrementalFrameIndex = other.incrementalFrameIndex;
+			incrementalUnpairedSample = other.incrementalUnpairedSample;
+			return *this;
+		}
+
+		WaveformMipChain& operator=(WaveformMipChain&& other) noexcept
+		{
+			if (this == &other)
+				return *this;
+
+			// NOTE: Moving the storage vector keeps its heap allocation so all of the mip views remain valid as is
+			std::copy(std::begin(other.AllMips), std::end(other.AllMips), std::begin(AllMips));
+			Duration = other.Duration;
+			sampleStorage = std::move(other.sampleStorage);
+			incrementalFrameIndex = other.incrementalFrameIndex;
+			incrementalUnpairedSample = other.incrementalUnpairedSample;
+
+			for (auto& mip : other.AllMips) mip.Clear();
+			other.Duration = {};
+			return *this;
+		}
+
+	public:
 		inline b8 IsEmpty() const
 		{
 			return AllMips[0].PowerOfTwoSampleCount == 0;
@@ -86,56 +151,150 @@ namespace Audio
 			return static_cast<i32>(MaxMipLevels);
 		}
 
-		inline const WaveformMip& FindClosestMip(Time timePerPixel) const
+		// NOTE: Picks the most detailed mip whose samples are at least as long as the given time range,
+		//		 so that looking up the amplitude of each (pixel sized) range has a constant cost independent of the zoom level
+		inline const WaveformMip& FindMipForTimeRange(Time timeRangeDuration) const
 		{
-			const WaveformMip* closestMip = &AllMips[0];
-			for (size_t i = 1; i < MaxMipLevels; i++)
+			const WaveformMip* foundMip = &AllMips[0];
+			for (size_t i = 0; i < MaxMipLevels; i++)
 			{
 				if (AllMips[i].PowerOfTwoSampleCount == 0)
 					break;
-				if (Absolute((AllMips[i].TimePerSample - timePerPixel).Seconds < Absolute((closestMip->TimePerSample - timePerPixel).Seconds)))
-					closestMip = &AllMips[i];
+				foundMip = &AllMips[i];
+				if (AllMips[i].TimePerSample >= timeRangeDuration)
+					break;
 			}
-			return *closestMip;
+			return *foundMip;
 		}
 
-		inline f32 GetAmplitudeAt(const WaveformMip& mip, Time time, Time timePerPixel) const
+		inline WaveformAmplitude GetAmplitudeAt(const WaveformMip& mip, Time time, Time timePerPixel) const
 		{
-			return mip.AverageNormalizedSampleInTimeRange(time, time + timePerPixel);
+			return mip.NormalizedAmplitudeInTimeRange(time, time + timePerPixel);
 		}
 
 		inline void GenerateEntireMipChainFromSampleBuffer(const PCMSampleBuffer& inSampleBuffer, u32 channelIndex, b8 includeFullSizeMip = false)
 		{
 			assert(inSampleBuffer.InterleavedSamples != nullptr && channelIndex < inSampleBuffer.ChannelCount);
-
-			Duration = FramesToTime(inSampleBuffer.FrameCount, inSampleBuffer.SampleRate);
-			if (AllMips[0].PowerOfTwoSampleCount != 0)
-				for (auto& mip : AllMips) mip.Clear();
+			AllocateMips(inSampleBuffer.FrameCount, inSampleBuffer.SampleRate, includeFullSizeMip);
 
 			WaveformMip& baseMip = AllMips[0];
-			baseMip.PowerOfTwoSampleCount = RoundUpToPowerOfTwo(static_cast<u32>(inSampleBuffer.FrameCount));
-			baseMip.TimePerSample = Time::FromSec(1.0 / static_cast<f64>(inSampleBuffer.SampleRate));
-			baseMip.SamplesPerSecond = static_cast<f64>(inSampleBuffer.SampleRate);
+			const i16* inSamples = inSampleBuffer.InterleavedSamples.get();
+			const size_t inChannelCount = inSampleBuffer.ChannelCount;
+			const size_t inFrameCount = static_cast<size_t>(inSampleBuffer.FrameCount);
+
+			ParallelForEachWorkerSlice(GetWorkerSliceCount(), [&](size_t sliceIndex, size_t sliceCount)
+			{
+				const size_t sliceBegin = (baseMip.PowerOfTwoSampleCount / sliceCount) * (sliceIndex + 0);
+				const size_t sliceEnd = Min((baseMip.PowerOfTwoSampleCount / sliceCount) * (sliceIndex + 1), baseMip.SampleCount);
+
+				if (includeFullSizeMip)
+				{
+					for (size_t frameIndex = sliceBegin; frameIndex < Min(sliceEnd, inFrameCount); frameIndex++)
+						baseMip.PeakSamples[frameIndex] = baseMip.RMSSamples[frameIndex] = AbsoluteSampleSaturated(inSamples[(frameIndex * inChannelCount) + channelIndex]);
+				}
+				else // NOTE: No need to waste memory storing the full size mip if it won't even get sampled AND is already duplicated inside the source buffer
+				{
+					for (size_t frameIndex = sliceBegin; frameIndex < Min(sliceEnd, inFrameCount / 2); frameIndex++)
+					{
+						baseMip.SetSampleFromFramePair(frameIndex,
+							inSamples[(((frameIndex * 2 + 0) * inChannelCount) + channelIndex)],
+							inSamples[(((frameIndex * 2 + 1) * inChannelCount) + channelIndex)]);
+					}
+				}
+
+				GenerateUpperMipSlice(sliceIndex, sliceCount);
+			});
+		}
+
+		// NOTE: Generates both channels in a single pass over the interleaved samples, equivalent to calling GenerateEntireMipChainFromSampleBuffer() for channel 0 and 1
+		static inline void GenerateStereoMipChainsFromSampleBuffer(const PCMSampleBuffer& inSampleBuffer, WaveformMipChain& outL, WaveformMipChain& outR)
+		{
+			assert(inSampleBuffer.InterleavedSamples != nullptr && inSampleBuffer.ChannelCount >= 2);
+			if (inSampleBuffer.ChannelCount != 2)
+			{
+				outL.GenerateEntireMipChainFromSampleBuffer(inSampleBuffer, 0);
+				outR.GenerateEntireMipChainFromSampleBuffer(inSampleBuffer, 1);
+				return;
+			}
+
+			outL.AllocateMips(inSampleBuffer.FrameCount, inSampleBuffer.SampleRate, false);
+			outR.AllocateMips(inSampleBuffer.FrameCount, inSampleBuffer.SampleRate, false);
+
+			const WaveformMip& baseMipL = outL.AllMips[0];
+			const WaveformMip& baseMipR = outR.AllMips[0];
+			const i16* inSamples = inSampleBuffer.InterleavedSamples.get();
+			const size_t inFrameCount = static_cast<size_t>(inSampleBuffer.FrameCount);
+
+			ParallelForEachWorkerSlice(outL.GetWorkerSliceCount(), [&](size_t sliceIndex, size_t sliceCount)
+			{
+				const size_t sliceBegin = (baseMipL.PowerOfTwoSampleCount / sliceCount) * (sliceIndex + 0);
+				const size_t sliceEnd = Min((baseMipL.PowerOfTwoSampleCount / sliceCount) * (sliceIndex + 1), inFrameCount / 2);
+				if (sliceBegin < sliceEnd)
+					ComputeStereoWaveformBuckets(&baseMipL.PeakSamples[sliceBegin], &baseMipL.RMSSamples[sliceBegin], &baseMipR.PeakSamples[sliceBegin], &baseMipR.RMSSamples[sliceBegin], &inSamples[sliceBegin * 4], sliceEnd - sliceBegin);
 
-			if (includeFullSizeMip)
+				outL.GenerateUpperMipSlice(sliceIndex, sliceCount);
+				outR.GenerateUpperMipSlice(sliceIndex, sliceCount);
+			});
+		}
+
+		// NOTE: Same as GenerateEntireMipChainFromSampleBuffer() (without the full size mip) but fed with consecutive chunks of frames
+		//		 as they are being decoded, so that the entire sample buffer never has to be resident at once
+		inline void BeginIncrementalGeneration(i64 totalFrameCount, u32 sampleRate)
+		{
+			AllocateMips(totalFrameCount, sampleRate, false);
+			incrementalFrameIndex = 0;
+			incrementalUnpairedSample = 0;
+		}
+
+		inline void AppendIncrementalFrames(const i16* inInterleavedSamples, i64 frameCount, u32 channelCount, u32 channelIndex)
+		{
+			assert(channelIndex < channelCount);
+
+			WaveformMip& baseMip = AllMips[0];
+			for (i64 f = 0; f < frameCount; f++, incrementalFrameIndex++)
 			{
-				baseMip.AbsoluteSamples.resize(inSampleBuffer.FrameCount);
-				for (size_t frameIndex = 0; frameIndex < static_cast<size_t>(inSampleBuffer.FrameCount); frameIndex++)
-					baseMip.AbsoluteSamples[frameIndex] = Absolute(inSampleBuffer.InterleavedSamples[(frameIndex * inSampleBuffer.ChannelCount) + channelIndex]);
+				const i16 sample = inInterleavedSamples[(f * channelCount) + channelIndex];
+				if ((incrementalFrameIndex & 1) == 0)
+				{
+					incrementalUnpairedSample = sample;
+					continue;
+				}
+
+				const size_t sampleIndex = (incrementalFrameIndex / 2);
+				if (sampleIndex < baseMip.SampleCount)
+					baseMip.SetSampleFromFramePair(sampleIndex, incrementalUnpairedSample, sample);
 			}
-			else // NOTE: No need to waste memory storing the full size mip if it won't even get sampled AND is already duplicated inside the source buffer
+		}
+
+		inline void FinishIncrementalGeneration()
+		{
+			ParallelForEachWorkerSlice(GetWorkerSliceCount(), [&](size_t sliceIndex, size_t sliceCount) { GenerateUpperMipSlice(sliceIndex, sliceCount); });
+		}
+
+	private:
+		std::vector<i16> sampleStorage;
+		// NOTE: Number of samples of the first non-base mip level that are derived from actual frames, with the rest being left as zero padding
+		size_t firstUpperMipFillCount = 0;
+		size_t incrementalFrameIndex = 0;
+		i16 incrementalUnpairedSample = 0;
+
+		inline void AllocateMips(i64 frameCount, u32 sampleRate, b8 includeFullSizeMip)
+		{
+			Duration = FramesToTime(frameCount, sampleRate);
+			for (auto& mip : AllMips) mip.Clear();
+
+			WaveformMip& baseMip = AllMips[0];
+			baseMip.PowerOfTwoSampleCount = RoundUpToPowerOfTwo(static_cast<u32>(frameCount));
+			baseMip.TimePerSample = Time::FromSec(1.0 / static_cast<f64>(sampleRate));
+			baseMip.SamplesPerSecond = static_cast<f64>(sampleRate);
+			baseMip.SampleCount = static_cast<size_t>(frameCount);
+
+			if (!includeFullSizeMip)
 			{
 				baseMip.PowerOfTwoSampleCount /= 2;
 				baseMip.TimePerSample = baseMip.TimePerSample * 2.0;
 				baseMip.SamplesPerSecond = baseMip.SamplesPerSecond / 2.0;
-				baseMip.AbsoluteSamples.resize(baseMip.PowerOfTwoSampleCount);
-				const size_t samplesToFill = ClampTop(baseMip.AbsoluteSamples.size(), static_cast<size_t>(inSampleBuffer.FrameCount / 2));
-				for (size_t frameIndex = 0; frameIndex < samplesToFill; frameIndex++)
-				{
-					baseMip.AbsoluteSamples[frameIndex] = AverageTwoI16SamplesTogether(
-						Absolute(inSampleBuffer.InterleavedSamples[(((frameIndex * 2 + 0) * inSampleBuffer.ChannelCount) + channelIndex)]),
-						Absolute(inSampleBuffer.InterleavedSamples[(((frameIndex * 2 + 1) * inSampleBuffer.ChannelCount) + channelIndex)]));
-				}
+				baseMip.SampleCount = baseMip.PowerOfTwoSampleCount;
 			}
 
 			// NOTE: First loop (separated) to compute sample counts
@@ -149,31 +308,67 @@ namespace Audio
 				newMip.PowerOfTwoSampleCount = (parentMip.PowerOfTwoSampleCount / 2);
 				newMip.TimePerSample = (parentMip.TimePerSample * 2.0);
 				newMip.SamplesPerSecond = (parentMip.SamplesPerSecond / 2.0);
+				newMip.SampleCount = newMip.PowerOfTwoSampleCount;
 			}
+			firstUpperMipFillCount = Min(AllMips[1].PowerOfTwoSampleCount, baseMip.SampleCount / 2);
 
-			// TODO: Consider having single continuous sample buffer and store view pointer (or start index) inside each WaveformMip
-			[[maybe_unused]] size_t totalSampleCountAcrossAllMips = 0;
+			// NOTE: Then lay out all levels (peaks followed by RMS) inside a single zero initialized allocation, with the base level padded up to its power of two size
+			size_t totalSampleCountAcrossAllMips = 0;
 			for (const WaveformMip& mip : AllMips)
-				totalSampleCountAcrossAllMips += (&mip == &baseMip) ? baseMip.AbsoluteSamples.size() : mip.PowerOfTwoSampleCount;
+				totalSampleCountAcrossAllMips += Max(mip.PowerOfTwoSampleCount, mip.SampleCount) * 2;
+
+			sampleStorage.clear();
+			sampleStorage.resize(totalSampleCountAcrossAllMips, 0);
+
+			i16* nextMipSamples = sampleStorage.data();
+			for (WaveformMip& mip : AllMips)
+			{
+				if (mip.PowerOfTwoSampleCount == 0)
+					break;
+				const size_t paddedSampleCount = Max(mip.PowerOfTwoSampleCount, mip.SampleCount);
+				mip.PeakSamples = nextMipSamples;
+				mip.RMSSamples = nextMipSamples + paddedSampleCount;
+				nextMipSamples += (paddedSampleCount * 2);
+			}
+		}
+
+		inline size_t GetWorkerSliceCount() const
+		{
+			const size_t maxSliceCount = Min(static_cast<size_t>(ClampBot(std::thread::hardware_concurrency(), 1u)), MaxWorkerSliceCount);
+
+			size_t sliceCount = 1;
+			while ((sliceCount * 2) <= maxSliceCount && (AllMips[0].PowerOfTwoSampleCount / (sliceCount * 2)) >= MinBaseSamplesPerWorkerSlice)
+				sliceCount *= 2;
+			return sliceCount;
+		}
+
+		template <typename SliceFunc>
+		static inline void ParallelForEachWorkerSlice(size_t sliceCount, SliceFunc sliceFunc)
+		{
+			std::vector<std::future<void>> sliceFutures;
+			sliceFutures.reserve(sliceCount);
+			for (size_t sliceIndex = 1; sliceIndex < sliceCount; sliceIndex++)
+				sliceFutures.push_back(std::async(std::launch::async, [&sliceFunc, sliceIndex, sliceCount] { sliceFunc(sliceIndex, sliceCount); }));
 
-			// NOTE: Second loop to then generate the actual mip sample buffers
+			sliceFunc(0, sliceCount);
+			for (auto& future : sliceFutures)
+				future.get();
+		}
+
+		inline void GenerateUpperMipSlice(size_t sliceIndex, size_t sliceCount)
+		{
 			for (size_t i = 1; i < MaxMipLevels; i++)
 			{
 				const WaveformMip& parentMip = AllMips[i - 1];
-				if (parentMip.PowerOfTwoSampleCount == 0)
+				const WaveformMip& thisMip = AllMips[i];
+				if (thisMip.PowerOfTwoSampleCount == 0)
 					break;
-				const size_t parentSampleCount = parentMip.AbsoluteSamples.size();
-				const i16* parentSamples = parentMip.AbsoluteSamples.data();
 
-				WaveformMip& thisMip = AllMips[i];
-				thisMip.AbsoluteSamples.resize(thisMip.PowerOfTwoSampleCount);
-				const size_t samplesToFill = ClampTop(thisMip.AbsoluteSamples.size(), (parentSampleCount / 2));
-				for (size_t sampleIndex = 0; sampleIndex < samplesToFill; sampleIndex++)
-				{
-					// ... assert(parentSamples >= &parentMip.AbsoluteSamples.front() && parentSamples <= &parentMip.AbsoluteSamples.back());
-					thisMip.AbsoluteSamples[sampleIndex] = AverageTwoI16SamplesTogether(parentSamples[0], parentSamples[1]);
-					parentSamples += 2;
-				}
+				const size_t fillCount = (i == 1) ? firstUpperMipFillCount : thisMip.PowerOfTwoSampleCount;
+				const size_t sliceBegin = (thisMip.PowerOfTwoSampleCount / sliceCount) * (sliceIndex + 0);
+				const size_t sliceEnd = Min((thisMip.PowerOfTwoSampleCount / sliceCount) * (sliceIndex + 1), fillCount);
+				if (sliceBegin < sliceEnd)
+					ReduceWaveformBucketPairs(&thisMip.PeakSamples[sliceBegin], &thisMip.RMSSamples[sliceBegin], &parentMip.PeakSamples[sliceBegin * 2], &parentMip.RMSSamples[sliceBegin * 2], sliceEnd - sliceBegin);
 			}
 		}
 	};
@@ -1,9 +1,9 @@
 #include "core_beat.h"
 #include <algorithm>
 
-Time TempoMapAccelerationStructure::ConvertBeatToTimeUsingLookupTableIndexing(Beat beat) const
+Time TempoMapAccelerationStructure::ConvertBeatToTimeUsingSegmentLookup(Beat beat) const
 {
-	const i32 beatTickToTimesCount = static_cast<i32>(BeatTickToTimes.size());
+	const i32 calculatedTickCount = GetCalculatedTickCount();
 	const i32 totalBeatTicks = beat.Ticks;
 
 	if (totalBeatTicks < 0) // NOTE: Negative tick (tempo changes are assumed to only be positive)
@@ -14,7 +14,7 @@ Time TempoMapAccelerationStructure::ConvertBeatToTimeUsingLookupTableIndexing(Be
 		// NOTE: Then scale by the negative tick
 		return firstTickDuration * totalBeatTicks;
 	}
-	else if (totalBeatTicks >= beatTickToTimesCount) // NOTE: Tick is outside the defined tempo map
+	else if (totalBeatTicks >= calculatedTickCount) // NOTE: Tick is outside the defined tempo map
 	{
 		// NOTE: Take the last calculated time
 		const Time lastTime = GetLastCalculatedTime();
@@ -23,23 +23,23 @@ Time TempoMapAccelerationStructure::ConvertBeatToTimeUsingLookupTableIndexing(Be
 		const Time lastTickDuration = Time::FromSec((60.0 / abs(LastTempoBPM)) / Beat::TicksPerBeat);
 
 		// NOTE: Then scale by the remaining ticks
-		const i32 remainingTicks = (totalBeatTicks - beatTickToTimesCount) + 1;
+		const i32 remainingTicks = (totalBeatTicks - calculatedTickCount) + 1;
 		return lastTime + (lastTickDuration * remainingTicks);
 	}
-	else // NOTE: Use the pre calculated lookup table directly
+	else // NOTE: Evaluate the segment containing the tick directly
 	{
-		return BeatTickToTimes.at(totalBeatTicks);
+		return GetCalculatedTickTime(totalBeatTicks);
 	}
 }
 
-Beat TempoMapAccelerationStructure::ConvertTimeToBeatUsingLookupTableBinarySearch(Time time) const
+Beat TempoMapAccelerationStructure::ConvertTimeToBeatUsingSegmentBinarySearch(Time time) const
 {
-	return ConvertTimeToBeatUsingLookupTableBinarySearch(time, false);
+	return ConvertTimeToBeatUsingSegmentBinarySearch(time, false);
 }
 
-Beat TempoMapAccelerationStructure::ConvertTimeToBeatUsingLookupTableBinarySearch(Time time, bool truncTo0) const
+Beat TempoMapAccelerationStructure::ConvertTimeToBeatUsingSegmentBinarySearch(Time time, bool truncTo0) const
 {
-	const i32 beatTickToTimesCount = static_cast<i32>(BeatTickToTimes.size());
+	const i32 calculatedTickCount = GetCalculatedTickCount();
 	const Time lastTime = GetLastCalculatedTime();
 
 	if (time < Time::FromSec(0.0)) // NOTE: Negative time
@@ -61,35 +61,40 @@ Beat TempoMapAccelerationStructure::ConvertTimeToBeatUsingLookupTableBinarySearc
 		const f64 ticks = (timePastLast / lastTickDuration);
 
 		// NOTE: And add it to the last tick
-		return Beat(static_cast<i32>(beatTickToTimesCount + ticks - 1));
+		return Beat(static_cast<i32>(calculatedTickCount + ticks - 1));
 	}
-	else // NOTE: Perform a binary search
+	else // NOTE: Perform a binary search for the segment, then solve for the tick within it
 	{
-		i32 left = 0, right = beatTickToTimesCount - 1;
-
-		while (left <= right)
-		{
-			const i32 mid = (left + right) / 2;
-
-			if (time < BeatTickToTimes[mid])
-				right = mid - 1;
-			else if (time > BeatTickToTimes[mid])
-				left = mid + 1;
-			else
-				return Beat::FromTicks(mid);
-		}
-
-		// left > right
+		// NOTE: The first segment always starts at zero so there is guaranteed to be one starting at or before a non-negative time
+		const auto nextSegmentIt = std::upper_bound(Segments.begin(), Segments.end(), time, [](Time t, const Segment& segment) { return t < segment.StartTime; });
+		const Segment& segment = *(nextSegmentIt - 1);
+		const i32 segmentEndTick = (nextSegmentIt != Segments.end()) ? nextSegmentIt->BeatTick : calculatedTickCount;
+
+		// NOTE: Estimate using the (constant) tick duration and then correct for any floating point rounding,
+		//		 so that the result always matches that of a binary search over all individually calculated tick times
+		const f64 estimatedTicks = Clamp((time - segment.StartTime).Seconds / segment.TickDuration, 0.0, static_cast<f64>(segmentEndTick - 1 - segment.BeatTick));
+		i32 right = segment.BeatTick + static_cast<i32>(estimatedTicks);
+		while ((right + 1) < segmentEndTick && GetCalculatedTickTime(segment, right + 1) <= time)
+			right++;
+		while (right > segment.BeatTick && GetCalculatedTickTime(segment, right) > time)
+			right--;
+
+		const Time rightTime = GetCalculatedTickTime(segment, right);
+		if (rightTime == time)
+			return Beat::FromTicks(right);
+
+		const i32 left = (right + 1);
+		const Time leftTime = GetCalculatedTickTime(left);
 		return Beat::FromTicks((truncTo0) ? right
-			: (BeatTickToTimes[left] - time) < (time - BeatTickToTimes[right]) ? left : right);
+			: (leftTime - time) < (time - rightTime) ? left : right);
 	}
 }
 
 // find the integer HBScroll beat tick by `beat`, and then interpolate or extrapolate to `time`
 // allow over-extrapolating for reproducing TaikoJiro "time offset over tempo change" behavior
-f64 TempoMapAccelerationStructure::ConvertBeatAndTimeToHBScrollBeatTickUsingLookupTableIndexing(Beat beat, Time time) const
+f64 TempoMapAccelerationStructure::ConvertBeatAndTimeToHBScrollBeatTickUsingSegmentLookup(Beat beat, Time time) const
 {
-	const i32 beatTickToTimesCount = static_cast<i32>(BeatTickToTimes.size());
+	const i32 calculatedTickCount = GetCalculatedTickCount();
 	const i32 totalBeatTicks = beat.Ticks;
 
 	if (totalBeatTicks < 0) // NOTE: Negative tick (tempo changes are assumed to only be positive)
@@ -100,7 +105,7 @@ f64 TempoMapAccelerationStructure::ConvertBeatAndTimeToHBScrollBeatTickUsingLook
 		// NOTE: Then the time by the negative tick, this is assuming all tempo changes happen on positive ticks
 		return time / firstTickDuration;
 	}
-	else if (totalBeatTicks + 1 >= beatTickToTimesCount) // NOTE: Next tick is outside the defined tempo map
+	else if (totalBeatTicks + 1 >= calculatedTickCount) // NOTE: Next tick is outside the defined tempo map
 	{
 		const f64 lastHBScrollBeatTick = GetLastCalculatedHBScrollBeatTick();
 		const Time lastTime = GetLastCalculatedTime();
@@ -115,14 +120,13 @@ f64 TempoMapAccelerationStructure::ConvertBeatAndTimeToHBScrollBeatTickUsingLook
 		// NOTE: And add it to the last tick
 		return (lastHBScrollBeatTick + ticks);
 	}
-	else // NOTE: Use the pre calculated lookup table directly
+	else // NOTE: Evaluate the segments containing the tick and the one after it
 	{
 		// find the integer HBScroll beat tick using `beat`, and then interpolate by `time`
-		const i32 totalBeatTicks = beat.Ticks;
-		const f64 timeLeft = BeatTickToTimes.at(totalBeatTicks).Seconds;
-		const f64 timeRight = BeatTickToTimes.at(totalBeatTicks + 1).Seconds;
-		const f64 ticksLeft = BeatTickToHBScrollBeatTicks.at(totalBeatTicks);
-		const f64 ticksRight = BeatTickToHBScrollBeatTicks.at(totalBeatTicks + 1);
+		const f64 timeLeft = GetCalculatedTickTime(totalBeatTicks).Seconds;
+		const f64 timeRight = GetCalculatedTickTime(totalBeatTicks + 1).Seconds;
+		const f64 ticksLeft = GetCalculatedTickHBScrollBeatTick(totalBeatTicks);
+		const f64 ticksRight = GetCalculatedTickHBScrollBeatTick(totalBeatTicks + 1);
 
 		return ConvertRange(timeLeft, timeRight, ticksLeft, ticksRight, time.Seconds);
 	}
@@ -130,15 +134,49 @@ f64 TempoMapAccelerationStructure::ConvertBeatAndTimeToHBScrollBeatTickUsingLook
 
 Time TempoMapAccelerationStructure::GetLastCalculatedTime() const
 {
-	return BeatTickToTimes.empty() ? Time::Zero() : BeatTickToTimes.back();
+	return Segments.empty() ? Time::Zero() : Segments.back().StartTime;
 }
 
 f64 TempoMapAccelerationStructure::GetLastCalculatedHBScrollBeatTick() const
 {
-	return BeatTickToHBScrollBeatTicks.empty() ? 0.0 : BeatTickToHBScrollBeatTicks.back();
+	return Segments.empty() ? 0.0 : Segments.back().HBScrollBeatTick;
+}
+
+i32 TempoMapAccelerationStructure::GetCalculatedTickCount() const
+{
+	return Segments.empty() ? 0 : (Segments.back().BeatTick + 1);
+}
+
+size_t TempoMapAccelerationStructure::FindSegmentIndexForTick(i32 tick) const
+{
+	assert(!Segments.empty() && tick >= Segments[0].BeatTick);
+	const auto nextSegmentIt = std::upper_bound(Segments.begin(), Segments.end(), tick, [](i32 t, const Segment& segment) { return t < segment.BeatTick; });
+	return static_cast<size_t>(nextSegmentIt - Segments.begin()) - 1;
+}
+
+Time TempoMapAccelerationStructure::GetCalculatedTickTime(const Segment& segment, i32 tick) const
+{
+	// NOTE: Must exactly match the same floating point operations as if every tick was iteratively calculated
+	return Time::FromSec((segment.TickDuration * static_cast<f64>(tick - segment.BeatTick)) + segment.StartTime.Seconds);
+}
+
+Time TempoMapAccelerationStructure::GetCalculatedTickTime(i32 tick) const
+{
+	return GetCalculatedTickTime(Segments[FindSegmentIndexForTick(tick)], tick);
+}
+
+i32 TempoMapAccelerationStructure::GetCalculatedTickHBScrollBeatTick(i32 tick) const
+{
+	const Segment& segment = Segments[FindSegmentIndexForTick(tick)];
+	return segment.HBScrollBeatTick + (segment.HBScrollTickSign * (tick - segment.BeatTick));
 }
 
 void TempoMapAccelerationStructure::Rebuild(const TempoChange* inTempoChanges, size_t inTempoCount)
+{
+	RebuildFromBeat(inTempoChanges, inTempoCount, Beat::Zero());
+}
+
+void TempoMapAccelerationStructure::RebuildFromBeat(const TempoChange* inTempoChanges, size_t inTempoCount, Beat firstChangedBeat)
 {
 	const TempoChange* tempoChanges = inTempoChanges;
 	size_t tempoCount = inTempoCount;
@@ -154,13 +192,23 @@ void TempoMapAccelerationStructure::Rebuild(const TempoChange* inTempoChanges, s
 		tempoCount = TempoBuffer.size();
 	}
 
-	size_t nTickValues = (tempoCount > 0) ? tempoChanges[tempoCount - 1].Beat.Ticks + 1 : 0;
-	BeatTickToTimes.resize(nTickValues);
-	BeatTickToHBScrollBeatTicks.resize(nTickValues);
+	// NOTE: Segments are only defined by their own and all previous tempo changes, so everything starting before the first changed beat can be kept as is.
+	//		 Any edit at or before the zero beat (including the implicit fallback tempo coming and going) always requires a full rebuild
+	size_t keptSegmentCount = 0;
+	if (firstChangedBeat > Beat::Zero())
+	{
+		const auto firstChangedSegmentIt = std::lower_bound(Segments.begin(), Segments.end(), firstChangedBeat.Ticks, [](const Segment& segment, i32 tick) { return segment.BeatTick < tick; });
+		keptSegmentCount = Min(static_cast<size_t>(firstChangedSegmentIt - Segments.begin()), tempoCount);
+	}
+
+#if PEEPO_DEBUG
+	for (size_t i = 0; i < keptSegmentCount; i++)
+		assert(Segments[i].BeatTick == tempoChanges[i].Beat.Ticks && "Tempo changes before the first changed beat must remain unchanged");
+#endif
+
+	Segments.resize(tempoCount);
 
-	f64 lastEndTime = 0.0;
-	i32 lastEndHBScrollBeatTick = 0;
-	for (size_t tempoChangeIndex = 0; tempoChangeIndex < tempoCount; tempoChangeIndex++)
+	for (size_t tempoChangeIndex = keptSegmentCount; tempoChangeIndex < tempoCount; tempoChangeIndex++)
 	{
 		const TempoChange& tempoChange = tempoChanges[tempoChangeIndex];
 
@@ -169,25 +217,64 @@ void TempoMapAccelerationStructure::Rebuild(const TempoChange* inTempoChanges, s
 		const f64 tickDuration = abs(beatDuration / Beat::TicksPerBeat);
 		const f64 tickSign = Sign(beatDuration);
 
-		const b8 isSingleOrLastTempo = (tempoCount == 1) || (tempoChangeIndex == (tempoCount - 1));
-		const size_t timesCount = isSingleOrLastTempo ? BeatTickToTimes.size() : (tempoChanges[tempoChangeIndex + 1].Beat.Ticks);
+		Segment& segment = Segments[tempoChangeIndex];
+		segment.BeatTick = tempoChange.Beat.Ticks;
+		segment.HBScrollTickSign = static_cast<i32>(tickSign);
+		segment.TickDuration = tickDuration;
 
-		for (size_t i = 0, t = tempoChange.Beat.Ticks; t < timesCount; i++, t++)
+		if (tempoChangeIndex == 0)
 		{
-			BeatTickToTimes[t] = Time::FromSec((tickDuration * i) + lastEndTime);
-			BeatTickToHBScrollBeatTicks[t] = ((tickSign * i) + lastEndHBScrollBeatTick);
+			segment.StartTime = Time::Zero();
+			segment.HBScrollBeatTick = 0;
+			FirstTempoBPM = bpm;
 		}
-
-		if (tempoCount > 1)
+		else
 		{
-			lastEndTime = BeatTickToTimes[timesCount - 1].ToSec() + tickDuration;
-			lastEndHBScrollBeatTick = BeatTickToHBScrollBeatTicks[timesCount - 1] + tickSign;
+			// NOTE: Continue from the time of the last tick within the previous segment (rather than scaling its whole duration at once)
+			//		 to produce the exact same values as an iteratively accumulated per-tick lookup table would
+			const Segment& lastSegment = Segments[tempoChangeIndex - 1];
+			const i32 lastTickWithinLastSegment = (segment.BeatTick - 1);
+			segment.StartTime = Time::FromSec(GetCalculatedTickTime(lastSegment, lastTickWithinLastSegment).ToSec() + lastSegment.TickDuration);
+			segment.HBScrollBeatTick = lastSegment.HBScrollBeatTick + (lastSegment.HBScrollTickSign * (lastTickWithinLastSegment - lastSegment.BeatTick)) + lastSegment.HBScrollTickSign;
 		}
-
-		FirstTempoBPM = (tempoChangeIndex == 0) ? bpm : FirstTempoBPM;
-		LastTempoBPM = bpm;
 	}
 
+	LastTempoBPM = SafetyCheckTempo(tempoChanges[tempoCount - 1].Tempo).BPM;
+
 	if (!TempoBuffer.empty())
 		TempoBuffer.clear();
 }
+
+SortedTempoMap::BarAtBeat SortedTempoMap::FindBarAtBeat(Beat beat) const
+{
+	const auto& signatureChanges = Signature.Sorted;
+	const Beat targetBeat = ClampBot(beat, Beat::Zero());
+
+	Beat barBeat = Beat::Zero();
+	i32 barIndex = 0, beatIndex = 0;
+	while (true)
+	{
+		// NOTE: The signature of each bar is that of the last change at or before its start, with the index of the next change directly following it
+		const size_t nextSignatureIndex = static_cast<size_t>(std::partition_point(signatureChanges.begin(), signatureChanges.end(), [barBeat](const TimeSignatureChange& v) { return v.Beat <= barBeat; }) - signatureChanges.begin());
+		const TimeSignatureChange* thisChange = (nextSignatureIndex > 0) ? &signatureChanges[nextSignatureIndex - 1] : nullptr;
+		const TimeSignatureChange* nextChange = (nextSignatureIndex < signatureChanges.size()) ? &signatureChanges[nextSignatureIndex] : nullptr;
+
+		const TimeSignature thisSignature = GetSanitizedBarSignature(thisChange);
+		const i32 ticksPerBar = std::max(abs(thisSignature.GetDurationPerBar()), Beat::FromTicks(1)).Ticks;
+		const i32 beatsPerBar = abs(thisSignature.GetBeatsPerBar());
+		const i32 barsUntilTarget = (targetBeat - barBeat).Ticks / ticksPerBar;
+		const i32 barsUntilNextChange = (nextChange == nullptr) ? I32Max : ((nextChange->Beat - barBeat).Ticks + ticksPerBar - 1) / ticksPerBar;
+
+		if (barsUntilTarget < barsUntilNextChange)
+		{
+			barBeat += Beat::FromTicks(barsUntilTarget * ticksPerBar);
+			barIndex += barsUntilTarget;
+			beatIndex += (barsUntilTarget * beatsPerBar);
+			return BarAtBeat { barBeat, barIndex, beatIndex, (thisChange != nullptr) ? (nextSignatureIndex - 1) : 0 };
+		}
+
+		barBeat += Beat::FromTicks(barsUntilNextChange * ticksPerBar);
+		barIndex += barsUntilNextChange;
+		beatIndex += (barsUntilNextChange * beatsPerBar);
+	}
+}
@@ -176,10 +176,23 @@ struct BeatSortedForwardIterator
 	inline T* Next(std::vector<T>& sortedList, Beat nextBeat) { return const_cast<T*>(Next(std::as_const(sortedList), nextBeat)); }
 };
 
+template <typename It>
+struct BeatSortedListRange
+{
+	It First, Last;
+
+	inline b8 empty() const { return First == Last; }
+	inline size_t size() const { return static_cast<size_t>(Last - First); }
+	inline It begin() const { return First; }
+	inline It end() const { return Last; }
+};
+
 template <typename T>
 struct BeatSortedList
 {
 	using value_type = T;
+	using iterator = typename std::vector<T>::iterator;
+	using const_iterator = typename std::vector<T>::const_iterator;
 
 	std::vector<T> Sorted;
 
@@ -193,9 +206,16 @@ public:
 	T* TryFindOverlappingBeat(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck = true);
 	const T* TryFindOverlappingBeat(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck = true) const;
 	// bypass sanity check, for untrusted inputs
+	// NOTE: Both rely on the items not overlapping each other, see BeatIntervalAccelerationStructure for also handling items nested inside of long items
 	T* TryFindOverlappingBeatUntrusted(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck = true);
 	const T* TryFindOverlappingBeatUntrusted(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck = true) const;
 
+	// NOTE: All items overlapping the given beat range (using the same inclusive / exclusive rules as above) as a [First, Last) iterator range.
+	//		 Relies on the items not overlapping each other (as is the case for any valid chart) to find the start of the range,
+	//		 see BeatIntervalAccelerationStructure for also handling items nested inside of long items
+	BeatSortedListRange<iterator> FindOverlappingRange(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck = true);
+	BeatSortedListRange<const_iterator> FindOverlappingRange(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck = true) const;
+
 	// return the to-insert index
 	template <typename Func> size_t InsertOrFunc(const T& valueToInsert, Func funcExist);
 	// return { the to-insert index, is inserted }
@@ -206,6 +226,13 @@ public:
 	void RemoveAtBeat(Beat beatToFindAndRemove);
 	void RemoveAtIndex(size_t indexToRemove);
 
+	// NOTE: Batched versions of the above which sort the given values once and then merge them with the list in a single linear pass,
+	//		 instead of searching and shifting the entire vector for every single item. Same results as calling the single versions one after another
+	template <typename Func> void InsertOrFuncRange(std::vector<T> valuesToInsert, Func funcExist);
+	void InsertOrUpdateRange(std::vector<T> valuesToInsertOrUpdate);
+	// NOTE: Removes the item at the beat of each of the given values (of any type with a beat)
+	template <typename TRange> void RemoveRange(const TRange& valuesToFindAndRemove);
+
 	int CountIf(std::function<bool(const T&)> predicate) const { return std::count_if(Sorted.begin(), Sorted.end(), predicate); }
 	std::vector<T> Filter(std::function<bool(const T&)> predicate) const {
 		std::vector<T> result;
@@ -227,20 +254,40 @@ public:
 
 struct TempoMapAccelerationStructure
 {
-	// NOTE: Pre calculated beat times up to the last tempo change
-	std::vector<Time> BeatTickToTimes;
-	std::vector<i32> BeatTickToHBScrollBeatTicks;
+	// NOTE: One piecewise-linear segment per tempo change, each covering the ticks [BeatTick, nextSegment.BeatTick)
+	//		 with the last segment only covering its own start tick, everything past that is extrapolated using the last tempo
+	struct Segment
+	{
+		i32 BeatTick;
+		i32 HBScrollBeatTick;
+		i32 HBScrollTickSign;
+		Time StartTime;
+		f64 TickDuration;
+	};
+
+	std::vector<Segment> Segments;
 	std::vector<TempoChange> TempoBuffer;
 	f64 FirstTempoBPM = 0.0, LastTempoBPM = 0.0;
 
-	Time ConvertBeatToTimeUsingLookupTableIndexing(Beat beat) const;
-	Beat ConvertTimeToBeatUsingLookupTableBinarySearch(Time time) const;
-	Beat ConvertTimeToBeatUsingLookupTableBinarySearch(Time time, bool truncTo0) const;
-	f64 ConvertBeatAndTimeToHBScrollBeatTickUsingLookupTableIndexing(Beat beat, Time time) const;
+	Time ConvertBeatToTimeUsingSegmentLookup(Beat beat) const;
+	Beat ConvertTimeToBeatUsingSegmentBinarySearch(Time time) const;
+	Beat ConvertTimeToBeatUsingSegmentBinarySearch(Time time, bool truncTo0) const;
+	f64 ConvertBeatAndTimeToHBScrollBeatTickUsingSegmentLookup(Beat beat, Time time) const;
 
 	Time GetLastCalculatedTime() const;
 	f64 GetLastCalculatedHBScrollBeatTick() const;
 	void Rebuild(const TempoChange* inTempoChanges, size_t inTempoCount);
+	// NOTE: Only recalculates the segments at or after the first changed beat and reuses all those before it,
+	//		 requires every tempo change before that beat to have remained unchanged since the last rebuild
+	void RebuildFromBeat(const TempoChange* inTempoChanges, size_t inTempoCount, Beat firstChangedBeat);
+
+private:
+	// NOTE: Number of ticks covered by the segments, equivalent to the size of a fully expanded per-tick lookup table
+	i32 GetCalculatedTickCount() const;
+	size_t FindSegmentIndexForTick(i32 tick) const;
+	Time GetCalculatedTickTime(const Segment& segment, i32 tick) const;
+	Time GetCalculatedTickTime(i32 tick) const;
+	i32 GetCalculatedTickHBScrollBeatTick(i32 tick) const;
 };
 
 // NOTE: Used when no other tempo / time signature change is defined (empty list or pre-first beat)
@@ -262,25 +309,28 @@ public:
 
 	// NOTE: Must manually be called every time a TempoChange has been edited otherwise Beat <-> Time conversions will be incorrect
 	inline void RebuildAccelerationStructure() { AccelerationStructure.Rebuild(Tempo.data(), Tempo.size()); }
-	inline Time BeatToTime(Beat beat) const { return AccelerationStructure.ConvertBeatToTimeUsingLookupTableIndexing(beat); }
+	// NOTE: Cheaper alternative for single edits, the given beat must be at or before the earliest added, removed or edited TempoChange
+	inline void RebuildAccelerationStructureFrom(Beat firstChangedBeat) { AccelerationStructure.RebuildFromBeat(Tempo.data(), Tempo.size(), firstChangedBeat); }
+	inline Time BeatToTime(Beat beat) const { return AccelerationStructure.ConvertBeatToTimeUsingSegmentLookup(beat); }
 	inline Beat TimeToBeat(Time time) const { return TimeToBeat(time, false); }
-	inline Beat TimeToBeat(Time time, bool truncTo0) const { return AccelerationStructure.ConvertTimeToBeatUsingLookupTableBinarySearch(time, truncTo0); }
-	inline f64 BeatAndTimeToHBScrollBeatTick(Beat beat, Time time) const { return AccelerationStructure.ConvertBeatAndTimeToHBScrollBeatTickUsingLookupTableIndexing(beat, time); }
+	inline Beat TimeToBeat(Time time, bool truncTo0) const { return AccelerationStructure.ConvertTimeToBeatUsingSegmentBinarySearch(time, truncTo0); }
+	inline f64 BeatAndTimeToHBScrollBeatTick(Beat beat, Time time) const { return AccelerationStructure.ConvertBeatAndTimeToHBScrollBeatTickUsingSegmentLookup(beat, time); }
 
 	struct ForEachBeatBarData { TimeSignature Signature; Beat Beat; i32 BarIndex; b8 IsBar; };
 	template <typename Func>
-	inline void ForEachBeatBar(Func perBeatBarFunc) const
+	inline void ForEachBeatBar(Func perBeatBarFunc) const { ForEachBeatBarFrom(Beat::Zero(), perBeatBarFunc); }
+
+	// NOTE: Same as ForEachBeatBar() but starting at the bar containing the given beat instead of always at the very first one
+	template <typename Func>
+	inline void ForEachBeatBarFrom(Beat startBeat, Func perBeatBarFunc) const
 	{
-		BeatSortedForwardIterator<TimeSignatureChange> signatureChangeIt {};
-		Beat beatIt = {};
+		const BarAtBeat startBar = FindBarAtBeat(startBeat);
+		BeatSortedForwardIterator<TimeSignatureChange> signatureChangeIt { startBar.SignatureIndex };
+		Beat beatIt = startBar.Beat;
 
-		for (i32 barIndex = 0; /*barIndex < MAX_BAR_COUNT*/; barIndex++)
+		for (i32 barIndex = startBar.BarIndex; /*barIndex < MAX_BAR_COUNT*/; barIndex++)
 		{
-			const TimeSignatureChange* thisChange = signatureChangeIt.Next(Signature.Sorted, beatIt);
-			TimeSignature thisSignature = (thisChange == nullptr) ? FallbackTimeSignature : thisChange->Signature;
-			b8 isSignatureNegative = (thisSignature.Numerator < 0) != (thisSignature.Denominator < 0);
-			thisSignature.Numerator = (isSignatureNegative ? -1 : 1) * ClampBot(abs(thisSignature.Numerator), 1);
-			thisSignature.Denominator = ClampBot(abs(thisSignature.Denominator), 1);
+			const TimeSignature thisSignature = GetSanitizedBarSignature(signatureChangeIt.Next(Signature.Sorted, beatIt));
 
 			const Beat durationPerBar = std::max(abs(thisSignature.GetDurationPerBar()), Beat::FromTicks(1));
 			if (auto flow = perBeatBarFunc(ForEachBeatBarData{ thisSignature, beatIt, barIndex, true }); flow == ControlFlow::Break) {
@@ -302,6 +352,21 @@ public:
 			beatIt += durationPerBar;
 		}
 	}
+
+	// NOTE: Time signature changes only take effect at the start of the next bar, so the bar containing a beat can't be calculated directly.
+	//		 Instead of walking every single bar this only steps from one signature change to the next, skipping over all whole bars in between
+	//		 The beat index is the number of bar and beat lines (of every bar being fully iterated) before the found bar
+	struct BarAtBeat { Beat Beat; i32 BarIndex; i32 BeatIndex; size_t SignatureIndex; };
+	BarAtBeat FindBarAtBeat(Beat beat) const;
+
+	static inline TimeSignature GetSanitizedBarSignature(const TimeSignatureChange* signatureChange)
+	{
+		TimeSignature signature = (signatureChange == nullptr) ? FallbackTimeSignature : signatureChange->Signature;
+		const b8 isSignatureNegative = (signature.Numerator < 0) != (signature.Denominator < 0);
+		signature.Numerator = (isSignatureNegative ? -1 : 1) * ClampBot(abs(signature.Numerator), 1);
+		signature.Denominator = ClampBot(abs(signature.Denominator), 1);
+		return signature;
+	}
 };
 
 template <typename T>
@@ -332,34 +397,32 @@ T* BeatSortedList<T>::TryFindExactAtBeat(Beat beat)
 	return const_cast<T*>(static_cast<const BeatSortedList<T>*>(this)->TryFindExactAtBeat(beat));
 }
 
+template <typename T>
+inline size_t BinarySearchForInsertionIndex(const BeatSortedList<T>& sortedList, Beat beat)
+{
+	// NOTE: Index of the first item at or after the given beat (equivalent to std::lower_bound)
+	return static_cast<size_t>(std::partition_point(sortedList.begin(), sortedList.end(), [beat](const T& v) { return GetBeat(v) < beat; }) - sortedList.begin());
+}
+
+template <typename T>
+inline size_t BinarySearchForIndexAfterBeat(const BeatSortedList<T>& sortedList, Beat beat)
+{
+	// NOTE: Index of the first item after the given beat (equivalent to std::upper_bound)
+	return static_cast<size_t>(std::partition_point(sortedList.begin(), sortedList.end(), [beat](const T& v) { return GetBeat(v) <= beat; }) - sortedList.begin());
+}
+
 template <typename T>
 const T* BeatSortedList<T>::TryFindLastAtBeat(Beat beat) const
 {
-	// TODO: Optimize using binary search
-	if (Sorted.size() == 0)
-		return nullptr;
-	if (Sorted.size() == 1)
-		return (GetBeat(Sorted[0]) <= beat) ? &Sorted[0] : nullptr;
-	if (beat < GetBeat(Sorted[0]))
-		return nullptr;
-	for (size_t i = 0; i < Sorted.size() - 1; i++)
-	{
-		if (GetBeat(Sorted[i]) <= beat && GetBeat(Sorted[i + 1]) > beat)
-			return &Sorted[i];
-	}
-	return &Sorted.back();
+	const size_t indexAfterBeat = BinarySearchForIndexAfterBeat(*this, beat);
+	return (indexAfterBeat > 0) ? &Sorted[indexAfterBeat - 1] : nullptr;
 }
 
 template <typename T>
 const T* BeatSortedList<T>::TryFindExactAtBeat(Beat beat) const
 {
-	// TODO: Optimize using binary search
-	for (const T& v : Sorted)
-	{
-		if (GetBeat(v) == beat)
-			return &v;
-	}
-	return nullptr;
+	const size_t index = BinarySearchForInsertionIndex(*this, beat);
+	return (InBounds(index, Sorted) && GetBeat(Sorted[index]) == beat) ? &Sorted[index] : nullptr;
 }
 
 template <typename T>
@@ -384,40 +447,51 @@ T* BeatSortedList<T>::TryFindOverlappingBeatUntrusted(Beat beatStart, Beat beatE
 template <typename T>
 const T* BeatSortedList<T>::TryFindOverlappingBeatUntrusted(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck) const
 {
-	// TODO: Optimize using binary search
-	const T* found = nullptr;
-	if (inclusiveBeatCheck)
+	// NOTE: An inverted range (only possible for untrusted inputs) stops at the first item ending in between the two beats
+	//		 which can't be expressed as a binary search, so just scan linearly for this rare case
+	if (beatEnd < beatStart)
 	{
+		const T* found = nullptr;
 		for (const T& v : Sorted)
 		{
-			// NOTE: Only break after a large beat has been found to correctly handle long notes with other notes "inside"
-			//		 (even if they should't be placable in the first place)
-			if (GetBeat(v) <= beatEnd && beatStart <= (GetBeat(v) + GetBeatDuration(v)))
+			if (inclusiveBeatCheck ? (GetBeat(v) <= beatEnd && beatStart <= (GetBeat(v) + GetBeatDuration(v))) : (GetBeat(v) < beatEnd && beatStart < (GetBeat(v) + GetBeatDuration(v))))
 				found = &v;
 			else if ((GetBeat(v) + GetBeatDuration(v)) > beatEnd)
 				break;
 		}
+		return found;
 	}
-	else
-	{
-		for (const T& v : Sorted)
-		{
-			if (GetBeat(v) < beatEnd && beatStart < (GetBeat(v) + GetBeatDuration(v)))
-				found = &v;
-			else if ((GetBeat(v) + GetBeatDuration(v)) > beatEnd)
-				break;
-		}
-	}
-	return found;
+
+	// NOTE: Only items starting before the end of the range can overlap it. Same as with FindOverlappingRange() the items not overlapping each other
+	//		 means the last of those also ends last, so it's the only one that has to be checked.
+	//		 Long notes with other notes "inside" (which should't be placable in the first place) require a BeatIntervalAccelerationStructure instead
+	const size_t endIndex = inclusiveBeatCheck ? BinarySearchForIndexAfterBeat(*this, beatEnd) : BinarySearchForInsertionIndex(*this, beatEnd);
+	if (endIndex == 0)
+		return nullptr;
+
+	const T& lastStartingItem = Sorted[endIndex - 1];
+	const Beat itemEnd = (GetBeat(lastStartingItem) + GetBeatDuration(lastStartingItem));
+	return (inclusiveBeatCheck ? (beatStart <= itemEnd) : (beatStart < itemEnd)) ? &lastStartingItem : nullptr;
 }
 
 template <typename T>
-inline size_t LinearlySearchForInsertionIndex(const BeatSortedList<T>& sortedList, Beat beat)
+BeatSortedListRange<typename BeatSortedList<T>::iterator> BeatSortedList<T>::FindOverlappingRange(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck)
 {
-	// TODO: Optimize using binary search
-	for (size_t i = 0; i < sortedList.size(); i++)
-		if (beat <= GetBeat(sortedList[i])) return i;
-	return sortedList.size();
+	const auto constRange = std::as_const(*this).FindOverlappingRange(beatStart, beatEnd, inclusiveBeatCheck);
+	return { Sorted.begin() + (constRange.First - Sorted.cbegin()), Sorted.begin() + (constRange.Last - Sorted.cbegin()) };
+}
+
+template <typename T>
+BeatSortedListRange<typename BeatSortedList<T>::const_iterator> BeatSortedList<T>::FindOverlappingRange(Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck) const
+{
+	assert(beatEnd >= beatStart && "Don't accidentally mix up BeatEnd with BeatDuration");
+	const auto last = Sorted.begin() + (inclusiveBeatCheck ? BinarySearchForIndexAfterBeat(*this, beatEnd) : BinarySearchForInsertionIndex(*this, beatEnd));
+	const auto first = std::partition_point(Sorted.begin(), last, [&](const T& v)
+	{
+		const Beat itemEnd = (GetBeat(v) + GetBeatDuration(v));
+		return inclusiveBeatCheck ? (itemEnd < beatStart) : (itemEnd <= beatStart);
+	});
+	return { first, last };
 }
 
 template <typename T>
@@ -429,7 +503,7 @@ inline b8 ValidateIsSortedByBeat(const BeatSortedList<T>& sortedList)
 template <typename T> template <typename Func>
 size_t BeatSortedList<T>::InsertOrFunc(const T& valueToInsert, Func funcExist)
 {
-	const size_t insertionIndex = LinearlySearchForInsertionIndex(*this, GetBeat(valueToInsert));
+	const size_t insertionIndex = BinarySearchForInsertionIndex(*this, GetBeat(valueToInsert));
 	if (InBounds(insertionIndex, Sorted))
 	{
 		if (T& existing = Sorted[insertionIndex]; GetBeat(existing) == GetBeat(valueToInsert))
@@ -476,3 +550,174 @@ void BeatSortedList<T>::RemoveAtIndex(size_t indexToRemove)
 	if (InBounds(indexToRemove, Sorted))
 		Sorted.erase(Sorted.begin() + indexToRemove);
 }
+
+template <typename T> template <typename Func>
+void BeatSortedList<T>::InsertOrFuncRange(std::vector<T> valuesToInsert, Func funcExist)
+{
+	if (valuesToInsert.empty())
+		return;
+
+	// NOTE: Stable so that values sharing the same beat are still passed to funcExist in their original order
+	std::stable_sort(valuesToInsert.begin(), valuesToInsert.end(), [](const T& a, const T& b) { return GetBeat(a) < GetBeat(b); });
+#if PEEPO_DEBUG
+	assert(GetBeat(valuesToInsert.front()).Ticks >= 0);
+#endif
+
+	std::vector<T> merged;
+	merged.reserve(Sorted.size() + valuesToInsert.size());
+
+	size_t existingIndex = 0;
+	for (size_t i = 0; i < valuesToInsert.size();)
+	{
+		const Beat beat = GetBeat(valuesToInsert[i]);
+		while (existingIndex < Sorted.size() && GetBeat(Sorted[existingIndex]) < beat)
+			merged.push_back(std::move(Sorted[existingIndex++]));
+
+		if (existingIndex < Sorted.size() && GetBeat(Sorted[existingIndex]) == beat)
+			merged.push_back(std::move(Sorted[existingIndex++]));
+		else
+			merged.push_back(std::move(valuesToInsert[i++]));
+
+		for (; i < valuesToInsert.size() && GetBeat(valuesToInsert[i]) == beat; i++)
+			funcExist(merged.back(), std::as_const(valuesToInsert[i]));
+	}
+	std::move(Sorted.begin() + existingIndex, Sorted.end(), std::back_inserter(merged));
+	Sorted = std::move(merged);
+
+#if PEEPO_DEBUG
+	assert(ValidateIsSortedByBeat(*this));
+#endif
+}
+
+template <typename T>
+void BeatSortedList<T>::InsertOrUpdateRange(std::vector<T> valuesToInsertOrUpdate)
+{
+	InsertOrFuncRange(std::move(valuesToInsertOrUpdate), [&](T& existing, const T& valueToInsertOrUpdate) { existing = valueToInsertOrUpdate; });
+}
+
+template <typename T> template <typename TRange>
+void BeatSortedList<T>::RemoveRange(const TRange& valuesToFindAndRemove)
+{
+	std::vector<Beat> beatsToRemove;
+	beatsToRemove.reserve(std::size(valuesToFindAndRemove));
+	for (const auto& value : valuesToFindAndRemove)
+		beatsToRemove.push_back(GetBeat(value));
+	std::sort(beatsToRemove.begin(), beatsToRemove.end());
+
+	// NOTE: Each beat removes (at most) one item, so that duplicate beats within the list are handled the same way as by RemoveAtBeat()
+	size_t beatIndex = 0;
+	auto isToBeRemoved = [&](const T& v)
+	{
+		const Beat beat = GetBeat(v);
+		while (beatIndex < beatsToRemove.size() && beatsToRemove[beatIndex] < beat)
+			beatIndex++;
+		if (beatIndex < beatsToRemove.size() && beatsToRemove[beatIndex] == beat) { beatIndex++; return true; }
+		return false;
+	};
+	Sorted.erase(std::remove_if(Sorted.begin(), Sorted.end(), isToBeRemoved), Sorted.end());
+}
+
+// NOTE: Implicit segment tree storing the max end beat of each subtree of items, for answering overlap queries in O(log n)
+//		 (or O(log n + k) for all k overlapping items) which a binary search by start beat alone can't do once items have varying durations.
+//		 Like the TempoMapAccelerationStructure it must manually be rebuilt after the list has been edited, so it's meant to be built right before a batch of queries
+struct BeatIntervalAccelerationStructure
+{
+	static constexpr size_t NotFound = static_cast<size_t>(-1);
+
+	size_t ItemCount = 0;
+	size_t LeafCount = 0;
+	// NOTE: Node i has the children (i * 2) and (i * 2 + 1) with the leaves starting at LeafCount, node 0 is unused
+	std::vector<i32> SubtreeMaxEndTicks;
+
+	template <typename T> void Rebuild(const BeatSortedList<T>& sortedList);
+
+	// NOTE: Same results as BeatSortedList::TryFindOverlappingBeatUntrusted() for the list the structure has last been rebuilt from,
+	//		 except that items nested inside of long items are also handled (returning the last starting item that hasn't ended yet)
+	template <typename T> T* TryFindOverlappingBeat(BeatSortedList<T>& sortedList, Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck = true) const;
+	template <typename T> const T* TryFindOverlappingBeat(const BeatSortedList<T>& sortedList, Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck = true) const;
+	// NOTE: Calls the func for every item overlapping the range in sorted order, including those nested inside of other long items
+	template <typename T, typename Func> void ForEachOverlappingBeat(const BeatSortedList<T>& sortedList, Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck, Func perItemFunc) const;
+
+private:
+	template <typename T> size_t GetOverlapSearchEndIndex(const BeatSortedList<T>& sortedList, Beat beatEnd, b8 inclusiveBeatCheck) const;
+	// NOTE: Index of the last item within [0, endIndex) ending at or after the given tick, or NotFound
+	size_t FindLastIndexEndingAtOrAfter(size_t node, size_t nodeBegin, size_t nodeEnd, size_t endIndex, i32 minEndTick) const;
+	template <typename Func> void ForEachIndexEndingAtOrAfter(size_t node, size_t nodeBegin, size_t nodeEnd, size_t endIndex, i32 minEndTick, Func& perIndexFunc) const;
+};
+
+template <typename T>
+void BeatIntervalAccelerationStructure::Rebuild(const BeatSortedList<T>& sortedList)
+{
+	ItemCount = sortedList.size();
+	LeafCount = 1;
+	while (LeafCount < ItemCount)
+		LeafCount *= 2;
+
+	SubtreeMaxEndTicks.resize(LeafCount * 2);
+	for (size_t i = 0; i < LeafCount; i++)
+		SubtreeMaxEndTicks[LeafCount + i] = (i < ItemCount) ? (GetBeat(sortedList[i]) + GetBeatDuration(sortedList[i])).Ticks : I32Min;
+	for (size_t node = LeafCount - 1; node > 0; node--)
+		SubtreeMaxEndTicks[node] = Max(SubtreeMaxEndTicks[node * 2], SubtreeMaxEndTicks[(node * 2) + 1]);
+}
+
+template <typename T>
+T* BeatIntervalAccelerationStructure::TryFindOverlappingBeat(BeatSortedList<T>& sortedList, Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck) const
+{
+	return const_cast<T*>(TryFindOverlappingBeat(std::as_const(sortedList), beatStart, beatEnd, inclusiveBeatCheck));
+}
+
+template <typename T>
+const T* BeatIntervalAccelerationStructure::TryFindOverlappingBeat(const BeatSortedList<T>& sortedList, Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck) const
+{
+	assert(sortedList.size() == ItemCount && "Acceleration structure hasn't been rebuilt after editing the list (?)");
+	if (beatEnd < beatStart)
+		return sortedList.TryFindOverlappingBeatUntrusted(beatStart, beatEnd, inclusiveBeatCheck);
+
+	const i32 minEndTick = inclusiveBeatCheck ? beatStart.Ticks : (beatStart.Ticks + 1);
+	const size_t index = FindLastIndexEndingAtOrAfter(1, 0, LeafCount, GetOverlapSearchEndIndex(sortedList, beatEnd, inclusiveBeatCheck), minEndTick);
+	return (index != NotFound) ? &sortedList[index] : nullptr;
+}
+
+template <typename T, typename Func>
+void BeatIntervalAccelerationStructure::ForEachOverlappingBeat(const BeatSortedList<T>& sortedList, Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck, Func perItemFunc) const
+{
+	assert(sortedList.size() == ItemCount && "Acceleration structure hasn't been rebuilt after editing the list (?)");
+	assert(beatEnd >= beatStart && "Don't accidentally mix up BeatEnd with BeatDuration");
+
+	const i32 minEndTick = inclusiveBeatCheck ? beatStart.Ticks : (beatStart.Ticks + 1);
+	auto perIndexFunc = [&](size_t index) { perItemFunc(sortedList[index]); };
+	ForEachIndexEndingAtOrAfter(1, 0, LeafCount, GetOverlapSearchEndIndex(sortedList, beatEnd, inclusiveBeatCheck), minEndTick, perIndexFunc);
+}
+
+template <typename T>
+size_t BeatIntervalAccelerationStructure::GetOverlapSearchEndIndex(const BeatSortedList<T>& sortedList, Beat beatEnd, b8 inclusiveBeatCheck) const
+{
+	// NOTE: Only items starting before the end of the range can overlap it, out of which the tree then finds the ones that haven't ended yet
+	return inclusiveBeatCheck ? BinarySearchForIndexAfterBeat(sortedList, beatEnd) : BinarySearchForInsertionIndex(sortedList, beatEnd);
+}
+
+inline size_t BeatIntervalAccelerationStructure::FindLastIndexEndingAtOrAfter(size_t node, size_t nodeBegin, size_t nodeEnd, size_t endIndex, i32 minEndTick) const
+{
+	if (ItemCount == 0 || nodeBegin >= endIndex || SubtreeMaxEndTicks[node] < minEndTick)
+		return NotFound;
+	if (node >= LeafCount)
+		return nodeBegin;
+
+	const size_t nodeMid = (nodeBegin + nodeEnd) / 2;
+	if (const size_t index = FindLastIndexEndingAtOrAfter((node * 2) + 1, nodeMid, nodeEnd, endIndex, minEndTick); index != NotFound)
+		return index;
+	return FindLastIndexEndingAtOrAfter(node * 2, nodeBegin, nodeMid, endIndex, minEndTick);
+}
+
+template <typename Func>
+void BeatIntervalAccelerationStructure::ForEachIndexEndingAtOrAfter(size_t node, size_t nodeBegin, size_t nodeEnd, size_t endIndex, i32 minEndTick, Func& perIndexFunc) const
+{
+	if (ItemCount == 0 || nodeBegin >= endIndex || SubtreeMaxEndTicks[node] < minEndTick)
+		return;
+	if (node >= LeafCount)
+		return perIndexFunc(nodeBegin);
+
+	const size_t nodeMid = (nodeBegin + nodeEnd) / 2;
+	ForEachIndexEndingAtOrAfter(node * 2, nodeBegin, nodeMid, endIndex, minEndTick, perIndexFunc);
+	ForEachIndexEndingAtOrAfter((node * 2) + 1, nodeMid, nodeEnd, endIndex, minEndTick, perIndexFunc);
+}
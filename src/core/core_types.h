@@ -406,7 +406,7 @@ struct Complex {
 	explicit constexpr Complex(f32 scalar) : cpx(scalar) {}
 	constexpr Complex(f32 x, f32 y) : cpx(x, y) {}
 	constexpr Complex(std::complex<f32> cpx) : cpx(cpx) {}
-	constexpr Complex(const Complex& other) : cpx(other.cpx) {}
+	constexpr Complex(const Complex& other) = default;
 	Complex(const std::string& s) { std::istringstream iss(s); iss >> *this; }
 	std::string toString() const {
 		std::ostringstream oss;
@@ -52,6 +52,9 @@ namespace Undo
 		std::vector<std::unique_ptr<Command>> CommandsToExecutedAtEndOfFrame;
 		b8 HasPendingChanges = false;
 		i32 NumberOfChangesMade = 0;
+		// NOTE: Unlike NumberOfChangesMade this is never reset and also incremented for every undo / redo,
+		//		 so that anything derived from the edited data can be cached and only rebuilt once it doesn't match anymore
+		u64 ChangeGeneration = 0;
 
 		i32 NumberOfCommandsToDisallowMergesFor = 0;
 		Time CommandMergeTimeThreshold = Time::FromSec(2.0);
@@ -2,6 +2,7 @@
 #include <algorithm>
 #include <array>
 #include <numeric>
+#include <charconv>
 
 namespace TJA
 {
@@ -92,49 +93,110 @@ namespace TJA
 
 	static_assert(ArrayCount(KeyStrings) == EnumCount<Key>);
 
-	static const std::regex PatTJAHeader = std::regex("^\\.?[A-Z][A-Z0-9_]*$");
-	static const std::regex PatTJACommand = std::regex("^[A-Z]+$");
+	// NOTE: Equivalent to matching "^\.?[A-Z][A-Z0-9_]*$"
+	static constexpr b8 IsValidHeaderKeyString(std::string_view str)
+	{
+		if (ASCII::StartsWith(str, '.'))
+			str = str.substr(sizeof('.'));
+		if (str.empty() || !ASCII::IsUpperCase(str[0]))
+			return false;
+		for (const char c : str.substr(1))
+		{
+			if (!ASCII::IsUpperCase(c) && !(c >= '0' && c <= '9') && c != '_')
+				return false;
+		}
+		return true;
+	}
 
-	static bool MatchKeyString(Key key, std::string_view str)
+	// NOTE: Equivalent to matching "^[A-Z]+$"
+	static constexpr b8 IsValidCommandKeyString(std::string_view str)
 	{
-		switch (key) {
-		case Key::Main_Invalid:
-		case Key::Course_Invalid:
-			return !std::regex_match(begin(str), end(str), PatTJAHeader);
-		case Key::Chart_Invalid:
-			return !std::regex_match(begin(str), end(str), PatTJACommand);
-
-		case Key::Main_TITLE_localized:
-		case Key::Main_SUBTITLE_localized:
-		case Key::Course_NOTESDESIGNERs:
-		case Key::Course_EXAMs:
-			return ASCII::StartsWith(str, KeyStrings[EnumToIndex(key)]);
-
-		case Key::Unknown:
-		case Key::Course_Unknown: // ambiguous between Main and Course scope, reassigned later
-		case Key::Chart_Unknown:
-			return true;
-
-		case Key::Main_Unknown:
-			return false; // ambiguous between Main and Course scope, assigned separately
-
-		default:
-			return (str == KeyStrings[EnumToIndex(key)]);
+		if (str.empty())
+			return false;
+		for (const char c : str)
+		{
+			if (!ASCII::IsUpperCase(c))
+				return false;
 		}
+		return true;
 	}
 
+	// NOTE: Collision-free hash table of all (non-empty, first occurrence) key strings within [First, Last], using a hash seed searched for at compile time.
+	//		 Resolving a key is then a single hash and string compare instead of comparing against every key string in enum order
+	template <Key First, Key Last>
+	struct KeyStringPerfectHashTable
+	{
+		static constexpr u32 SlotCount = 512;
+		static constexpr u32 MaxSeedAttempts = 256;
+
+		u32 Seed = 0;
+		std::array<Key, SlotCount> Slots = {};
+
+		static constexpr u32 Hash(std::string_view str, u32 seed)
+		{
+			u32 hash = (2166136261u ^ (seed * 0x9E3779B9u));
+			for (const char c : str)
+				hash = ((hash ^ static_cast<u8>(c)) * 16777619u);
+			return (hash ^ (hash >> 16)) & (SlotCount - 1);
+		}
+
+		static constexpr KeyStringPerfectHashTable Build()
+		{
+			for (u32 seed = 0; seed < MaxSeedAttempts; seed++)
+			{
+				KeyStringPerfectHashTable table {};
+				table.Seed = seed;
+				table.Slots.fill(Key::Unknown);
+
+				b8 anyCollision = false;
+				for (Key key = First; key <= Last && !anyCollision; IncrementEnum(key))
+				{
+					const std::string_view str = KeyStrings[EnumToIndex(key)];
+					Key& slot = table.Slots[Hash(str, seed)];
+					if (str.empty() || (slot != Key::Unknown && KeyStrings[EnumToIndex(slot)] == str))
+						continue;
+					anyCollision = (slot != Key::Unknown);
+					slot = key;
+				}
+
+				if (!anyCollision)
+					return table;
+			}
+			return KeyStringPerfectHashTable { MaxSeedAttempts };
+		}
+
+		constexpr Key Find(std::string_view str) const
+		{
+			const Key key = Slots[Hash(str, Seed)];
+			return (key != Key::Unknown && KeyStrings[EnumToIndex(key)] == str) ? key : Key::Unknown;
+		}
+	};
+
+	static constexpr auto KeyColonValueKeyTable = KeyStringPerfectHashTable<Key::KeyColonValue_First, Key::KeyColonValue_Last>::Build();
+	static constexpr auto HashCommandKeyTable = KeyStringPerfectHashTable<Key::HashCommand_First, Key::HashCommand_Last>::Build();
+	static_assert(KeyColonValueKeyTable.Seed < KeyColonValueKeyTable.MaxSeedAttempts && HashCommandKeyTable.Seed < HashCommandKeyTable.MaxSeedAttempts);
+
+	// NOTE: Only checked if there isn't an exact match. None of the exact keys after these in enum order start with any of the prefixes
+	static constexpr Key KeyColonValuePrefixKeys[] = { Key::Main_TITLE_localized, Key::Main_SUBTITLE_localized, Key::Course_NOTESDESIGNERs, Key::Course_EXAMs, };
+
 	Key GetKeyColonValueTokenKey(std::string_view str)
 	{
-		for (Key i = Key::KeyColonValue_First; i <= Key::KeyColonValue_Last; IncrementEnum(i))
-			if (MatchKeyString(i, str)) { return i; }
-		return Key::Course_Unknown; // already matched; should never be reached
+		if (!IsValidHeaderKeyString(str))
+			return Key::Main_Invalid;
+		if (const Key key = KeyColonValueKeyTable.Find(str); key != Key::Unknown)
+			return key;
+		for (const Key prefixKey : KeyColonValuePrefixKeys)
+			if (ASCII::StartsWith(str, KeyStrings[EnumToIndex(prefixKey)])) { return prefixKey; }
+		return Key::Course_Unknown; // ambiguous between Main and Course scope, reassigned later
 	}
 
 	Key GetHashCommandTokenKey(std::string_view str)
 	{
-		for (Key i = Key::HashCommand_First; i <= Key::HashCommand_Last; IncrementEnum(i))
-			if (MatchKeyString(i, str)) { return i; }
-		return Key::Chart_Unknown; // already matched; should never be reached
+		if (!IsValidCommandKeyString(str))
+			return Key::Chart_Invalid;
+		if (const Key key = HashCommandKeyTable.Find(str); key != Key::Unknown)
+			return key;
+		return Key::Chart_Unknown;
 	}
 
 	struct LinePrefixCommentSuffixSplit { std::string_view LinePrefix, CommentSuffix; };
@@ -182,7 +244,7 @@ namespace TJA
 			{
 				Token& newToken = outTokens.emplace_back();
 				newToken.Type = TokenType::EmptyLine;
-				newToken.LineIndex = static_cast<i16>(lineIndex);
+				newToken.LineIndex = static_cast<i32>(lineIndex);
 				newToken.Line = lineTrimmed;
 			}
 			else
@@ -195,7 +257,7 @@ namespace TJA
 				{
 					Token& newToken = outTokens.emplace_back();
 					newToken.Type = TokenType::Unknown;
-					newToken.LineIndex = static_cast<i16>(lineIndex);
+					newToken.LineIndex = static_cast<i32>(lineIndex);
 					newToken.Line = lineTrimmed;
 
 					if (lineTrimmed[0] == '#')
@@ -249,7 +311,7 @@ namespace TJA
 				{
 					Token& newCommentToken = outTokens.emplace_back();
 					newCommentToken.Type = TokenType::Comment;
-					newCommentToken.LineIndex = static_cast<i16>(lineIndex);
+					newCommentToken.LineIndex = static_cast<i32>(lineIndex);
 					newCommentToken.Line = lineTrimmed;
 					newCommentToken.ValueString = ASCII::Trim(lineCommentSplit.CommentSuffix.substr(sizeof('/') * 2));
 				}
@@ -258,7 +320,7 @@ namespace TJA
 
 		// end-of-file token as implicit `#END`
 		if (!lines.empty())
-			outTokens.push_back({ TokenType::HashChartCommand, Key::Chart_END, static_cast<i16>(size(lines) - 1) });
+			outTokens.push_back({ TokenType::HashChartCommand, Key::Chart_END, static_cast<i32>(size(lines) - 1) });
 
 		return outTokens;
 	}
@@ -494,7 +556,7 @@ namespace TJA
 
 		for (const Token& token : tokens)
 		{
-			const i16 lineIndex = token.LineIndex;
+			const i32 lineIndex = token.LineIndex;
 			switch (token.Type)
 			{
 			case TokenType::Unknown:
@@ -846,7 +908,7 @@ namespace TJA
 						pushChartCommand(ParsedChartCommandType::BranchEnd);
 					} break;
 					case Key::Chart_SECTION: { pushChartCommand(ParsedChartCommandType::ResetAccuracyValues); } break;
-					case Key::Chart_LYRIC: { pushChartCommand(ParsedChartCommandType::SetLyricLine).Param.SetLyricLine.Value = in; } break;
+					case Key::Chart_LYRIC: { pushChartCommand(ParsedChartCommandType::SetLyricLine).Param.SetLyricLine.Value = outTJA.Arena.PushString(in); } break;
 					case Key::Chart_LEVELHOLD: { pushChartCommand(ParsedChartCommandType::BranchLevelHold); } break;
 					case Key::Chart_BMSCROLL: { pushChartCommand(ParsedChartCommandType::BMScroll); } break;
 					case Key::Chart_HBSCROLL: { pushChartCommand(ParsedChartCommandType::HBScroll); } break;
@@ -857,7 +919,7 @@ namespace TJA
 						else
 							pushChartCommand(ParsedChartCommandType::SENoteChange).Param.SENoteChange.Type = v;
 						break;
-					case Key::Chart_NEXTSONG: { pushChartCommand(ParsedChartCommandType::SetNextSong).Param.SetNextSong.CommaSeparatedList = in; } break;
+					case Key::Chart_NEXTSONG: { pushChartCommand(ParsedChartCommandType::SetNextSong).Param.SetNextSong.CommaSeparatedList = outTJA.Arena.PushString(in); } break;
 					case Key::Chart_DIRECTION: 
 					{
 						f32 scrollspeed = cachedScrollSpeed.GetRealPart();
@@ -995,7 +1057,6 @@ namespace TJA
 					currentlyInBetweenMeasure = true;
 
 					ParsedChartCommand& newCommand = pushChartCommand(ParsedChartCommandType::MeasureNotes);
-					newCommand.Param.MeasureNotes.Notes.reserve(token.ValueString.size());
 					for (const char& c : token.ValueString)
 					{
 						if (c == ',')
@@ -1021,7 +1082,7 @@ namespace TJA
 							if (!tryParseNoteTypeChar(c, &parsedNoteTypeOrNone))
 								outErrors.Push(lineIndex, "Unknown note type '%c'", c);
 
-							newCommand.Param.MeasureNotes.Notes.push_back(parsedNoteTypeOrNone);
+							outTJA.Arena.PushNote(newCommand.Param.MeasureNotes.Notes, parsedNoteTypeOrNone);
 							currentMeasureNoteCount++;
 						}
 					}
@@ -1050,10 +1111,57 @@ namespace TJA
 	static const ParsedMainMetadata DefaultMainMetadata = {};
 	static const ParsedCourseMetadata DefaultCourseMetadata = {};
 
+	// NOTE: Decimal values are always parsed as f32 (see tryParseTime, tryParseTempo etc.) so they're written as the shortest f32 representation,
+	//		 which unlike "%g" (only 6 significant digits) is guaranteed to parse back to the exact same value
+	struct ShortestNumberFormatter
+	{
+		char Buffer[128];
+		char* End = Buffer;
+
+		inline ShortestNumberFormatter& F32(f32 value) { End = std::to_chars(End, std::end(Buffer), value).ptr; return *this; }
+		inline ShortestNumberFormatter& I32(i32 value) { End = std::to_chars(End, std::end(Buffer), value).ptr; return *this; }
+		inline ShortestNumberFormatter& Char(char value) { *End++ = value; return *this; }
+		inline ShortestNumberFormatter& Sec(Time value) { return F32(static_cast<f32>(value.Seconds)); }
+
+		// NOTE: Same format as Complex::toStringCompat(), so "a" for real values or "a+bi" otherwise
+		inline ShortestNumberFormatter& CPX(const Complex& value)
+		{
+			F32(value.GetRealPart());
+			if (value.GetImaginaryPart() != 0.0f)
+			{
+				if (value.GetImaginaryPart() > 0.0f)
+					Char('+');
+				F32(value.GetImaginaryPart()).Char('i');
+			}
+			return *this;
+		}
+
+		// NOTE: Percentages are stored as (percent * 0.01f) which doesn't always map back exactly, so check the neighboring f32s for one that does
+		inline ShortestNumberFormatter& Percent(f32 value)
+		{
+			f32 percent = ToPercent(value);
+			f32 percentDown = percent, percentUp = percent;
+			for (i32 i = 0; i < 4 && FromPercent(percent) != value; i++)
+			{
+				percentDown = std::nextafter(percentDown, -F32Max);
+				percentUp = std::nextafter(percentUp, F32Max);
+				if (FromPercent(percentDown) == value) { percent = percentDown; }
+				else if (FromPercent(percentUp) == value) { percent = percentUp; }
+			}
+			return F32(percent);
+		}
+
+		inline std::string_view View() const { return std::string_view(Buffer, static_cast<size_t>(End - Buffer)); }
+	};
+
 	void ConvertParsedToText(const ParsedTJA& inContent, std::string& out, Encoding encoding)
 	{
 		// TODO: ... or maybe tokenize first instead of going right to text..?
-		out.reserve(out.size() + 0x4000);
+		// NOTE: Estimate the final size upfront, with every note being a single char and every other command a short line
+		size_t estimatedOutputSize = 0x1000 + inContent.Arena.Notes.size() + inContent.Arena.Strings.size();
+		for (const ParsedCourse& course : inContent.Courses)
+			estimatedOutputSize += (course.ChartCommands.size() * 16);
+		out.reserve(out.size() + estimatedOutputSize);
 		if (encoding == Encoding::UTF8)
 			out += std::string_view(UTF8::BOM_UTF8, sizeof(UTF8::BOM_UTF8));
 
@@ -1066,11 +1174,9 @@ namespace TJA
 		{
 			out += KeyStrings[EnumToIndex(key)];
 			out += ':';
-			char buffer[16];
-			for (size_t i = 0; i < popCounts.size(); i++) { if (i != 0) { out += ','; } out += std::string_view(buffer, sprintf_s(buffer, "%d", popCounts[i])); }
+			for (size_t i = 0; i < popCounts.size(); i++) { if (i != 0) { out += ','; } out += ShortestNumberFormatter().I32(popCounts[i]).View(); }
 			out += '\n';
 		};
-		char buffer[512];
 
 		static constexpr auto noteTypeToChar = [](NoteType in) -> char
 		{
@@ -1160,37 +1266,37 @@ namespace TJA
 			for (const auto& [locale, val] : inContent.Metadata.SUBTITLE_localized)
 				appendSuffixedPropertyLine(out, Key::Main_SUBTITLE_localized, locale, val);
 		}
-		appendProperyLine(out, Key::Main_BPM, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.BPM.BPM))); // Better to be explicit
+		appendProperyLine(out, Key::Main_BPM, ShortestNumberFormatter().F32(inContent.Metadata.BPM.BPM).View()); // Better to be explicit
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::WAVE))
 			appendProperyLine(out, Key::Main_WAVE, inContent.Metadata.WAVE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::PREIMAGE))
 			appendProperyLine(out, Key::Main_PREIMAGE, inContent.Metadata.PREIMAGE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::WAVE, &ParsedMainMetadata::OFFSET)) // Better to be explicit if `WAVE:` is given
-			appendProperyLine(out, Key::Main_OFFSET, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.OFFSET.Seconds)));
+			appendProperyLine(out, Key::Main_OFFSET, ShortestNumberFormatter().Sec(inContent.Metadata.OFFSET).View());
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::DEMOSTART))
-			appendProperyLine(out, Key::Main_DEMOSTART, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.DEMOSTART.Seconds)));
+			appendProperyLine(out, Key::Main_DEMOSTART, ShortestNumberFormatter().Sec(inContent.Metadata.DEMOSTART).View());
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::GENRE))
 			appendProperyLine(out, Key::Main_GENRE, inContent.Metadata.GENRE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::SCOREMODE))
-			appendProperyLine(out, Key::Main_SCOREMODE, std::string_view(buffer, sprintf_s(buffer, "%d", static_cast<i32>(inContent.Metadata.SCOREMODE))));
+			appendProperyLine(out, Key::Main_SCOREMODE, ShortestNumberFormatter().I32(static_cast<i32>(inContent.Metadata.SCOREMODE)).View());
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::MAKER))
 			appendProperyLine(out, Key::Main_MAKER, inContent.Metadata.MAKER);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::LYRICS))
 			appendProperyLine(out, Key::Main_LYRICS, inContent.Metadata.LYRICS);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::SONGVOL))
-			appendProperyLine(out, Key::Main_SONGVOL, std::string_view(buffer, sprintf_s(buffer, "%g", ToPercent(inContent.Metadata.SONGVOL))));
+			appendProperyLine(out, Key::Main_SONGVOL, ShortestNumberFormatter().Percent(inContent.Metadata.SONGVOL).View());
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::SEVOL))
-			appendProperyLine(out, Key::Main_SEVOL, std::string_view(buffer, sprintf_s(buffer, "%g", ToPercent(inContent.Metadata.SEVOL))));
+			appendProperyLine(out, Key::Main_SEVOL, ShortestNumberFormatter().Percent(inContent.Metadata.SEVOL).View());
 		// TODO: Key::Main_SIDE;
 		// TODO: Key::Main_GAME;
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::HEADSCROLL))
-			appendProperyLine(out, Key::Main_HEADSCROLL, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.HEADSCROLL)));
+			appendProperyLine(out, Key::Main_HEADSCROLL, ShortestNumberFormatter().F32(inContent.Metadata.HEADSCROLL).View());
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::BGIMAGE))
 			appendProperyLine(out, Key::Main_BGIMAGE, inContent.Metadata.BGIMAGE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::BGMOVIE))
 			appendProperyLine(out, Key::Main_BGMOVIE, inContent.Metadata.BGMOVIE);
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::BGIMAGE, &ParsedMainMetadata::BGMOVIE, &ParsedMainMetadata::MOVIEOFFSET)) // Better to be explicit if bg is given
-			appendProperyLine(out, Key::Main_MOVIEOFFSET, std::string_view(buffer, sprintf_s(buffer, "%g", inContent.Metadata.MOVIEOFFSET.Seconds)));
+			appendProperyLine(out, Key::Main_MOVIEOFFSET, ShortestNumberFormatter().Sec(inContent.Metadata.MOVIEOFFSET).View());
 
 		if (shouldEmitMainMetadata(&ParsedMainMetadata::Others)) {
 			for (const auto& [header, val] : inContent.Metadata.Others)
@@ -1257,14 +1363,14 @@ namespace TJA
 			// Unspecified default value
 			if (firstInGroup || shouldEmitCourseMetadata(&ParsedCourseMetadata::LEVEL, &ParsedCourseMetadata::LEVEL_DECIMALTAG)) {
 				if (course.Metadata.LEVEL_DECIMALTAG == -1)
-					appendProperyLine(out, Key::Course_LEVEL, std::string_view(buffer, sprintf_s(buffer, "%d", course.Metadata.LEVEL)));
+					appendProperyLine(out, Key::Course_LEVEL, ShortestNumberFormatter().I32(course.Metadata.LEVEL).View());
 				else
-					appendProperyLine(out, Key::Course_LEVEL, std::string_view(buffer, sprintf_s(buffer, "%.1f", course.Metadata.LEVEL + static_cast<float>(course.Metadata.LEVEL_DECIMALTAG) / 10.)));
+					appendProperyLine(out, Key::Course_LEVEL, ShortestNumberFormatter().I32(course.Metadata.LEVEL).Char('.').I32(course.Metadata.LEVEL_DECIMALTAG).View());
 			}
 
 			// Better to be explicit
 			if (course.Metadata.COURSE == DifficultyType::Tower) {
-				appendProperyLine(out, Key::Course_LIFE, std::string_view(buffer, sprintf_s(buffer, "%d", course.Metadata.LIFE)));
+				appendProperyLine(out, Key::Course_LIFE, ShortestNumberFormatter().I32(course.Metadata.LIFE).View());
 				appendProperyLine(out, Key::Course_SIDE, sideToString(course.Metadata.SIDE));
 			}
 
@@ -1279,8 +1385,8 @@ namespace TJA
 			}
 
 			if (shouldEmitCourseMetadata(&ParsedCourseMetadata::SCOREINIT, &ParsedCourseMetadata::SCOREDIFF)) {
-				appendProperyLine(out, Key::Course_SCOREINIT, (course.Metadata.SCOREINIT == 0) ? "" : std::string_view(buffer, sprintf_s(buffer, "%d", course.Metadata.SCOREINIT)));
-				appendProperyLine(out, Key::Course_SCOREDIFF, (course.Metadata.SCOREDIFF == 0) ? "" : std::string_view(buffer, sprintf_s(buffer, "%d", course.Metadata.SCOREDIFF)));
+				appendProperyLine(out, Key::Course_SCOREINIT, (course.Metadata.SCOREINIT == 0) ? "" : ShortestNumberFormatter().I32(course.Metadata.SCOREINIT).View());
+				appendProperyLine(out, Key::Course_SCOREDIFF, (course.Metadata.SCOREDIFF == 0) ? "" : ShortestNumberFormatter().I32(course.Metadata.SCOREDIFF).View());
 			}
 
 			if (shouldEmitCourseMetadata(&ParsedCourseMetadata::NOTESDESIGNER))
@@ -1311,8 +1417,11 @@ namespace TJA
 				{
 				case ParsedChartCommandType::MeasureNotes:
 				{
-					for (const NoteType note : command.Param.MeasureNotes.Notes)
-						out += noteTypeToChar(note);
+					const std::span<const NoteType> notes = inContent.Arena.GetNotes(command.Param.MeasureNotes.Notes);
+					const size_t notesOutIndex = out.size();
+					out.resize(notesOutIndex + notes.size());
+					for (size_t i = 0; i < notes.size(); i++)
+						out[notesOutIndex + i] = noteTypeToChar(notes[i]);
 
 					if (ArrayItToIndex(&command, &course.ChartCommands[0]) + 1 < course.ChartCommands.size())
 					{
@@ -1323,19 +1432,19 @@ namespace TJA
 				case ParsedChartCommandType::MeasureEnd: { appendLine(out, ","); } break;
 				case ParsedChartCommandType::ChangeTimeSignature:
 				{
-					appendCommandLine(out, Key::Chart_MEASURE, std::string_view(buffer, sprintf_s(buffer, "%d/%d", command.Param.ChangeTimeSignature.Value.Numerator, command.Param.ChangeTimeSignature.Value.Denominator)));
+					appendCommandLine(out, Key::Chart_MEASURE, ShortestNumberFormatter().I32(command.Param.ChangeTimeSignature.Value.Numerator).Char('/').I32(command.Param.ChangeTimeSignature.Value.Denominator).View());
 				} break;
 				case ParsedChartCommandType::ChangeTempo:
 				{
-					appendCommandLine(out, Key::Chart_BPMCHANGE, std::string_view(buffer, sprintf_s(buffer, "%g", command.Param.ChangeTempo.Value.BPM)));
+					appendCommandLine(out, Key::Chart_BPMCHANGE, ShortestNumberFormatter().F32(command.Param.ChangeTempo.Value.BPM).View());
 				} break;
 				case ParsedChartCommandType::ChangeDelay:
 				{
-					appendCommandLine(out, Key::Chart_DELAY, std::string_view(buffer, sprintf_s(buffer, "%g", command.Param.ChangeDelay.Value.ToSec())));
+					appendCommandLine(out, Key::Chart_DELAY, ShortestNumberFormatter().Sec(command.Param.ChangeDelay.Value).View());
 				} break;
 				case ParsedChartCommandType::ChangeScrollSpeed:
 				{
-					appendCommandLine(out, Key::Chart_SCROLL, std::string_view(buffer, sprintf_s(buffer, "%s", command.Param.ChangeScrollSpeed.Value.toStringCompat().c_str())));
+					appendCommandLine(out, Key::Chart_SCROLL, ShortestNumberFormatter().CPX(command.Param.ChangeScrollSpeed.Value).View());
 				} break;
 				case ParsedChartCommandType::ChangeBarLine:
 				{
@@ -1351,7 +1460,7 @@ namespace TJA
 				} break;
 				case ParsedChartCommandType::BranchStart:
 				{
-					appendCommandLine(out, Key::Chart_BRANCHSTART, std::string_view(buffer, sprintf_s(buffer, "%c,%d,%d", BranchConditionToChar(command.Param.BranchStart.Condition), command.Param.BranchStart.RequirementExpert, command.Param.BranchStart.RequirementMaster)));
+					appendCommandLine(out, Key::Chart_BRANCHSTART, ShortestNumberFormatter().Char(BranchConditionToChar(command.Param.BranchStart.Condition)).Char(',').I32(command.Param.BranchStart.RequirementExpert).Char(',').I32(command.Param.BranchStart.RequirementMaster).View());
 				} break;
 				case ParsedChartCommandType::BranchNormal:
 				{
@@ -1380,7 +1489,7 @@ namespace TJA
 				case ParsedChartCommandType::SetLyricLine:
 				{
 					// TODO: Handle escape characters, most importantly "\n"
-					appendCommandLine(out, Key::Chart_LYRIC, command.Param.SetLyricLine.Value);
+					appendCommandLine(out, Key::Chart_LYRIC, inContent.Arena.GetString(command.Param.SetLyricLine.Value));
 				} break;
 				case ParsedChartCommandType::NMScroll:
 				{
@@ -1408,11 +1517,11 @@ namespace TJA
 				} break;
 				case ParsedChartCommandType::SetSudden:
 				{
-					appendCommandLine(out, Key::Chart_SUDDEN, std::string_view(buffer, sprintf_s(buffer, "%g %g", command.Param.SetSudden.AppearanceOffset.ToSec(), command.Param.SetSudden.MovementWaitDelay.ToSec())));
+					appendCommandLine(out, Key::Chart_SUDDEN, ShortestNumberFormatter().Sec(command.Param.SetSudden.AppearanceOffset).Char(' ').Sec(command.Param.SetSudden.MovementWaitDelay).View());
 				} break;
 				case ParsedChartCommandType::SetJPOSScroll:
 				{
-					appendCommandLine(out, Key::Chart_JPOSSCROLL, std::string_view(buffer, sprintf_s(buffer, "%g %s 1", command.Param.ChangeJPOSScroll.Duration.ToSec(), command.Param.ChangeJPOSScroll.Move.toStringCompat().c_str())));
+					appendCommandLine(out, Key::Chart_JPOSSCROLL, ShortestNumberFormatter().Sec(command.Param.ChangeJPOSScroll.Duration).Char(' ').CPX(command.Param.ChangeJPOSScroll.Move).Char(' ').Char('1').View());
 				} break;
 				default: { assert(!"Unhandled ParsedChartCommandType switch case"); } break;
 				}
@@ -1426,9 +1535,10 @@ namespace TJA
 		}
 	}
 
-	void ConvertConvertedMeasuresToParsedCommands(const std::vector<ConvertedMeasure>& inMeasures, std::vector<ParsedChartCommand>& outCommands)
+	void ConvertConvertedMeasuresToParsedCommands(const std::vector<ConvertedMeasure>& inMeasures, std::vector<ParsedChartCommand>& outCommands, ParsedChartCommandArena& outArena)
 	{
-		struct TempCommand { Beat TimeWithinMeasure; ParsedChartCommand ParsedCommand; };
+		// NOTE: Single-note MeasureNotes commands only get their arena notes once merged in order, so that each command's notes stay contiguous
+		struct TempCommand { Beat TimeWithinMeasure; ParsedChartCommand ParsedCommand; NoteType Note; };
 		std::vector<TempCommand> tempBuffer;
 		tempBuffer.reserve(64);
 
@@ -1495,7 +1605,7 @@ namespace TJA
 			{
 				ParsedChartCommand& tempCommand = tempBuffer.emplace_back(TempCommand { lyricChange.TimeWithinMeasure }).ParsedCommand;
 				tempCommand.Type = ParsedChartCommandType::SetLyricLine;
-				tempCommand.Param.SetLyricLine.Value = lyricChange.Lyric;
+				tempCommand.Param.SetLyricLine.Value = outArena.PushString(lyricChange.Lyric);
 			}
 
 			for (const ConvertedDelayChange& delayChange : inMeasure.DelayChanges)
@@ -1510,9 +1620,8 @@ namespace TJA
 			i32 actualNotesInThisMeasure = 0;
 			for (const ConvertedNote& note : inMeasure.Notes)
 			{
-				ParsedChartCommand& tempCommand = tempBuffer.emplace_back(TempCommand { note.TimeWithinMeasure }).ParsedCommand;
+				ParsedChartCommand& tempCommand = tempBuffer.emplace_back(TempCommand { note.TimeWithinMeasure, {}, note.Type }).ParsedCommand;
 				tempCommand.Type = ParsedChartCommandType::MeasureNotes;
-				tempCommand.Param.MeasureNotes.Notes.push_back(note.Type);
 				actualNotesInThisMeasure++;
 			}
 			size_t noteCommandEnd = tempBuffer.size();
@@ -1559,9 +1668,8 @@ namespace TJA
 
 						if (!noteAlreadyExists)
 						{
-							ParsedChartCommand& tempCommand = tempBuffer.emplace_back(TempCommand { noteBeat }).ParsedCommand;
+							ParsedChartCommand& tempCommand = tempBuffer.emplace_back(TempCommand { noteBeat, {}, NoteType::None }).ParsedCommand;
 							tempCommand.Type = ParsedChartCommandType::MeasureNotes;
-							tempCommand.Param.MeasureNotes.Notes.push_back(NoteType::None);
 						}
 					}
 
@@ -1585,15 +1693,16 @@ namespace TJA
 					// NOTE: Merge adjacent single-note MeasureNotes commands
 					if (lastNoteCommand != nullptr && (thisCommand.ParsedCommand.Type == ParsedChartCommandType::MeasureNotes))
 					{
-						for (NoteType note : thisCommand.ParsedCommand.Param.MeasureNotes.Notes)
-							lastNoteCommand->Param.MeasureNotes.Notes.push_back(note);
+						outArena.PushNote(lastNoteCommand->Param.MeasureNotes.Notes, thisCommand.Note);
 					}
 					else {
 						// Push first, modify later
-						outCommands.push_back(std::move(thisCommand.ParsedCommand));
+						outCommands.push_back(thisCommand.ParsedCommand);
 						lastNoteCommand = (outCommands.back().Type == ParsedChartCommandType::MeasureNotes) ?
 							&outCommands.back()
 							: nullptr;
+						if (lastNoteCommand != nullptr)
+							outArena.PushNote(lastNoteCommand->Param.MeasureNotes.Notes, thisCommand.Note);
 					}
 				}
 				tempBuffer.clear();
@@ -1623,7 +1732,7 @@ namespace TJA
 			{
 				if (command.Type == ParsedChartCommandType::MeasureNotes)
 				{
-					for (const NoteType note : command.Param.MeasureNotes.Notes)
+					for (const NoteType note : inContent.Arena.GetNotes(command.Param.MeasureNotes.Notes))
 						currentMeasure->Notes.push_back(ConvertedNote { Beat::Zero(), note });
 				}
 				else if (command.Type == ParsedChartCommandType::MeasureEnd)
@@ -1662,7 +1771,7 @@ namespace TJA
 			{
 				if (command.Type == ParsedChartCommandType::MeasureNotes)
 				{
-					currentNotesInMeasure += static_cast<i32>(command.Param.MeasureNotes.Notes.size());
+					currentNotesInMeasure += static_cast<i32>(command.Param.MeasureNotes.Notes.Count);
 
 					if (!currentMeasure->Notes.empty() && currentNotesInMeasure > 0)
 						currentTimeWithinMeasure = currentMeasure->Notes[currentNotesInMeasure - 1].TimeWithinMeasure +
@@ -1703,7 +1812,7 @@ namespace TJA
 				}
 				else if (command.Type == ParsedChartCommandType::SetLyricLine)
 				{
-					currentMeasure->LyricChanges.push_back(ConvertedLyricChange { currentTimeWithinMeasure, command.Param.SetLyricLine.Value });
+					currentMeasure->LyricChanges.push_back(ConvertedLyricChange { currentTimeWithinMeasure, std::string(inContent.Arena.GetString(command.Param.SetLyricLine.Value)) });
 				}
 				else if (command.Type == ParsedChartCommandType::NMScroll || command.Type == ParsedChartCommandType::HBScroll || command.Type == ParsedChartCommandType::BMScroll) 
 				{
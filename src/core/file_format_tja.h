@@ -4,6 +4,7 @@
 #include "core_string.h"
 #include "core_beat.h"
 #include <vector>
+#include <span>
 #include <cstdarg>
 #include <map>
 
@@ -146,12 +147,22 @@ namespace TJA
 	{
 		TokenType Type;
 		Key Key;
-		i16 LineIndex;
+		i32 LineIndex;
 		std::string_view Line;
 		std::string_view KeyString;
 		std::string_view ValueString;
 	};
 
+	// NOTE: The 32-bit line index still fits into the padding after Type and Key, same as the previous 16-bit one
+	static_assert(sizeof(Token) <= (sizeof(i32) * 2 + sizeof(std::string_view) * 3));
+
+	// NOTE: Of the start of the (trimmed) token line within the file content the lines were split from (via SplitLines),
+	//		 or of the end of the file for the implicit end-of-file token
+	inline size_t GetTokenByteOffset(const Token& token, std::string_view fileContent)
+	{
+		return (token.Line.data() != nullptr) ? static_cast<size_t>(token.Line.data() - fileContent.data()) : fileContent.size();
+	}
+
 	constexpr Tempo DefaultTempo = Tempo(120.0f);
 
 	constexpr TimeSignature DefaultTimeSignature = TimeSignature(4, 4);
@@ -379,13 +390,43 @@ namespace TJA
 		Count
 	};
 
+	// NOTE: Offset + count into one of the buffers of the ParsedChartCommandArena owned by the same ParsedTJA
+	struct ParsedArenaSlice { u32 Offset; u32 Count; };
+
+	// NOTE: Shared storage for all variable length chart command data so that commands themselves never need to allocate
+	struct ParsedChartCommandArena
+	{
+		std::vector<NoteType> Notes;
+		std::string Strings;
+
+		inline ParsedArenaSlice PushString(std::string_view value)
+		{
+			const ParsedArenaSlice slice = { static_cast<u32>(Strings.size()), static_cast<u32>(value.size()) };
+			Strings.append(value);
+			return slice;
+		}
+
+		// NOTE: Notes of a single command have to be pushed contiguously, that is without pushing notes for any other command in between
+		inline void PushNote(ParsedArenaSlice& inOutNotes, NoteType note)
+		{
+			assert(inOutNotes.Count == 0 || (inOutNotes.Offset + inOutNotes.Count) == Notes.size());
+			if (inOutNotes.Count == 0)
+				inOutNotes.Offset = static_cast<u32>(Notes.size());
+			Notes.push_back(note);
+			inOutNotes.Count++;
+		}
+
+		inline std::string_view GetString(ParsedArenaSlice slice) const { return std::string_view(Strings.data() + slice.Offset, slice.Count); }
+		inline std::span<const NoteType> GetNotes(ParsedArenaSlice slice) const { return std::span<const NoteType>(Notes.data() + slice.Offset, slice.Count); }
+	};
+
 	struct ParsedChartCommand
 	{
-		// TODO: Maybe store notes as index + count into single vector (?)
 		ParsedChartCommandType Type;
-		struct ParamData
+		// NOTE: Tagged by the command type, with all note / string data stored inside the arena of the owning ParsedTJA
+		union ParamData
 		{
-			struct { std::vector<NoteType> Notes; } MeasureNotes;
+			struct { ParsedArenaSlice Notes; } MeasureNotes;
 			struct { TimeSignature Value; } ChangeTimeSignature;
 			struct { Tempo Value; } ChangeTempo;
 			struct { Time Value; } ChangeDelay;
@@ -394,15 +435,23 @@ namespace TJA
 			struct { Time Duration; Complex Move; } ChangeJPOSScroll;
 			struct { b8 Visible; } ChangeBarLine;
 			struct { BranchCondition Condition; i32 RequirementExpert; i32 RequirementMaster; } BranchStart;
-			struct { std::string Value; } SetLyricLine;
+			struct { ParsedArenaSlice Value; } SetLyricLine;
 			struct { i32 Type; } SENoteChange;
-			struct { std::string CommaSeparatedList; } SetNextSong;
+			struct { ParsedArenaSlice CommaSeparatedList; } SetNextSong;
 			struct { ScrollDirection Direction; } ChangeDirection;
 			struct { Time AppearanceOffset, MovementWaitDelay; } SetSudden;
 			struct { Time Duration; f32 MovementDistance; ScrollDirection Direction; } SetScrollTransition;
-		} Param;
+
+			// NOTE: All members are trivially copyable but Tempo, Complex etc. have non-trivial default constructors (which would delete a defaulted one)
+			constexpr ParamData() : MeasureNotes {} {}
+			ParamData(const ParamData&) = default;
+			ParamData& operator=(const ParamData&) = default;
+		} Param {};
 	};
 
+	static_assert(std::is_trivially_copyable_v<ParsedChartCommand>);
+	static_assert(sizeof(ParsedChartCommand) == 24);
+
 	struct ParsedCourse
 	{
 		ParsedCourseMetadata Metadata;
@@ -414,6 +463,7 @@ namespace TJA
 	{
 		ParsedMainMetadata Metadata;
 		std::vector<ParsedCourse> Courses;
+		ParsedChartCommandArena Arena;
 
 		// NOTE: Only for internal use within PeepoDrumKit. TJAs that have been exported with this special comment marker
 		//		 are assumed to only make use of known and supported features that can be safely converted without having to worry about potential data loss
@@ -539,7 +589,7 @@ namespace TJA
 		std::vector<ConvertedGoGoRange> GoGoRanges;
 	};
 
-	void ConvertConvertedMeasuresToParsedCommands(const std::vector<TJA::ConvertedMeasure>& inMeasures, std::vector<TJA::ParsedChartCommand>& outCommands);
+	void ConvertConvertedMeasuresToParsedCommands(const std::vector<TJA::ConvertedMeasure>& inMeasures, std::vector<TJA::ParsedChartCommand>& outCommands, ParsedChartCommandArena& outArena);
 
 	ConvertedCourse ConvertParsedToConvertedCourse(const ParsedTJA& inContent, const ParsedCourse& inCourse);
 }
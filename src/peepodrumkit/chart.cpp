@@ -1,6 +1,9 @@
 #include "chart.h"
 #include "core_build_info.h"
 #include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
 
 namespace PeepoDrumKit
 {
@@ -65,6 +68,245 @@ namespace PeepoDrumKit
 		}
 	}
 
+	// NOTE: The subset of the note lane data needed for picking the SE of a note, with a null OriginalNote for out-of-bounds indices
+	struct SENoteLaneData
+	{
+		const Note* OriginalNote;
+		Beat Beat;
+		Time Time;
+		Tempo Tempo;
+		Complex ScrollSpeed;
+		ScrollMethod ScrollType;
+	};
+
+	// prev, curr, next, n(ext)2nd
+	struct SENoteWindow { SENoteLaneData Prev, Curr, Next, N2nd; };
+
+	struct SENoteAlterChain
+	{
+		std::vector<const Note*> Notes;
+		b8 IsActive = true;
+		Time TimeInterval = Time::Zero();
+		Time TimeStart = Time::Zero();
+	};
+
+	static SENoteLaneData GetSENoteLaneData(const ChartCourse& course, const SortedNotesList& notes, size_t index)
+	{
+		if (index >= notes.size())
+			return SENoteLaneData {};
+
+		const Note& note = notes[index];
+		return SENoteLaneData { &note, note.BeatTime, (course.TempoMap.BeatToTime(note.BeatTime) + note.TimeOffset),
+			TempoOrDefault(course.TempoMap.Tempo.TryFindLastAtBeat(note.BeatTime)),
+			ScrollOrDefault(course.ScrollChanges.TryFindLastAtBeat(note.BeatTime)),
+			ScrollTypeOrDefault(course.ScrollTypes.TryFindLastAtBeat(note.BeatTime)) };
+	}
+
+	static SENoteWindow GetSENoteWindow(const ChartCourse& course, const SortedNotesList& notes, size_t index)
+	{
+		return SENoteWindow {
+			(index > 0) ? GetSENoteLaneData(course, notes, index - 1) : SENoteLaneData {},
+			GetSENoteLaneData(course, notes, index),
+			GetSENoteLaneData(course, notes, index + 1),
+			GetSENoteLaneData(course, notes, index + 2) };
+	}
+
+	struct SENoteDistances { Time ToPrev; f32 VisualBeatsToPrev; Time ToNext; f32 VisualBeatsToNextCapped; Time NextToN2nd; };
+
+	static SENoteDistances GetSENoteDistances(const SENoteWindow& window)
+	{
+		// distance when curr is on the judgement mark
+		// other is NMScroll: visual beat distance = sec_time * visual_beat_per_second_other
+		// other is HBScroll: visual beat distance = scroll_other * beat_distance
+		auto getVisualBeat = [&](const SENoteLaneData& curr, const SENoteLaneData& other, f32 scrollOther, f32 vbpsOther, Time timeDistance)
+		{
+			return (other.OriginalNote == nullptr) ? F32Max
+				: (other.ScrollType == ScrollMethod::NMSCROLL) ? vbpsOther * timeDistance.Seconds
+				: (other.ScrollType == ScrollMethod::HBSCROLL) ? scrollOther * abs(curr.Beat - other.Beat).Ticks / Beat::TicksPerBeat
+				: /* (prev.ScrollType == ScrollMethod::BMSCROLL) ? */ abs(curr.Beat - other.Beat).Ticks / Beat::TicksPerBeat;
+		};
+
+		const auto& [prev, curr, next, n2nd] = window;
+		const f32 scrollPrev = abs(prev.ScrollSpeed.cpx);
+		const f32 scrollNextCapped = std::min(1.0f, abs(next.ScrollSpeed.cpx));
+		// visual beat per second
+		const f32 vbpsPrev = scrollPrev * prev.Tempo.BPM / 60;
+		const f32 vbpsNextCapped = scrollNextCapped * next.Tempo.BPM / 60;
+		// time distance
+		const Time tdToPrev = (prev.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (curr.Time - prev.Time);
+		const Time tdToNext = (next.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (next.Time - curr.Time);
+		const Time tdToN2nd = (n2nd.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (n2nd.Time - next.Time);
+		const f32 vbdToPrev = getVisualBeat(curr, prev, scrollPrev, vbpsPrev, tdToPrev);
+		const f32 vbdToNextCapped = getVisualBeat(curr, next, scrollNextCapped, vbpsNextCapped, tdToNext);
+		return SENoteDistances { tdToPrev, vbdToPrev, tdToNext, vbdToNextCapped, tdToN2nd };
+	}
+
+	static constexpr Time SENoteTimeEpsilon = Time::FromMS(1e-3);
+
+	static b8 IsSENoteDenseToSparse(const SENoteDistances& distances) { return (distances.ToNext >= distances.ToPrev + SENoteTimeEpsilon); }
+	static b8 IsSENoteSparseToDense(const SENoteDistances& distances) { return (distances.NextToN2nd <= distances.ToNext - SENoteTimeEpsilon); }
+
+	// NOTE: The alternating chain is always reset after a note changing between dense and sparse note spacing or after a non-Don note,
+	//		 so its state right after such a note only depends on the surrounding window, allowing for the recalculation to be resumed / stopped there
+	static std::optional<b8> TryGetSENoteAlterChainResetState(const SENoteWindow& window)
+	{
+		const SENoteDistances distances = GetSENoteDistances(window);
+		if (IsSENoteDenseToSparse(distances) || IsSENoteSparseToDense(distances))
+			return IsSENoteSparseToDense(distances);
+		if (window.Curr.OriginalNote->Type != NoteType::Don)
+			return false;
+		return std::nullopt;
+	}
+
+	static void AssignSENote(const SENoteWindow& window, SENoteAlterChain& chain)
+	{
+		enum class SEFormType { Long, Short, Alternate, Final };
+
+		const SENoteLaneData& curr = window.Curr;
+		const Note& it = *curr.OriginalNote;
+		const SENoteDistances distances = GetSENoteDistances(window);
+		const auto [tdToPrev, vbdToPrev, tdToNext, vbdToNextCapped, tdToN2nd] = distances;
+		const Time timeEpsilon = SENoteTimeEpsilon;
+		const b8 denseToSparse = IsSENoteDenseToSparse(distances);
+		const b8 sparseToDense = IsSENoteSparseToDense(distances);
+		const f32 beatsEpsilon = 4 / 192.0;
+		const b8 isLongAvoided = (vbdToPrev <= 4 / 16.0 - beatsEpsilon
+			|| vbdToNextCapped <= 4 / 12.0 - beatsEpsilon); // avoid text from overlapping or extending under next note
+		const b8 isPrePause = (vbdToNextCapped >= 4 / 8.0 + beatsEpsilon);
+		auto se = (!isLongAvoided && (denseToSparse || sparseToDense || isPrePause)) ? SEFormType::Long : SEFormType::Short;
+		if (chain.IsActive) {
+			if (it.Type == NoteType::Don && chain.Notes.empty()) {
+				chain.TimeInterval = tdToNext;
+				chain.TimeStart = curr.Time;
+				chain.Notes.push_back(&it);
+			} else if (it.Type == NoteType::Don && abs(tdToPrev - chain.TimeInterval) < timeEpsilon && abs(chain.TimeStart - curr.Time) < Time::FromSec(0.5) + timeEpsilon) {
+				chain.Notes.push_back(&it);
+			} else {
+				chain.IsActive = false;
+				chain.Notes.clear();
+			}
+		}
+		if (denseToSparse || sparseToDense) {
+			if (denseToSparse && chain.IsActive && !isLongAvoided && size(chain.Notes) % 2 != 0 && abs(chain.TimeStart - curr.Time) < Time::FromSec(0.5) + timeEpsilon) {
+				for (i32 ia = 0; ia < size(chain.Notes); ++ia) {
+					if (ia % 2 == 1)
+						chain.Notes[ia]->TempSEType = NoteSEType::Ko;
+				}
+			}
+			chain.Notes.clear();
+			chain.IsActive = sparseToDense;
+		}
+
+		switch (it.Type)
+		{
+		case NoteType::Don: { it.TempSEType = (se == SEFormType::Long) ? NoteSEType::Don : NoteSEType::Do; } break;
+		case NoteType::DonBig: { it.TempSEType = NoteSEType::DonBig; } break;
+		case NoteType::DonBigHand: { it.TempSEType = NoteSEType::DonHand; } break;
+		case NoteType::Ka: { it.TempSEType = (se == SEFormType::Long) ? NoteSEType::Katsu : NoteSEType::Ka; } break;
+		case NoteType::KaBig: { it.TempSEType = NoteSEType::KatsuBig; } break;
+		case NoteType::KaBigHand: { it.TempSEType = NoteSEType::KatsuHand; } break;
+		case NoteType::Drumroll: { it.TempSEType = NoteSEType::Drumroll; } break;
+		case NoteType::DrumrollBig: { it.TempSEType = NoteSEType::DrumrollBig; } break;
+		case NoteType::Balloon: { it.TempSEType = NoteSEType::Balloon; } break;
+		case NoteType::BalloonSpecial: { it.TempSEType = NoteSEType::BalloonSpecial; } break;
+		default: { it.TempSEType = NoteSEType::Count; } break;
+		}
+	}
+
+	// NOTE: Assigns the SE of every note starting at startIndex, stopping early at the first reset point at or after stopIndexMin
+	static void RecalculateSENotesFrom(const ChartCourse& course, const SortedNotesList& notes, size_t startIndex, b8 isAlterChainActive, size_t stopIndexMin)
+	{
+		SENoteAlterChain chain {};
+		chain.IsActive = isAlterChainActive;
+
+		SENoteWindow window = GetSENoteWindow(course, notes, startIndex);
+		for (size_t i = startIndex; i < notes.size(); i++)
+		{
+			AssignSENote(window, chain);
+			if (i >= stopIndexMin && TryGetSENoteAlterChainResetState(window).has_value())
+				break;
+			window.Prev = window.Curr;
+			window.Curr = window.Next;
+			window.Next = window.N2nd;
+			window.N2nd = GetSENoteLaneData(course, notes, i + 3);
+		}
+	}
+
+	void ChartCourse::RecalculateSENotes(BranchType branch) const
+	{
+		const SortedNotesList& notes = GetNotes(branch);
+		RecalculateSENotesFrom(*this, notes, 0, true, notes.size());
+	}
+
+	void ChartCourse::RecalculateSENotesInRange(BranchType branch, Beat beatMin, Beat beatMax) const
+	{
+		const SortedNotesList& notes = GetNotes(branch);
+		const size_t dirtyBegin = BinarySearchForInsertionIndex(notes, beatMin);
+		const size_t dirtyEnd = Max(dirtyBegin, BinarySearchForIndexAfterBeat(notes, beatMax));
+
+		// NOTE: Only notes with none of their (prev, curr, next, n2nd) window inside the edited range are guaranteed to be unaffected,
+		//		 so resume after the closest such reset point before it and stop at the first one past it (or just start from the beginning)
+		size_t startIndex = 0;
+		b8 isAlterChainActive = true;
+		if (dirtyBegin >= 3)
+		{
+			SENoteWindow window = GetSENoteWindow(*this, notes, dirtyBegin - 3);
+			for (size_t i = dirtyBegin - 3; ; i--)
+			{
+				if (const std::optional<b8> resetState = TryGetSENoteAlterChainResetState(window); resetState.has_value())
+				{
+					startIndex = i + 1;
+					isAlterChainActive = resetState.value();
+					break;
+				}
+				if (i == 0)
+					break;
+				window.N2nd = window.Next;
+				window.Next = window.Curr;
+				window.Curr = window.Prev;
+				window.Prev = (i >= 2) ? GetSENoteLaneData(*this, notes, i - 2) : SENoteLaneData {};
+			}
+		}
+
+		RecalculateSENotesFrom(*this, notes, startIndex, isAlterChainActive, dirtyEnd + 1);
+	}
+
+	void JPOSScrollPrefixSumTable::Rebuild(const SortedJPOSScrollChangesList& jposScrollChanges, const TempoMapAccelerationStructure& accelerationStructure)
+	{
+		Entries.resize(jposScrollChanges.size());
+		for (size_t i = 0; i < jposScrollChanges.size(); i++)
+		{
+			Entries[i].StartTime = accelerationStructure.ConvertBeatToTimeUsingSegmentLookup(jposScrollChanges[i].BeatTime);
+			Entries[i].StartTimeRunningMax = (i > 0) ? Max(Entries[i - 1].StartTimeRunningMax, Entries[i].StartTime) : Entries[i].StartTime;
+			Entries[i].Duration = Time::FromSec(jposScrollChanges[i].Duration);
+			Entries[i].Move = vec2(jposScrollChanges[i].Move.GetRealPart(), jposScrollChanges[i].Move.GetImaginaryPart());
+		}
+
+		// NOTE: Each change is cut short by the start of the next one, in which case only the covered fraction of its move is applied
+		vec2 moveSum = vec2(0.0f);
+		for (size_t i = 0; i < Entries.size(); i++)
+		{
+			Entries[i].MoveBefore = moveSum;
+			const Time durationMax = (i + 1 < Entries.size()) ? (Entries[i + 1].StartTime - Entries[i].StartTime) : Time::FromSec(F32Max);
+			const f32 timeRatio = (Entries[i].Duration <= Time::Zero()) ? 1.0f : static_cast<f32>(Min(durationMax, Entries[i].Duration) / Entries[i].Duration);
+			moveSum += (Entries[i].Move * timeRatio);
+		}
+	}
+
+	vec2 JPOSScrollPrefixSumTable::GetMoveAtTime(Time timeStamp) const
+	{
+		// NOTE: The active change is the one before the first change (in beat order) starting after the given time, same as when summing them up one by one.
+		//		 With negative tempos the start times aren't sorted, but the first one exceeding the time is also the first one raising the running max above it
+		const auto activeIt = std::partition_point(Entries.begin(), Entries.end(), [&](const Entry& it) { return it.StartTimeRunningMax <= timeStamp; });
+		if (activeIt == Entries.begin())
+			return vec2(0.0f);
+
+		const Entry& active = *(activeIt - 1);
+		const Time durationMax = (activeIt != Entries.end()) ? (activeIt->StartTime - active.StartTime) : Time::FromSec(F32Max);
+		const f32 timeRatio = (active.Duration <= Time::Zero()) ? 1.0f : static_cast<f32>(Min(Min(durationMax, active.Duration), timeStamp - active.StartTime) / active.Duration);
+		return active.MoveBefore + (active.Move * timeRatio);
+	}
+
 	struct TempTimedDelayCommand { Beat Beat; Time Delay; };
 
 	template <>
@@ -386,136 +628,166 @@ namespace PeepoDrumKit
 		return true;
 	}
 
-	b8 CreateChartProjectFromTJA(const TJA::ParsedTJA& inTJA, ChartProject& out)
+	// NOTE: Only reads from the parsed TJA and writes to its own output course, so that multiple courses can safely be created in parallel
+	static Time CreateChartCourseFromTJA(const TJA::ParsedTJA& inTJA, const TJA::ParsedCourse& inParsedCourse, ChartCourse& outCourse)
 	{
-		out.ChartDuration = Time::Zero();
-		out.ChartTitle = inTJA.Metadata.TITLE;
-		out.ChartTitleLocalized = inTJA.Metadata.TITLE_localized;
-		out.ChartSubtitle = inTJA.Metadata.SUBTITLE;
-		out.ChartSubtitleLocalized = inTJA.Metadata.SUBTITLE_localized;
-		out.ChartCreator = inTJA.Metadata.MAKER;
-		out.ChartGenre = inTJA.Metadata.GENRE;
-		out.ChartLyricsFileName = inTJA.Metadata.LYRICS;
-		out.SongOffset = inTJA.Metadata.OFFSET;
-		out.SongDemoStartTime = inTJA.Metadata.DEMOSTART;
-		out.SongFileName = inTJA.Metadata.WAVE;
-		out.SongJacket = inTJA.Metadata.PREIMAGE;
-		out.SongVolume = inTJA.Metadata.SONGVOL;
-		out.SoundEffectVolume = inTJA.Metadata.SEVOL;
-		out.BackgroundImageFileName = inTJA.Metadata.BGIMAGE;
-		out.BackgroundMovieFileName = inTJA.Metadata.BGMOVIE;
-		out.MovieOffset = inTJA.Metadata.MOVIEOFFSET;
-		out.OtherMetadata = inTJA.Metadata.Others;
-		for (size_t i = 0; i < inTJA.Courses.size(); i++)
-		{
-			if (!inTJA.Courses[i].HasChart) // metadata-only TJA section
-				continue;
+		const TJA::ConvertedCourse& inCourse = TJA::ConvertParsedToConvertedCourse(inTJA, inParsedCourse);
 
-			const TJA::ConvertedCourse& inCourse = TJA::ConvertParsedToConvertedCourse(inTJA, inTJA.Courses[i]);
-			ChartCourse& outCourse = *out.Courses.emplace_back(std::make_unique<ChartCourse>());
+		// HACK: Write proper enum conversion functions
+		outCourse.Type = Clamp(static_cast<DifficultyType>(inCourse.CourseMetadata.COURSE), DifficultyType {}, DifficultyType::Count);
+		outCourse.Level = Clamp(static_cast<DifficultyLevel>(inCourse.CourseMetadata.LEVEL), DifficultyLevel::Min, DifficultyLevel::Max);
+		outCourse.Decimal = Clamp(static_cast<DifficultyLevelDecimal>(inCourse.CourseMetadata.LEVEL_DECIMALTAG), DifficultyLevelDecimal::None, DifficultyLevelDecimal::Max);
+		outCourse.Style = std::max(inCourse.CourseMetadata.STYLE, 1);
+		outCourse.PlayerSide = std::clamp(inCourse.CourseMetadata.START_PLAYERSIDE, 1, outCourse.Style);
 
-			// HACK: Write proper enum conversion functions
-			outCourse.Type = Clamp(static_cast<DifficultyType>(inCourse.CourseMetadata.COURSE), DifficultyType {}, DifficultyType::Count);
-			outCourse.Level = Clamp(static_cast<DifficultyLevel>(inCourse.CourseMetadata.LEVEL), DifficultyLevel::Min, DifficultyLevel::Max);
-			outCourse.Decimal = Clamp(static_cast<DifficultyLevelDecimal>(inCourse.CourseMetadata.LEVEL_DECIMALTAG), DifficultyLevelDecimal::None, DifficultyLevelDecimal::Max);
-			outCourse.Style = std::max(inCourse.CourseMetadata.STYLE, 1);
-			outCourse.PlayerSide = std::clamp(inCourse.CourseMetadata.START_PLAYERSIDE, 1, outCourse.Style);
+		outCourse.CourseCreator = inCourse.CourseMetadata.NOTESDESIGNER;
 
-			outCourse.CourseCreator = inCourse.CourseMetadata.NOTESDESIGNER;
+		outCourse.Life = Clamp(static_cast<TowerLives>(inCourse.CourseMetadata.LIFE), TowerLives::Min, TowerLives::Max);
+		outCourse.Side = Clamp(static_cast<Side>(inCourse.CourseMetadata.SIDE), Side{}, Side::Count);
 
-			outCourse.Life = Clamp(static_cast<TowerLives>(inCourse.CourseMetadata.LIFE), TowerLives::Min, TowerLives::Max);
-			outCourse.Side = Clamp(static_cast<Side>(inCourse.CourseMetadata.SIDE), Side{}, Side::Count);
+		outCourse.TempoMap.Tempo.Sorted = { TempoChange(Beat::Zero(), inTJA.Metadata.BPM) };
+		outCourse.TempoMap.Signature.Sorted = { TimeSignatureChange(Beat::Zero(), TimeSignature(4, 4)) };
+		TimeSignature lastSignature = TimeSignature(4, 4);
 
-			outCourse.TempoMap.Tempo.Sorted = { TempoChange(Beat::Zero(), inTJA.Metadata.BPM) };
-			outCourse.TempoMap.Signature.Sorted = { TimeSignatureChange(Beat::Zero(), TimeSignature(4, 4)) };
-			TimeSignature lastSignature = TimeSignature(4, 4);
+		i32 currentBalloonIndex = 0;
 
-			i32 currentBalloonIndex = 0;
-
-			BeatSortedList<TempTimedDelayCommand> tempSortedDelayCommands;
-			BeatSortedForwardIterator<TempTimedDelayCommand> tempDelayCommandsIt;
-			for (const TJA::ConvertedMeasure& inMeasure : inCourse.Measures)
-			{
-				for (const TJA::ConvertedDelayChange& inDelayChange : inMeasure.DelayChanges)
-					tempSortedDelayCommands.InsertOrUpdate(TempTimedDelayCommand { inMeasure.StartTime + inDelayChange.TimeWithinMeasure, inDelayChange.Delay });
-			}
+		BeatSortedList<TempTimedDelayCommand> tempSortedDelayCommands;
+		BeatSortedForwardIterator<TempTimedDelayCommand> tempDelayCommandsIt;
+		for (const TJA::ConvertedMeasure& inMeasure : inCourse.Measures)
+		{
+			for (const TJA::ConvertedDelayChange& inDelayChange : inMeasure.DelayChanges)
+				tempSortedDelayCommands.InsertOrUpdate(TempTimedDelayCommand { inMeasure.StartTime + inDelayChange.TimeWithinMeasure, inDelayChange.Delay });
+		}
 
-			for (const TJA::ConvertedMeasure& inMeasure : inCourse.Measures)
+		for (const TJA::ConvertedMeasure& inMeasure : inCourse.Measures)
+		{
+			for (const TJA::ConvertedNote& inNote : inMeasure.Notes)
 			{
-				for (const TJA::ConvertedNote& inNote : inMeasure.Notes)
+				if (inNote.Type == TJA::NoteType::End_BalloonOrDrumroll)
 				{
-					if (inNote.Type == TJA::NoteType::End_BalloonOrDrumroll)
-					{
-						// TODO: Proper handling
-						if (!outCourse.Notes_Normal.Sorted.empty())
-							outCourse.Notes_Normal.Sorted.back().BeatDuration = (inMeasure.StartTime + inNote.TimeWithinMeasure) - outCourse.Notes_Normal.Sorted.back().BeatTime;
-						continue;
-					}
-
-					const NoteType outNoteType = ConvertTJANoteType(inNote.Type);
-					if (outNoteType == NoteType::Count)
-						continue;
+					// TODO: Proper handling
+					if (!outCourse.Notes_Normal.Sorted.empty())
+						outCourse.Notes_Normal.Sorted.back().BeatDuration = (inMeasure.StartTime + inNote.TimeWithinMeasure) - outCourse.Notes_Normal.Sorted.back().BeatTime;
+					continue;
+				}
 
-					Note& outNote = outCourse.Notes_Normal.Sorted.emplace_back();
-					outNote.BeatTime = (inMeasure.StartTime + inNote.TimeWithinMeasure);
-					outNote.Type = outNoteType;
+				const NoteType outNoteType = ConvertTJANoteType(inNote.Type);
+				if (outNoteType == NoteType::Count)
+					continue;
 
-					const TempTimedDelayCommand* delayCommandForThisNote = tempDelayCommandsIt.Next(tempSortedDelayCommands.Sorted, outNote.BeatTime);
-					outNote.TimeOffset = (delayCommandForThisNote != nullptr) ? delayCommandForThisNote->Delay : Time::Zero();
+				Note& outNote = outCourse.Notes_Normal.Sorted.emplace_back();
+				outNote.BeatTime = (inMeasure.StartTime + inNote.TimeWithinMeasure);
+				outNote.Type = outNoteType;
 
-					if (inNote.Type == TJA::NoteType::Start_Balloon || inNote.Type == TJA::NoteType::Start_BaloonSpecial || inNote.Type == TJA::NoteType::Fuse)
-					{
-						// TODO: Implement properly with correct branch handling
-						if (InBounds(currentBalloonIndex, inCourse.CourseMetadata.BALLOON))
-							outNote.BalloonPopCount = inCourse.CourseMetadata.BALLOON[currentBalloonIndex];
-						currentBalloonIndex++;
-					}
-				}
+				const TempTimedDelayCommand* delayCommandForThisNote = tempDelayCommandsIt.Next(tempSortedDelayCommands.Sorted, outNote.BeatTime);
+				outNote.TimeOffset = (delayCommandForThisNote != nullptr) ? delayCommandForThisNote->Delay : Time::Zero();
 
-				if (inMeasure.TimeSignature != lastSignature)
+				if (inNote.Type == TJA::NoteType::Start_Balloon || inNote.Type == TJA::NoteType::Start_BaloonSpecial || inNote.Type == TJA::NoteType::Fuse)
 				{
-					outCourse.TempoMap.Signature.InsertOrUpdate(TimeSignatureChange(inMeasure.StartTime, inMeasure.TimeSignature));
-					lastSignature = inMeasure.TimeSignature;
+					// TODO: Implement properly with correct branch handling
+					if (InBounds(currentBalloonIndex, inCourse.CourseMetadata.BALLOON))
+						outNote.BalloonPopCount = inCourse.CourseMetadata.BALLOON[currentBalloonIndex];
+					currentBalloonIndex++;
 				}
+			}
 
-				for (const TJA::ConvertedTempoChange& inTempoChange : inMeasure.TempoChanges)
-					outCourse.TempoMap.Tempo.InsertOrUpdate(TempoChange(inMeasure.StartTime + inTempoChange.TimeWithinMeasure, inTempoChange.Tempo));
+			if (inMeasure.TimeSignature != lastSignature)
+			{
+				outCourse.TempoMap.Signature.InsertOrUpdate(TimeSignatureChange(inMeasure.StartTime, inMeasure.TimeSignature));
+				lastSignature = inMeasure.TimeSignature;
+			}
 
-				for (const TJA::ConvertedScrollChange& inScrollChange : inMeasure.ScrollChanges)
-					outCourse.ScrollChanges.Sorted.push_back(ScrollChange { (inMeasure.StartTime + inScrollChange.TimeWithinMeasure), inScrollChange.ScrollSpeed });
+			for (const TJA::ConvertedTempoChange& inTempoChange : inMeasure.TempoChanges)
+				outCourse.TempoMap.Tempo.InsertOrUpdate(TempoChange(inMeasure.StartTime + inTempoChange.TimeWithinMeasure, inTempoChange.Tempo));
 
-				for (const TJA::ConvertedScrollType& inScrollType : inMeasure.ScrollTypes)
-					outCourse.ScrollTypes.Sorted.push_back(ScrollType{ (inMeasure.StartTime + inScrollType.TimeWithinMeasure),  static_cast<ScrollMethod>(inScrollType.Method) });
+			for (const TJA::ConvertedScrollChange& inScrollChange : inMeasure.ScrollChanges)
+				outCourse.ScrollChanges.Sorted.push_back(ScrollChange { (inMeasure.StartTime + inScrollChange.TimeWithinMeasure), inScrollChange.ScrollSpeed });
 
-				for (const TJA::ConvertedJPOSScroll& inJPOSScrollChange : inMeasure.JPOSScrollChanges)
-					outCourse.JPOSScrollChanges.Sorted.push_back(JPOSScrollChange{ (inMeasure.StartTime + inJPOSScrollChange.TimeWithinMeasure), inJPOSScrollChange.Move, inJPOSScrollChange.Duration });
+			for (const TJA::ConvertedScrollType& inScrollType : inMeasure.ScrollTypes)
+				outCourse.ScrollTypes.Sorted.push_back(ScrollType{ (inMeasure.StartTime + inScrollType.TimeWithinMeasure),  static_cast<ScrollMethod>(inScrollType.Method) });
 
+			for (const TJA::ConvertedJPOSScroll& inJPOSScrollChange : inMeasure.JPOSScrollChanges)
+				outCourse.JPOSScrollChanges.Sorted.push_back(JPOSScrollChange{ (inMeasure.StartTime + inJPOSScrollChange.TimeWithinMeasure), inJPOSScrollChange.Move, inJPOSScrollChange.Duration });
 
-				for (const TJA::ConvertedBarLineChange& barLineChange : inMeasure.BarLineChanges)
-					outCourse.BarLineChanges.Sorted.push_back(BarLineChange { (inMeasure.StartTime + barLineChange.TimeWithinMeasure), barLineChange.Visibile });
 
-				for (const TJA::ConvertedLyricChange& lyricChange : inMeasure.LyricChanges)
-					outCourse.Lyrics.Sorted.push_back(LyricChange { (inMeasure.StartTime + lyricChange.TimeWithinMeasure), lyricChange.Lyric });
-			}
+			for (const TJA::ConvertedBarLineChange& barLineChange : inMeasure.BarLineChanges)
+				outCourse.BarLineChanges.Sorted.push_back(BarLineChange { (inMeasure.StartTime + barLineChange.TimeWithinMeasure), barLineChange.Visibile });
+
+			for (const TJA::ConvertedLyricChange& lyricChange : inMeasure.LyricChanges)
+				outCourse.Lyrics.Sorted.push_back(LyricChange { (inMeasure.StartTime + lyricChange.TimeWithinMeasure), lyricChange.Lyric });
+		}
+
+		for (const TJA::ConvertedGoGoRange& inGoGoRange : inCourse.GoGoRanges)
+			outCourse.GoGoRanges.Sorted.push_back(GoGoRange { inGoGoRange.StartTime, (inGoGoRange.EndTime - inGoGoRange.StartTime) });
 
-			for (const TJA::ConvertedGoGoRange& inGoGoRange : inCourse.GoGoRanges)
-				outCourse.GoGoRanges.Sorted.push_back(GoGoRange { inGoGoRange.StartTime, (inGoGoRange.EndTime - inGoGoRange.StartTime) });
+		//outCourse.TempoMap.SetTempoChange(TempoChange());
+		//outCourse.TempoMap = inCourse.GoGoRanges;
 
-			//outCourse.TempoMap.SetTempoChange(TempoChange());
-			//outCourse.TempoMap = inCourse.GoGoRanges;
+		outCourse.ScoreInit = inCourse.CourseMetadata.SCOREINIT;
+		outCourse.ScoreDiff = inCourse.CourseMetadata.SCOREDIFF;
 
-			outCourse.ScoreInit = inCourse.CourseMetadata.SCOREINIT;
-			outCourse.ScoreDiff = inCourse.CourseMetadata.SCOREDIFF;
+		outCourse.OtherMetadata = inCourse.CourseMetadata.Others;
 
-			outCourse.OtherMetadata = inCourse.CourseMetadata.Others;
+		outCourse.TempoMap.RebuildAccelerationStructure();
+		outCourse.RecalculateSENotes();
 
-			outCourse.TempoMap.RebuildAccelerationStructure();
-			outCourse.RecalculateSENotes();
+		return inCourse.Measures.empty() ? Time::Zero() : outCourse.TempoMap.BeatToTime(inCourse.Measures.back().StartTime /*+ inCourse.Measures.back().TimeSignature.GetDurationPerBar()*/);
+	}
+
+	b8 CreateChartProjectFromTJA(const TJA::ParsedTJA& inTJA, ChartProject& out)
+	{
+		out.ChartDuration = Time::Zero();
+		out.ChartTitle = inTJA.Metadata.TITLE;
+		out.ChartTitleLocalized = inTJA.Metadata.TITLE_localized;
+		out.ChartSubtitle = inTJA.Metadata.SUBTITLE;
+		out.ChartSubtitleLocalized = inTJA.Metadata.SUBTITLE_localized;
+		out.ChartCreator = inTJA.Metadata.MAKER;
+		out.ChartGenre = inTJA.Metadata.GENRE;
+		out.ChartLyricsFileName = inTJA.Metadata.LYRICS;
+		out.SongOffset = inTJA.Metadata.OFFSET;
+		out.SongDemoStartTime = inTJA.Metadata.DEMOSTART;
+		out.SongFileName = inTJA.Metadata.WAVE;
+		out.SongJacket = inTJA.Metadata.PREIMAGE;
+		out.SongVolume = inTJA.Metadata.SONGVOL;
+		out.SoundEffectVolume = inTJA.Metadata.SEVOL;
+		out.BackgroundImageFileName = inTJA.Metadata.BGIMAGE;
+		out.BackgroundMovieFileName = inTJA.Metadata.BGMOVIE;
+		out.MovieOffset = inTJA.Metadata.MOVIEOFFSET;
+		out.OtherMetadata = inTJA.Metadata.Others;
 
-			if (!inCourse.Measures.empty())
-				out.ChartDuration = Max(out.ChartDuration, outCourse.TempoMap.BeatToTime(inCourse.Measures.back().StartTime /*+ inCourse.Measures.back().TimeSignature.GetDurationPerBar()*/));
+		std::vector<const TJA::ParsedCourse*> inParsedCourses;
+		for (const TJA::ParsedCourse& inParsedCourse : inTJA.Courses)
+		{
+			if (inParsedCourse.HasChart) // metadata-only TJA section
+				inParsedCourses.push_back(&inParsedCourse);
 		}
 
+		// NOTE: Courses are independent of each other past the shared main metadata, so they're converted by a small pool of workers
+		//		 each grabbing the next unconverted course. Output courses are allocated upfront to keep the same (file) order
+		const size_t firstNewCourseIndex = out.Courses.size();
+		for (size_t i = 0; i < inParsedCourses.size(); i++)
+			out.Courses.push_back(std::make_unique<ChartCourse>());
+
+		std::vector<Time> perCourseDurations(inParsedCourses.size(), Time::Zero());
+		std::atomic<size_t> nextCourseIndex = 0;
+		auto convertRemainingCourses = [&]()
+		{
+			for (size_t i = nextCourseIndex++; i < inParsedCourses.size(); i = nextCourseIndex++)
+				perCourseDurations[i] = CreateChartCourseFromTJA(inTJA, *inParsedCourses[i], *out.Courses[firstNewCourseIndex + i]);
+		};
+
+		// NOTE: The calling thread converts courses as well instead of just waiting on the workers
+		const size_t threadCount = Min(inParsedCourses.size(), static_cast<size_t>(ClampBot(std::thread::hardware_concurrency(), 1u)));
+		std::vector<std::future<void>> workerFutures;
+		for (size_t i = 1; i < threadCount; i++)
+			workerFutures.push_back(std::async(std::launch::async, convertRemainingCourses));
+		convertRemainingCourses();
+		for (std::future<void>& future : workerFutures)
+			future.get();
+
+		for (const Time courseDuration : perCourseDurations)
+			out.ChartDuration = Max(out.ChartDuration, courseDuration);
+
 		return true;
 	}
 
@@ -693,7 +965,7 @@ namespace PeepoDrumKit
 					outConvertedMeasureEnd->GoGoChanges.push_back(TJA::ConvertedGoGoChange{ (endTime - outConvertedMeasureEnd->StartTime), false });
 			}
 
-			TJA::ConvertConvertedMeasuresToParsedCommands(outConvertedMeasures, outCourse.ChartCommands);
+			TJA::ConvertConvertedMeasuresToParsedCommands(outConvertedMeasures, outCourse.ChartCommands, out.Arena);
 		}
 
 		return true;
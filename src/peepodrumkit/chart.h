@@ -363,6 +363,25 @@ namespace PeepoDrumKit
 	using SortedJPOSScrollChangesList = BeatSortedList<JPOSScrollChange>;
 	using SortedScrollTypesList = BeatSortedList<ScrollType>;
 
+	// NOTE: Start time and total hit circle displacement of all previous changes for each JPOS scroll change,
+	//		 so that looking up the position at any time only requires a binary search and interpolating within a single change
+	struct JPOSScrollPrefixSumTable
+	{
+		struct Entry
+		{
+			Time StartTime;
+			// NOTE: Max start time of this and all previous changes. Unlike the start times themselves (which go backwards with negative tempos) always sorted
+			Time StartTimeRunningMax;
+			Time Duration;
+			vec2 Move;
+			vec2 MoveBefore;
+		};
+		std::vector<Entry> Entries;
+
+		void Rebuild(const SortedJPOSScrollChangesList& jposScrollChanges, const TempoMapAccelerationStructure& accelerationStructure);
+		vec2 GetMoveAtTime(Time timeStamp) const;
+	};
+
 	constexpr Tempo ScrollSpeedToTempo(f32 scrollSpeed, Tempo baseTempo) { return Tempo(scrollSpeed * baseTempo.BPM); }
 	constexpr f32 ScrollTempoToSpeed(Tempo scrollTempo, Tempo baseTempo) { return (baseTempo.BPM == 0.0f) ? 0.0f : (scrollTempo.BPM / baseTempo.BPM); }
 
@@ -414,7 +433,11 @@ namespace PeepoDrumKit
 				RecalculateSENotes(branch);
 		}
 
-		void RecalculateSENotes(BranchType branch) const; // implemented in chart_editor_widgets_game.cpp
+		void RecalculateSENotes(BranchType branch) const;
+
+		// NOTE: Only recalculates the notes within the SE lookbehind / lookahead window of the edited [beatMin, beatMax] range,
+		//		 which must cover every added, removed or changed note of the branch (after the edit)
+		void RecalculateSENotesInRange(BranchType branch, Beat beatMin, Beat beatMax) const;
 	};
 
 	// NOTE: Internal representation of a chart. Can then be imported / exported as .tja (and maybe as the native fumen binary format too eventually?)
@@ -1100,6 +1123,14 @@ namespace PeepoDrumKit
 		return AvailableMemberFlags<GenericListStructType<List>>;
 	}
 
+	// NOTE: For converting many GenericListStructs to the concrete type of the same list within a single ApplySingleGenericList() call
+	struct GetListStructValueAccessor_T {};
+
+	template <GenericList List>
+	constexpr __forceinline auto get(GetListStructValueAccessor_T) {
+		return [](auto&& inValue) -> decltype(auto) { return get<List>(std::forward<decltype(inValue)>(inValue)); };
+	}
+
 	// course list attribute query functions
 	constexpr b8 IsNotesList(GenericList list) { return (list == GenericList::Notes_Normal) || (list == GenericList::Notes_Expert) || (list == GenericList::Notes_Master); }
 	constexpr b8 ListHasDurations(GenericList list) { return IsNotesList(list) || (list == GenericList::GoGoRanges); }
@@ -1208,6 +1239,35 @@ namespace PeepoDrumKit
 		return TryRemoveGenericStruct(course, list, GetBeat(inValueToRemove, list));
 	}
 
+	// NOTE: Batched versions of the above for many items of the same list, see BeatSortedList::InsertOrFuncRange() and RemoveRange()
+	template <typename Func>
+	b8 TryAddOrFuncGenericStructs(ChartCourse& course, GenericList list, const std::vector<GenericListStructWithType>& inValues, Func funcExist)
+	{
+		return ApplySingleGenericList(list,
+			[&](auto&& typedList, auto&& getTypedValue)
+			{
+				std::vector<typename std::remove_reference_t<decltype(typedList)>::value_type> typedValues;
+				typedValues.reserve(inValues.size());
+				for (const auto& inValue : inValues) { assert(inValue.List == list); typedValues.push_back(getTypedValue(inValue.Value)); }
+				typedList.InsertOrFuncRange(std::move(typedValues), funcExist);
+				return true;
+			}, false,
+			course, GetListStructValueAccessor_T {});
+	}
+
+	inline b8 TryAddOrReplaceGenericStructs(ChartCourse& course, GenericList list, const std::vector<GenericListStructWithType>& inValues)
+	{
+		return TryAddOrFuncGenericStructs(course, list, inValues, [](auto& v, auto&& vNew) { v = vNew; });
+	}
+
+	template <typename TRange>
+	b8 TryRemoveGenericStructs(ChartCourse& course, GenericList list, const TRange& inValuesToRemove)
+	{
+		return ApplySingleGenericList(list,
+			[&](auto&& typedList) { typedList.RemoveRange(inValuesToRemove); return true; }, false,
+			course);
+	}
+
 	template <auto... Tags, typename FAction, typename ForEachChartItemDataT, typename ChartCourseT, typename... Args,
 		expect_type_t<ForEachChartItemDataT, struct ForEachChartItemData> = true,
 		expect_type_t<ChartCourseT, struct ChartCourse> = true>
@@ -3,6 +3,7 @@
 #include "chart_editor_undo.h"
 #include "chart_editor_widgets.h"
 #include "audio/audio_file_formats.h"
+#include "audio/audio_resample.h"
 #include "chart_editor_i18n.h"
 #include "core/core_crypto.h"
 #include <cstddef>
@@ -901,6 +902,7 @@ namespace PeepoDrumKit
 			CheckOpenSaveConfirmationPopupThenCall([&]
 			{
 				if (loadSongFuture.valid()) loadSongFuture.get();
+				loadSongWaveformFuture = {};
 				if (loadJacketFuture.valid()) loadJacketFuture.get();
 				if (importChartFuture.valid()) importChartFuture.get();
 				context.Undo.ClearAll();
@@ -1398,6 +1400,7 @@ namespace PeepoDrumKit
 	void ChartEditor::CreateNewChart(ChartContext& context)
 	{
 		if (loadSongFuture.valid()) loadSongFuture.get();
+		loadSongWaveformFuture = {};
 		if (!context.SongSourceFilePath.empty()) StartAsyncLoadingSongAudioFile("");
 		if (loadJacketFuture.valid()) loadJacketFuture.get();
 		if (!context.SongJacketFilePath.empty()) StartAsyncLoadingSongJacketFile("");
@@ -1927,14 +1930,16 @@ namespace PeepoDrumKit
 		return fileDialog.OpenSelectFolder();
 	}
 
-	void ChartEditor::StartAsyncLoadingSongAudioFile(std::string_view absoluteAudioFilePath)
+	void ChartEditor::StartAsyncLoadingSongAudioFile(std::string_view absoluteAudioFilePath, b8 allowStreaming)
 	{
+		// NOTE: The waveform is generated by the stream of the previous song, which keeps decoding (and then fulfills the abandoned promise) until it gets unloaded
 		if (loadSongFuture.valid())
 			loadSongFuture.get();
+		loadSongWaveformFuture = {};
 
 		context.SongWaveformFadeAnimationTarget = 0.0f;
 		loadSongStopwatch.Restart();
-		loadSongFuture = std::async(std::launch::async, [tempPathCopy = std::string(absoluteAudioFilePath)]()->AsyncLoadSongResult
+		loadSongFuture = std::async(std::launch::async, [tempPathCopy = std::string(absoluteAudioFilePath), allowStreaming]()->AsyncLoadSongResult
 		{
 			AsyncLoadSongResult result {};
 			result.SongFilePath = std::move(tempPathCopy);
@@ -1950,20 +1955,46 @@ namespace PeepoDrumKit
 				return result;
 			}
 
-			if (Audio::DecodeEntireFile(result.SongFilePath, fileContent.get(), fileSize, result.SampleBuffer) != Audio::DecodeFileResult::FeelsGoodMan)
+			// NOTE: If the file doesn't need to be resampled it can be streamed directly and playback can start right away
+			//		 without ever having to keep the entire decoded song in memory. Otherwise (or if the stream can't be opened) fall back to decoding it entirely
+			auto sharedFileContent = std::shared_ptr<const u8[]>(std::move(fileContent));
+			if (allowStreaming)
+			{
+#if !PEEPO_DEBUG // NOTE: Always ignore the second channel in debug builds for performance reasons!
+				static constexpr u32 waveformChannelCount = 2;
+#else
+				static constexpr u32 waveformChannelCount = 1;
+#endif
+				auto stream = std::make_unique<Audio::PCMSampleStream>();
+				if (stream->OpenAndStartDecoding(result.SongFilePath, sharedFileContent, fileSize, waveformChannelCount) == Audio::DecodeFileResult::FeelsGoodMan && stream->SampleRate == Audio::Engine.OutputSampleRate)
+				{
+					result.SampleBuffer.ChannelCount = stream->ChannelCount;
+					result.SampleBuffer.SampleRate = stream->SampleRate;
+					result.SampleBuffer.FrameCount = stream->FrameCount;
+					result.Stream = std::move(stream);
+					return result;
+				}
+			}
+
+			if (Audio::DecodeEntireFile(result.SongFilePath, sharedFileContent.get(), fileSize, result.SampleBuffer) != Audio::DecodeFileResult::FeelsGoodMan)
 			{
 				printf("Failed to decode audio file '%.*s'\n", FmtStrViewArgs(result.SongFilePath));
 				return result;
 			}
 
+			// NOTE: No longer needed, so free it before (potentially) allocating the resampled buffer to keep the peak memory usage down
+			sharedFileContent = nullptr;
+
 			// HACK: ...
 			if (result.SampleBuffer.SampleRate != Audio::Engine.OutputSampleRate)
-				Audio::LinearlyResampleBuffer<i16>(result.SampleBuffer.InterleavedSamples, result.SampleBuffer.FrameCount, result.SampleBuffer.SampleRate, result.SampleBuffer.ChannelCount, Audio::Engine.OutputSampleRate);
+				Audio::ResampleBuffer(result.SampleBuffer.InterleavedSamples, result.SampleBuffer.FrameCount, result.SampleBuffer.SampleRate, result.SampleBuffer.ChannelCount, Audio::Engine.OutputSampleRate);
 
-			if (result.SampleBuffer.ChannelCount > 0) result.WaveformL.GenerateEntireMipChainFromSampleBuffer(result.SampleBuffer, 0);
 #if !PEEPO_DEBUG // NOTE: Always ignore the second channel in debug builds for performance reasons!
-			if (result.SampleBuffer.ChannelCount > 1) result.WaveformR.GenerateEntireMipChainFromSampleBuffer(result.SampleBuffer, 1);
+			if (result.SampleBuffer.ChannelCount > 1)
+				Audio::WaveformMipChain::GenerateStereoMipChainsFromSampleBuffer(result.SampleBuffer, result.WaveformL, result.WaveformR);
+			else
 #endif
+			if (result.SampleBuffer.ChannelCount > 0) result.WaveformL.GenerateEntireMipChainFromSampleBuffer(result.SampleBuffer, 0);
 
 			return result;
 		});
@@ -2121,12 +2152,35 @@ namespace PeepoDrumKit
 			if (context.SongSource != Audio::SourceHandle::Invalid)
 				Audio::Engine.UnloadSource(context.SongSource);
 
-			context.SongSource = Audio::Engine.LoadSourceFromBufferMove(Path::GetFileName(context.SongSourceFilePath), std::move(loadResult.SampleBuffer));
+			if (loadResult.Stream != nullptr)
+			{
+				loadSongWaveformFuture = loadResult.Stream->GetWaveformFuture();
+				context.SongSource = Audio::Engine.LoadSourceFromStreamMove(Path::GetFileName(context.SongSourceFilePath), std::move(loadResult.Stream));
+
+				// NOTE: Only fails if the output sample rate has been changed since (or if there are no free source slots left), so rather load the entire song again than play nothing at all
+				if (context.SongSource == Audio::SourceHandle::Invalid)
+				{
+					printf("Failed to load audio stream '%.*s', decoding the entire file instead\n", FmtStrViewArgs(context.SongSourceFilePath));
+					StartAsyncLoadingSongAudioFile(context.SongSourceFilePath, false);
+				}
+			}
+			else
+			{
+				context.SongSource = Audio::Engine.LoadSourceFromBufferMove(Path::GetFileName(context.SongSourceFilePath), std::move(loadResult.SampleBuffer));
+			}
 			context.SongVoice.SetSource(context.SongSource);
 
 			Audio::Engine.EnsureStreamRunning();
 		}
 
+		if (loadSongWaveformFuture.valid() && future_is_ready(loadSongWaveformFuture))
+		{
+			Audio::PCMSampleStream::WaveformResult waveformResult = loadSongWaveformFuture.get();
+			context.SongWaveformL = std::move(waveformResult.WaveformL);
+			context.SongWaveformR = std::move(waveformResult.WaveformR);
+			context.SongWaveformFadeAnimationTarget = context.SongWaveformL.IsEmpty() ? 0.0f : 1.0f;
+		}
+
 		if (loadJacketFuture.valid() && future_is_ready(loadJacketFuture))
 		{
 			AsyncLoadJacketResult loadResult = loadJacketFuture.get();
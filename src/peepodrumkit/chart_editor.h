@@ -8,6 +8,7 @@
 #include "chart_editor_timeline.h"
 #include "imgui/imgui_include.h"
 #include "audio/audio_engine.h"
+#include "audio/audio_stream.h"
 
 #include "test_gui_audio.h"
 #include "test_gui_tja.h"
@@ -34,6 +35,9 @@ namespace PeepoDrumKit
 		std::string SongFilePath;
 		Audio::PCMSampleBuffer SampleBuffer;
 		Audio::WaveformMipChain WaveformL, WaveformR;
+
+		// NOTE: Set instead of the sample buffer if the file can be streamed as is, in which case the stream generates the waveform itself while decoding
+		std::unique_ptr<Audio::PCMSampleStream> Stream;
 	};
 
 	struct AsyncLoadJacketResult
@@ -68,7 +72,7 @@ namespace PeepoDrumKit
 		void StartAsyncImportingFumenChartDirectory(std::string_view absoluteChartFilePath, bool encrypted = false);
 		void StartAsyncExportFumenFile(std::string_view absoluteChartFilePath, bool encrypted = false);
 		void StartAsyncExportFumenChartDirectory(std::string_view absoluteChartFilePath, bool encrypted = false);
-		void StartAsyncLoadingSongAudioFile(std::string_view absoluteAudioFilePath);
+		void StartAsyncLoadingSongAudioFile(std::string_view absoluteAudioFilePath, b8 allowStreaming = true);
 		void StartAsyncLoadingSongJacketFile(std::string_view absoluteJacketFilePath);
 		void SetAndStartLoadingChartSongFileName(std::string_view relativeOrAbsoluteAudioFilePath, Undo::UndoHistory& undo);
 		void SetAndStartLoadingSongJacketFileName(std::string_view relativeOrAbsoluteAudioFilePath, Undo::UndoHistory& undo);
@@ -91,6 +95,7 @@ namespace PeepoDrumKit
 
 		std::future<AsyncImportChartResult> importChartFuture {};
 		std::future<AsyncLoadSongResult> loadSongFuture {};
+		std::future<Audio::PCMSampleStream::WaveformResult> loadSongWaveformFuture {};
 		std::future<AsyncLoadJacketResult> loadJacketFuture {};
 		Shell::FileDialog fileDialog {};
 		CPUStopwatch loadSongStopwatch = {};
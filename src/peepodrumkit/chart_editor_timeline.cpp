@@ -300,10 +300,14 @@ namespace PeepoDrumKit
 
 		const auto minMaxVisibleTime = timeline.GetMinMaxVisibleTime(visibleTimeOverdraw);
 		const i32 gridLineModToSkip = (1 << gridLineSubDivisions);
-		i32 gridLineIndex = 0;
 
+		// NOTE: Start at the first visible bar but keep counting grid lines as if starting from the very first one, so that the skipped lines stay the same while scrolling
 		const Time chartDuration = context.Chart.GetDurationOrDefault();
-		context.ChartSelectedCourse->TempoMap.ForEachBeatBar([&](const SortedTempoMap::ForEachBeatBarData& it)
+		const SortedTempoMap& tempoMap = context.ChartSelectedCourse->TempoMap;
+		const Beat startBeat = Min(tempoMap.TimeToBeat(minMaxVisibleTime.Min), tempoMap.TimeToBeat(chartDuration));
+		i32 gridLineIndex = tempoMap.FindBarAtBeat(startBeat).BeatIndex;
+
+		tempoMap.ForEachBeatBarFrom(startBeat, [&](const SortedTempoMap::ForEachBeatBarData& it)
 		{
 			const Time timeIt = context.ChartSelectedCourse->TempoMap.BeatToTime(it.Beat);
 
@@ -542,7 +546,8 @@ namespace PeepoDrumKit
 	{
 		const f32 waveformAnimationScale = Clamp(waveformAnimation, 0.0f, 1.0f);
 		const f32 waveformAnimationAlpha = (waveformAnimationScale * waveformAnimationScale);
-		const u32 waveformColor = Gui::ColorU32WithAlpha(TimelineWaveformBaseColor, waveformAnimationAlpha * 0.215f * (waveformR.IsEmpty() ? 2.0f : 1.0f));
+		const u32 waveformRMSColor = Gui::ColorU32WithAlpha(TimelineWaveformBaseColor, waveformAnimationAlpha * 0.215f * (waveformR.IsEmpty() ? 2.0f : 1.0f));
+		const u32 waveformPeakColor = Gui::ColorU32WithAlpha(TimelineWaveformBaseColor, waveformAnimationAlpha * 0.5f * 0.215f * (waveformR.IsEmpty() ? 2.0f : 1.0f));
 
 		const Time waveformTimePerPixel = timeline.Camera.LocalSpaceXToTime(1.0f) - timeline.Camera.LocalSpaceXToTime(0.0f);
 		const Time waveformDuration = waveformL.Duration;
@@ -557,22 +562,26 @@ namespace PeepoDrumKit
 			if (waveform.IsEmpty())
 				continue;
 
-			const auto& waveformMip = waveform.FindClosestMip(waveformTimePerPixel);
+			// NOTE: Draw the (lighter) peak envelope with the RMS on top, each pixel only ever reads two precomputed mip samples
+			const auto& waveformMip = waveform.FindMipForTimeRange(waveformTimePerPixel);
 			for (i32 visiblePixel = 0; visiblePixel < contentRect.GetWidth(); /*visiblePixel++*/)
 			{
-				CustomDraw::WaveformChunk chunk;
+				CustomDraw::WaveformChunk peakChunk, rmsChunk;
 				const Rect chunkRect = Rect::FromTLSize(timeline.LocalToScreenSpace(vec2(static_cast<f32>(visiblePixel), 0.5f)), vec2(static_cast<f32>(CustomDraw::WaveformPixelsPerChunk), rowsHeight));
 
 				for (i32 chunkPixel = 0; chunkPixel < CustomDraw::WaveformPixelsPerChunk; chunkPixel++)
 				{
 					const Time timeAtPixel = timeline.Camera.LocalSpaceXToTime(static_cast<f32>(visiblePixel)) - chartSongOffset;
 					const b8 outOfBounds = (timeAtPixel < Time::Zero() || (timeAtPixel > waveformDuration));
+					const Audio::WaveformAmplitude amplitude = outOfBounds ? Audio::WaveformAmplitude { 0.0f, 0.0f } : waveform.GetAmplitudeAt(waveformMip, timeAtPixel, waveformTimePerPixel);
 
-					chunk.PerPixelAmplitude[chunkPixel] = outOfBounds ? 0.0f : (waveformAnimationScale * ClampBot(waveform.GetAmplitudeAt(waveformMip, timeAtPixel, waveformTimePerPixel), minAmplitude));
+					peakChunk.PerPixelAmplitude[chunkPixel] = outOfBounds ? 0.0f : (waveformAnimationScale * ClampBot(amplitude.Peak, minAmplitude));
+					rmsChunk.PerPixelAmplitude[chunkPixel] = outOfBounds ? 0.0f : (waveformAnimationScale * ClampBot(amplitude.RMS, minAmplitude));
 					visiblePixel++;
 				}
 
-				CustomDraw::DrawWaveformChunk(drawList, chunkRect, waveformColor, chunk);
+				CustomDraw::DrawWaveformChunk(drawList, chunkRect, waveformPeakColor, peakChunk);
+				CustomDraw::DrawWaveformChunk(drawList, chunkRect, waveformRMSColor, rmsChunk);
 			}
 		}
 	}
@@ -583,11 +592,55 @@ namespace PeepoDrumKit
 		ChartContext& Context;
 		ImDrawList* DrawListContent;
 		ChartTimeline::MinMaxTime VisibleTime;
+		Beat VisibleBeatMin, VisibleBeatMax;
 		b8 IsPlayback;
 		Time CursorTime;
 		Beat CursorBeatOnPlaybackStart;
 	};
 
+	static const ChartTimeline::NotesIntervalIndexCacheData& GetUpdatedNotesIntervalIndex(ChartTimeline& timeline, const SortedNotesList& notes, BranchType branch, u64 changeGeneration)
+	{
+		// NOTE: Also comparing the item count as a cheap safety net for any edits that didn't go through the undo history
+		ChartTimeline::NotesIntervalIndexCacheData& cache = timeline.NotesIntervalIndexCaches[EnumToIndex(branch)];
+		if (cache.ChangeGeneration != changeGeneration || cache.Notes != &notes || cache.Index.ItemCount != notes.size())
+		{
+			cache.ChangeGeneration = changeGeneration;
+			cache.Notes = &notes;
+			cache.Index.Rebuild(notes);
+			cache.MaxAbsTimeOffset = Time::Zero();
+			for (const Note& note : notes)
+				cache.MaxAbsTimeOffset = Max(cache.MaxAbsTimeOffset, Time::FromSec(Absolute(note.TimeOffset.ToSec())));
+		}
+		return cache;
+	}
+
+	template <typename T, TimelineRowType RowType>
+	static size_t FindFirstItemIndexEndingAfterTime(ChartTimeline& timeline, ChartContext& context, const BeatSortedList<T>& list, Time time)
+	{
+		static_assert(std::is_same_v<T, JPOSScrollChange> || std::is_same_v<T, LyricChange>);
+
+		// NOTE: Same as for the notes also rebuilt once the item count changes, and the tempo map only ever changes through the undo history too
+		ChartTimeline::ItemEndTimeRunningMaxCacheData& cache = timeline.ItemEndTimeRunningMaxCaches[EnumToIndex(RowType)];
+		if (cache.ChangeGeneration != context.Undo.ChangeGeneration || cache.List != &list || cache.EndTimeRunningMax.size() != list.size())
+		{
+			cache.ChangeGeneration = context.Undo.ChangeGeneration;
+			cache.List = &list;
+			cache.EndTimeRunningMax.resize(list.size());
+			for (size_t i = 0; i < list.size(); i++)
+			{
+				Time endTime;
+				if constexpr (std::is_same_v<T, JPOSScrollChange>)
+					endTime = context.BeatToTime(list[i].BeatTime) + Time::FromSec(list[i].Duration);
+				else // NOTE: The last lyric lasts until the end of the chart, which isn't part of the undo history so just treat it as open ended
+					endTime = (i + 1 < list.size()) ? context.BeatToTime(list[i + 1].BeatTime) : Time::FromSec(F64Max);
+				cache.EndTimeRunningMax[i] = (i > 0) ? Max(cache.EndTimeRunningMax[i - 1], endTime) : endTime;
+			}
+		}
+
+		const auto it = std::partition_point(cache.EndTimeRunningMax.begin(), cache.EndTimeRunningMax.end(), [&](const Time& endTime) { return endTime < time; });
+		return static_cast<size_t>(std::distance(cache.EndTimeRunningMax.begin(), it));
+	}
+
 	template <typename T, TimelineRowType RowType>
 	static void DrawTimelineContentItemRowT(DrawTimelineContentItemRowParam param, const ForEachRowData& rowIt, const BeatSortedList<T>& list)
 	{
@@ -597,7 +650,7 @@ namespace PeepoDrumKit
 		const TimelineCamera& camera = timeline.Camera;
 		const ChartTimeline::MinMaxTime visibleTime = param.VisibleTime;
 
-		// TODO: Do culling by first determining min/max visible beat times then use those to continue / break inside loop (although problematic with TimeOffset?)
+		// NOTE: Only walk the (binary searched) slice of each list around the visible beat range, so that the cost per frame doesn't scale with chart length
 		if constexpr (std::is_same_v<T, Note>)
 		{
 			// TODO: Draw unselected branch notes grayed and at a slightly smaller scale (also nicely animate between selecting different branched!)
@@ -605,12 +658,18 @@ namespace PeepoDrumKit
 			// TODO: It looks like there'll also have to be one scroll speed lane per branch type
 			//		 which means the scroll speed change line should probably extend all to the way down to its corresponding note lane (?)
 
-			for (const Note& it : list)
+			static constexpr BranchType branchForThisRow = TimelineRowToBranchType(RowType);
+
+			// NOTE: Notes may be nested inside of long notes so their end beats aren't sorted, hence the interval index to also find (arbitrarily) long notes starting before the visible range
+			const ChartTimeline::NotesIntervalIndexCacheData& notesIntervalIndex = GetUpdatedNotesIntervalIndex(timeline, list, branchForThisRow, context.Undo.ChangeGeneration);
+			const Beat visibleNoteBeatMin = context.TimeToBeat(visibleTime.Min - notesIntervalIndex.MaxAbsTimeOffset) - Beat::FromTicks(1);
+			const Beat visibleNoteBeatMax = context.TimeToBeat(visibleTime.Max + notesIntervalIndex.MaxAbsTimeOffset) + Beat::FromTicks(1);
+			notesIntervalIndex.Index.ForEachOverlappingBeat(list, visibleNoteBeatMin, visibleNoteBeatMax, true, [&](const Note& it)
 			{
 				const Time startTime = context.BeatToTime(it.GetStart()) + it.TimeOffset;
 				const Time endTime = (it.BeatDuration > Beat::Zero()) ? context.BeatToTime(it.GetEnd()) + it.TimeOffset : startTime;
 				if (endTime < visibleTime.Min || startTime > visibleTime.Max)
-					continue;
+					return;
 
 				const vec2 localTL = vec2(timeline.Camera.TimeToLocalSpaceX(startTime), rowIt.LocalY);
 				const vec2 localCenter = localTL + vec2(0.0f, rowIt.LocalHeight * 0.5f);
@@ -640,9 +699,8 @@ namespace PeepoDrumKit
 					if (it.BeatDuration > Beat::Zero())
 						timeline.TempSelectionBoxesDrawBuffer.push_back(ChartTimeline::TempDrawSelectionBox{ Rect::FromCenterSize(timeline.LocalToScreenSpace(localCenterEnd - vec2(localSpaceTimeOffsetX, 0.0f)), hitBoxSize), TimelineSelectedNoteBoxBackgroundColor, TimelineSelectedNoteBoxBorderColor });
 				}
-			}
+			});
 
-			static constexpr BranchType branchForThisRow = TimelineRowToBranchType(RowType);
 			if (!timeline.TempDeletedNoteAnimationsBuffer.empty())
 			{
 				for (const auto& data : timeline.TempDeletedNoteAnimationsBuffer)
@@ -691,7 +749,7 @@ namespace PeepoDrumKit
 		}
 		else if constexpr (std::is_same_v<T, GoGoRange>)
 		{
-			for (const GoGoRange& it : list)
+			for (const GoGoRange& it : list.FindOverlappingRange(param.VisibleBeatMin, param.VisibleBeatMax))
 			{
 				const Time startTime = context.BeatToTime(it.GetStart());
 				const Time endTime = context.BeatToTime(it.GetEnd());
@@ -708,8 +766,11 @@ namespace PeepoDrumKit
 		{
 			const Beat chartBeatDuration = context.TimeToBeat(context.Chart.GetDurationOrDefault());
 
+			// NOTE: Start at the first lyric still reaching into the visible range because each one extends all the way up until the next one
+			const size_t visibleIndexBegin = FindFirstItemIndexEndingAfterTime<T, RowType>(timeline, context, list, visibleTime.Min);
+
 			Gui::PushFont(FontMain, GuiScaleI32_AtTarget(FontBaseSizes::Small));
-			for (size_t i = 0; i < list.size(); i++)
+			for (size_t i = visibleIndexBegin; i < list.size(); i++)
 			{
 				const LyricChange* prevLyric = IndexOrNull(static_cast<i32>(i) - 1, list);
 				const LyricChange& thisLyric = list[i];
@@ -720,7 +781,9 @@ namespace PeepoDrumKit
 				const Beat nowBeat = (thisLyric.BeatTime <= chartBeatDuration) ? chartBeatDuration : Beat::FromTicks(I32Max);
 				const Time startTime = context.BeatToTime(thisLyric.BeatTime);
 				const Time endTime = context.BeatToTime(thisLyric.Lyric.empty() ? thisLyric.BeatTime : (nextLyric != nullptr) ? nextLyric->BeatTime : nowBeat);
-				if (endTime < visibleTime.Min || startTime > visibleTime.Max)
+				if (startTime > visibleTime.Max)
+					break;
+				if (endTime < visibleTime.Min)
 					continue;
 
 				const vec2 localSpaceTL = vec2(camera.TimeToLocalSpaceX(startTime), rowIt.LocalY);
@@ -759,8 +822,16 @@ namespace PeepoDrumKit
 			const b8 useCompactFormat = (camera.ZoomTarget.x < compactFormatStringZoomLevelThreshold);
 			const f32 textHeight = Gui::GetFontSize();
 
-			for (const auto& it : list)
+			// NOTE: A JPOS scroll may last for any number of seconds so start at the first one still reaching into the visible range (same as for the lyrics)
+			size_t visibleIndexBegin = 0;
+			if constexpr (std::is_same_v<T, JPOSScrollChange>)
+				visibleIndexBegin = FindFirstItemIndexEndingAfterTime<T, RowType>(timeline, context, list, visibleTime.Min);
+			else
+				visibleIndexBegin = BinarySearchForInsertionIndex(list, param.VisibleBeatMin);
+			const size_t visibleIndexEnd = BinarySearchForIndexAfterBeat(list, param.VisibleBeatMax);
+			for (size_t i = visibleIndexBegin; i < visibleIndexEnd; i++)
 			{
+				const T& it = list[i];
 				const Time startTime = context.BeatToTime(GetBeat(it));
 				Time endTime = startTime;
 				if constexpr (std::is_same_v<T, JPOSScrollChange>) {
@@ -826,7 +897,8 @@ namespace PeepoDrumKit
 		assert(!waveformL.IsEmpty());
 		const f32 waveformAnimationScale = Clamp(waveformAnimation, 0.0f, 1.0f);
 		const f32 waveformAnimationAlpha = (waveformAnimationScale * waveformAnimationScale);
-		const u32 waveformColor = Gui::ColorU32WithAlpha(TimelineWaveformBaseColor, waveformAnimationAlpha * 0.5f * (waveformR.IsEmpty() ? 2.0f : 1.0f));
+		const u32 waveformRMSColor = Gui::ColorU32WithAlpha(TimelineWaveformBaseColor, waveformAnimationAlpha * 0.5f * (waveformR.IsEmpty() ? 2.0f : 1.0f));
+		const u32 waveformPeakColor = Gui::ColorU32WithAlpha(TimelineWaveformBaseColor, waveformAnimationAlpha * 0.5f * 0.5f * (waveformR.IsEmpty() ? 2.0f : 1.0f));
 
 		const Time waveformTimePerPixel = Time::FromSec(chartDuration.ToSec() / ClampBot(timeline.Regions.ContentScrollbarX.GetWidth(), 1.0f));
 		const Time waveformDuration = waveformL.Duration;
@@ -841,45 +913,104 @@ namespace PeepoDrumKit
 			if (waveform.IsEmpty())
 				continue;
 
-			const auto& waveformMip = waveform.FindClosestMip(waveformTimePerPixel);
+			// NOTE: Draw the (lighter) peak envelope with the RMS on top, each pixel only ever reads two precomputed mip samples
+			const auto& waveformMip = waveform.FindMipForTimeRange(waveformTimePerPixel);
 			for (i32 visiblePixel = 0; visiblePixel < scrollbarRect.GetWidth(); /*visiblePixel++*/)
 			{
-				CustomDraw::WaveformChunk chunk;
+				CustomDraw::WaveformChunk peakChunk, rmsChunk;
 				const Rect chunkRect = Rect::FromTLSize(timeline.LocalToScreenSpace_ScrollbarX(vec2(static_cast<f32>(visiblePixel), 0.5f)), vec2(static_cast<f32>(CustomDraw::WaveformPixelsPerChunk), scrollbarHeight));
 
 				for (i32 chunkPixel = 0; chunkPixel < CustomDraw::WaveformPixelsPerChunk; chunkPixel++)
 				{
 					const Time timeAtPixel = (waveformTimePerPixel * static_cast<f64>(visiblePixel)) - chartSongOffset;
 					const b8 outOfBounds = (timeAtPixel < Time::Zero() || (timeAtPixel > waveformDuration));
+					const Audio::WaveformAmplitude amplitude = outOfBounds ? Audio::WaveformAmplitude { 0.0f, 0.0f } : waveform.GetAmplitudeAt(waveformMip, timeAtPixel, waveformTimePerPixel);
 
-					chunk.PerPixelAmplitude[chunkPixel] = outOfBounds ? 0.0f : (waveformAnimationScale * ClampBot(waveform.GetAmplitudeAt(waveformMip, timeAtPixel, waveformTimePerPixel), minAmplitude));
+					peakChunk.PerPixelAmplitude[chunkPixel] = outOfBounds ? 0.0f : (waveformAnimationScale * ClampBot(amplitude.Peak, minAmplitude));
+					rmsChunk.PerPixelAmplitude[chunkPixel] = outOfBounds ? 0.0f : (waveformAnimationScale * ClampBot(amplitude.RMS, minAmplitude));
 					visiblePixel++;
 				}
 
-				CustomDraw::DrawWaveformChunk(drawList, chunkRect, waveformColor, chunk);
+				CustomDraw::DrawWaveformChunk(drawList, chunkRect, waveformPeakColor, peakChunk);
+				CustomDraw::DrawWaveformChunk(drawList, chunkRect, waveformRMSColor, rmsChunk);
 			}
 		}
 	}
 
-	static void DrawTimelineScrollbarXMinimap(const ChartTimeline& timeline, ImDrawList* drawList, const ChartCourse& course, BranchType branch, Time chartDuration)
+	static void DrawTimelineScrollbarXMinimap(ChartTimeline& timeline, ImDrawList* drawList, const ChartCourse& course, BranchType branch, Time chartDuration, u64 changeGeneration)
 	{
 		const vec2 localNoteRectSize = GuiScale(vec2(2.0f, 4.0f)); // timeline.Regions.ContentScrollbarX.GetHeight() * 0.25f;
 		const f32 localNoteCenterY = timeline.Regions.ContentScrollbarX.GetHeight() * /*0.5f*//*0.75f*/0.25f;
+		const SortedNotesList& notes = course.GetNotes(branch);
 
-		// TODO: Also draw other timeline items... tempo / signature changes, gogo-time etc. (?)
-		for (const Note& note : course.GetNotes(branch))
+		auto getLocalNoteMinMaxX = [&](const Note& note) -> vec2
 		{
 			const f32 localHeadX = TimeToScrollbarLocalSpaceX(course.TempoMap.BeatToTime(note.GetStart()) + note.TimeOffset, timeline.Regions, chartDuration);
-			Rect screenNoteRect = Rect::FromCenterSize(timeline.LocalToScreenSpace_ScrollbarX(vec2(localHeadX, localNoteCenterY)), localNoteRectSize);
+			const f32 localTailX = (note.BeatDuration > Beat::Zero()) ? TimeToScrollbarLocalSpaceX(course.TempoMap.BeatToTime(note.GetEnd()) + note.TimeOffset, timeline.Regions, chartDuration) : localHeadX;
+			return vec2(localHeadX - (localNoteRectSize.x * 0.5f), localTailX + (localNoteRectSize.x * 0.5f));
+		};
 
-			if (note.BeatDuration > Beat::Zero())
+		// NOTE: One texel per local space pixel, rasterizing all notes on the CPU is still a lot cheaper than submitting a quad per note every single frame
+		auto& cache = timeline.ScrollbarMinimapCache;
+		const ivec2 textureSize = ivec2(static_cast<i32>(Ceil(timeline.Regions.ContentScrollbarX.GetWidth())), static_cast<i32>(Ceil(localNoteRectSize.y)));
+		if (textureSize.x <= 0 || textureSize.y <= 0)
+			return;
+
+		const b8 textureNeedsUpdate = (!cache.Texture.IsValid() || cache.ChangeGeneration != changeGeneration || cache.Course != &course || cache.Branch != branch || cache.ChartDuration != chartDuration || cache.Size != textureSize);
+		if (textureNeedsUpdate)
+		{
+			cache.ChangeGeneration = changeGeneration;
+			cache.Course = &course;
+			cache.Branch = branch;
+			cache.ChartDuration = chartDuration;
+			cache.Size = textureSize;
+
+			// NOTE: Only a single row of texels has to be rasterized since every note spans the full texture height
+			cache.Pixels.assign(static_cast<size_t>(textureSize.x) * textureSize.y, 0x00000000);
+			u32* rowPixels = cache.Pixels.data();
+			for (const Note& note : notes)
+			{
+				const vec2 localMinMaxX = getLocalNoteMinMaxX(note);
+				const i32 texelBegin = Clamp(static_cast<i32>(Floor(localMinMaxX.x)), 0, textureSize.x);
+				const i32 texelEnd = Clamp(static_cast<i32>(Ceil(localMinMaxX.y)), texelBegin, textureSize.x);
+				std::fill(rowPixels + texelBegin, rowPixels + texelEnd, *NoteTypeToColorMap[EnumToIndex(note.Type)]);
+			}
+			for (i32 y = 1; y < textureSize.y; y++)
+				std::copy(rowPixels, rowPixels + textureSize.x, rowPixels + (static_cast<size_t>(y) * textureSize.x));
+
+			// NOTE: Packed ImGui colors are stored as R8G8B8A8 in memory
+			if (cache.Texture.IsValid())
+				cache.Texture.Unload();
+			cache.Texture.Load(CustomDraw::GPUTextureDesc { CustomDraw::GPUPixelFormat::RGBA, CustomDraw::GPUAccessType::Static, textureSize, cache.Pixels.data() });
+		}
+
+		const vec2 screenTextureTL = timeline.LocalToScreenSpace_ScrollbarX(vec2(0.0f, localNoteCenterY - (localNoteRectSize.y * 0.5f)));
+		drawList->AddImage(cache.Texture.GetTexID(), screenTextureTL, screenTextureTL + vec2(textureSize));
+
+		// NOTE: Selected notes are still highlighted on top individually, but only their rects have to be recalculated whenever the selection changes
+		// TODO: Also draw other timeline items... tempo / signature changes, gogo-time etc. (?)
+		const ChartTimeline::SelectedNotesData& selectedNotes = timeline.SelectedNotesThisFrame;
+		const b8 selectedNotesMatch = (selectedNotes.Course == &course && selectedNotes.Branch == branch);
+		if (textureNeedsUpdate || (selectedNotesMatch ? (cache.SelectedNoteIndices != selectedNotes.Indices) : !cache.SelectedNoteIndices.empty()))
+		{
+			if (selectedNotesMatch)
+				cache.SelectedNoteIndices = selectedNotes.Indices;
+			else
+				cache.SelectedNoteIndices.clear();
+
+			cache.SelectedNoteLocalMinMaxX.clear();
+			for (const size_t noteIndex : cache.SelectedNoteIndices)
 			{
-				const f32 localTailX = TimeToScrollbarLocalSpaceX(course.TempoMap.BeatToTime(note.GetEnd()) + note.TimeOffset, timeline.Regions, chartDuration);
-				screenNoteRect.BR.x += (localTailX - localHeadX);
+				if (noteIndex < notes.size())
+					cache.SelectedNoteLocalMinMaxX.push_back(getLocalNoteMinMaxX(notes[noteIndex]));
 			}
+		}
 
-			drawList->AddRectFilled(screenNoteRect.TL, screenNoteRect.BR, note.IsSelected ? NoteColorWhite : *NoteTypeToColorMap[EnumToIndex(note.Type)]);
-			// drawList->AddRect(screenNoteRect.TL, screenNoteRect.BR, NoteColorWhite, 0.0f, ImDrawFlags_None, 2.0f);
+		for (const vec2& localMinMaxX : cache.SelectedNoteLocalMinMaxX)
+		{
+			const vec2 screenNoteTL = timeline.LocalToScreenSpace_ScrollbarX(vec2(localMinMaxX.x, localNoteCenterY - (localNoteRectSize.y * 0.5f)));
+			const vec2 screenNoteBR = timeline.LocalToScreenSpace_ScrollbarX(vec2(localMinMaxX.y, localNoteCenterY + (localNoteRectSize.y * 0.5f)));
+			drawList->AddRectFilled(screenNoteTL, screenNoteBR, NoteColorWhite);
 		}
 	}
 
@@ -1001,6 +1132,12 @@ namespace PeepoDrumKit
 		}
 	}
 
+	ChartTimeline::~ChartTimeline()
+	{
+		if (ScrollbarMinimapCache.Texture.IsValid())
+			ScrollbarMinimapCache.Texture.Unload();
+	}
+
 	void ChartTimeline::DrawGui(ChartContext& context)
 	{
 		UpdateInputAtStartOfFrame(context);
@@ -1129,7 +1266,7 @@ namespace PeepoDrumKit
 					if (!context.SongWaveformL.IsEmpty())
 						DrawTimelineScrollbarXWaveform(*this, Gui::GetWindowDrawList(), context.Chart.SongOffset, chartDuration, context.SongWaveformL, context.SongWaveformR, context.SongWaveformFadeAnimationCurrent);
 
-					DrawTimelineScrollbarXMinimap(*this, Gui::GetWindowDrawList(), *context.ChartSelectedCourse, context.ChartSelectedBranch, chartDuration);
+					DrawTimelineScrollbarXMinimap(*this, Gui::GetWindowDrawList(), *context.ChartSelectedCourse, context.ChartSelectedBranch, chartDuration, context.Undo.ChangeGeneration);
 
 					const f32 animatedCursorLocalSpaceX = TimeToScrollbarLocalSpaceXClamped(Camera.WorldSpaceXToTime(WorldSpaceCursorXAnimationCurrent), Regions, chartDuration);
 					const f32 currentCursorLocalSpaceX = TimeToScrollbarLocalSpaceXClamped(cursorTime, Regions, chartDuration);
@@ -1470,10 +1607,22 @@ namespace PeepoDrumKit
 				const Beat baseBeat = FloorBeatToCurrentGrid(context.GetCursorBeat()) - findBaseBeat(clipboardItems);
 				for (auto& item : clipboardItems) { SetBeat(GetBeat(item) + baseBeat, item); }
 
+				// NOTE: Built lazily for each list that is pasted into, so that validating many pasted items doesn't rescan dense drumroll sections per item
+				BeatIntervalAccelerationStructure listIntervalIndices[EnumCount<GenericList>];
+				b8 listIntervalIndicesBuilt[EnumCount<GenericList>] = {};
+
 				auto itemAlreadyExistsOrIsBad = [&](const GenericListStructWithType& item)
 				{
 					const b8 inclusiveBeatCheck = ListUsesInclusiveBeatCheck(item.List);
-					auto check = [&](auto& list, auto& i) { return (GetBeat(i) < Beat::Zero()) || (list.TryFindOverlappingBeatUntrusted(GetBeat(i), GetBeat(i) + GetBeatDuration(i), inclusiveBeatCheck) != nullptr); };
+					auto check = [&](auto& list, auto& i)
+					{
+						if (GetBeat(i) < Beat::Zero())
+							return true;
+
+						BeatIntervalAccelerationStructure& intervalIndex = listIntervalIndices[EnumToIndex(item.List)];
+						if (!listIntervalIndicesBuilt[EnumToIndex(item.List)]) { intervalIndex.Rebuild(list); listIntervalIndicesBuilt[EnumToIndex(item.List)] = true; }
+						return (intervalIndex.TryFindOverlappingBeat(list, GetBeat(i), GetBeat(i) + GetBeatDuration(i), inclusiveBeatCheck) != nullptr);
+					};
 					switch (item.List)
 					{
 					case GenericList::TempoChanges: return check(course.TempoMap.Tempo, item.Value.POD.Tempo);
@@ -2336,12 +2485,18 @@ namespace PeepoDrumKit
 			{
 				ChartCourse& selectedCourse = *context.ChartSelectedCourse;
 
+				SelectedNotesThisFrame.Indices.clear();
+				SelectedNotesThisFrame.Course = &selectedCourse;
+				SelectedNotesThisFrame.Branch = context.ChartSelectedBranch;
+
 				size_t selectedItemCount = 0; b8 allSelectedItemsAreNotes = true; b8 atLeastOneSelectedItemIsTempoChange = false;
 				ForEachSelectedChartItem(selectedCourse, [&](const ForEachChartItemData& it)
 				{
 					selectedItemCount++;
 					allSelectedItemsAreNotes &= IsNotesList(it.List);
 					atLeastOneSelectedItemIsTempoChange |= (it.List == GenericList::TempoChanges);
+					if (IsNotesList(it.List) && TimelineRowToBranchType(GenericListToTimelineRow(it.List)) == context.ChartSelectedBranch)
+						SelectedNotesThisFrame.Indices.push_back(it.Index);
 				});
 
 				if (SelectedItemDrag.ActiveTarget != EDragTarget::None && !Gui::IsMouseDown(ImGuiMouseButton_Left))
@@ -2871,10 +3026,11 @@ namespace PeepoDrumKit
 						std::vector<Note> newNotesToAdd;
 						newNotesToAdd.reserve(maxExpectedNoteCountToAdd);
 
+						const BeatIntervalAccelerationStructure& notesIntervalIndex = GetUpdatedNotesIntervalIndex(*this, notes, context.ChartSelectedBranch, context.Undo.ChangeGeneration).Index;
 						for (i32 i = 0; i < maxExpectedNoteCountToAdd; i++)
 						{
 							const Beat beatForThisNote = Beat(Min(startTick, endTick).Ticks + (i * beatPerNote.Ticks));
-							if (notes.TryFindOverlappingBeat(beatForThisNote, beatForThisNote) == nullptr)
+							if (notesIntervalIndex.TryFindOverlappingBeat(notes, beatForThisNote, beatForThisNote) == nullptr)
 							{
 								Note& newNote = newNotesToAdd.emplace_back();
 								newNote.BeatTime = beatForThisNote;
@@ -2894,7 +3050,7 @@ namespace PeepoDrumKit
 						const b8 isPlayback = context.GetIsPlayback();
 						const Beat cursorBeat = isPlayback ? RoundBeatToCurrentGrid(context.GetCursorBeat()) : FloorBeatToCurrentGrid(context.GetCursorBeat());
 
-						Note* existingNoteAtCursor = notes.TryFindOverlappingBeat(cursorBeat, cursorBeat);
+						Note* existingNoteAtCursor = GetUpdatedNotesIntervalIndex(*this, notes, context.ChartSelectedBranch, context.Undo.ChangeGeneration).Index.TryFindOverlappingBeat(notes, cursorBeat, cursorBeat);
 						if (existingNoteAtCursor != nullptr)
 						{
 							if (existingNoteAtCursor->BeatTime == cursorBeat)
@@ -3357,7 +3513,10 @@ namespace PeepoDrumKit
 		// NOTE: Row labels, lines and items
 		{
 			const Time visibleTimeOverdraw = Camera.TimePerScreenPixel() * (Gui::GetFrameHeight() * 4.0f);
-			const DrawTimelineContentItemRowParam rowParam = { *this, context, DrawListContent, GetMinMaxVisibleTime(visibleTimeOverdraw), isPlayback, cursorTime, cursorBeatOnPlaybackStart };
+			const MinMaxTime visibleTime = GetMinMaxVisibleTime(visibleTimeOverdraw);
+			const Beat visibleBeatMin = context.TimeToBeat(visibleTime.Min) - Beat::FromTicks(1);
+			const Beat visibleBeatMax = context.TimeToBeat(visibleTime.Max) + Beat::FromTicks(1);
+			const DrawTimelineContentItemRowParam rowParam = { *this, context, DrawListContent, visibleTime, visibleBeatMin, visibleBeatMax, isPlayback, cursorTime, cursorBeatOnPlaybackStart };
 			Gui::PushFont(FontMain, GuiScaleI32_AtTarget(FontBaseSizes::Medium));
 			ForEachTimelineRow(*this, [&](const ForEachRowData& rowIt)
 			{
@@ -287,7 +287,53 @@ namespace PeepoDrumKit
 		struct TempDrawSelectionBox { Rect ScreenSpaceRect; u32 FillColor, BorderColor; };
 		std::vector<TempDrawSelectionBox> TempSelectionBoxesDrawBuffer;
 
+		// NOTE: The scrollbar note minimap is rasterized once into a texture and only redrawn if any of its inputs changed
+		struct ScrollbarMinimapCacheData
+		{
+			CustomDraw::GPUTexture Texture = {};
+			std::vector<u32> Pixels;
+			u64 ChangeGeneration = 0;
+			const ChartCourse* Course = nullptr;
+			BranchType Branch = BranchType::Normal;
+			Time ChartDuration = {};
+			ivec2 Size = {};
+			// NOTE: Selection changes don't go through the undo history, so the selected note rects are cached separately by their note indices
+			std::vector<size_t> SelectedNoteIndices;
+			std::vector<vec2> SelectedNoteLocalMinMaxX;
+		} ScrollbarMinimapCache = {};
+
+		// NOTE: Gathered at the start of each frame while counting the selected items anyway, so that drawing doesn't have to walk all notes again
+		struct SelectedNotesData
+		{
+			std::vector<size_t> Indices;
+			const ChartCourse* Course = nullptr;
+			BranchType Branch = BranchType::Normal;
+		} SelectedNotesThisFrame = {};
+
+		// NOTE: Interval index of the notes of each branch for the note row culling and the note placement cursor queries, only rebuilt once the notes have been edited.
+		//		 Using this instead of a plain binary search also finds long notes with other notes "inside" (as can be found in some imported charts)
+		struct NotesIntervalIndexCacheData
+		{
+			BeatIntervalAccelerationStructure Index = {};
+			// NOTE: Notes are drawn at their beat plus TimeOffset, so the visible beat range has to be widened by the largest offset to not cull any moved into view
+			Time MaxAbsTimeOffset = Time::Zero();
+			u64 ChangeGeneration = 0;
+			const SortedNotesList* Notes = nullptr;
+		} NotesIntervalIndexCaches[EnumCount<BranchType>] = {};
+
+		// NOTE: Running max of the end times of each row with items extending past their start (JPOS scroll durations and lyrics lasting until the next one).
+		//		 Unlike the end times themselves always sorted, so the first item still reaching into the visible range can be binary searched
+		struct ItemEndTimeRunningMaxCacheData
+		{
+			std::vector<Time> EndTimeRunningMax;
+			u64 ChangeGeneration = 0;
+			const void* List = nullptr;
+		} ItemEndTimeRunningMaxCaches[EnumCount<TimelineRowType>] = {};
+
 	public:
+		ChartTimeline() = default;
+		~ChartTimeline();
+
 		inline b8 HasKeyboardFocus() const { return IsAnyChildWindowFocused; }
 
 		inline Beat FloorBeatToCurrentGrid(Beat beat) const { return FloorBeatToGrid(beat, GetGridBeatSnap(CurrentGridBarDivision)); }
@@ -388,9 +434,11 @@ namespace PeepoDrumKit
 							eventsToAdd.push_back(std::move(event));
 						} else {
 							// check overlapping to inserted event's body
+							// NOTE: The previous event has already been shortened to end at the head above, so only the next event starting after it can overlap.
+							//		 Binary searching for that one directly (instead of an interval index) as the list is being edited in between each lookup
 							Beat duration = GetGridBeatSnap(CurrentGridBarDivision);
-							while (TEvent* checkedEvent = eventList->TryFindOverlappingBeat(itBeat, itBeat + duration, false)) {
-								duration = GetBeat(*checkedEvent) - itBeat;
+							if (const size_t nextIndex = BinarySearchForIndexAfterBeat(*eventList, itBeat); nextIndex < eventList->size()) {
+								duration = Min(duration, GetBeat((*eventList)[nextIndex]) - itBeat);
 							}
 							assert(duration > Beat::Zero());
 							SetBeatDuration(duration, event);
@@ -80,11 +80,45 @@ namespace PeepoDrumKit
 		constexpr std::string_view ActionPrefixUpdate = "Update ";
 		constexpr std::string_view ActionPrefixUpdateAll = "Update All ";
 
+		static void RecalculateSENotesInRange(const ChartCourse& course, const SortedNotesList* notes, Beat beatMin, Beat beatMax)
+		{
+			for (BranchType branch = BranchType::Normal; branch < BranchType::Count; IncrementEnum(branch))
+			{
+				if (&course.GetNotes(branch) == notes)
+				{
+					course.RecalculateSENotesInRange(branch, beatMin, beatMax);
+					return;
+				}
+			}
+			course.RecalculateSENotes();
+		}
+
+		// NOTE: The first changed beat must be at or before the earliest added, removed or edited event, so that unaffected tempo segments can be reused.
+		//		 Likewise the last changed beat must be at or after the latest one, so that only the SE of the notes around the edited range have to be updated
 		template <typename TEvent>
-		static void RefreshChart(ChartCourse* Course, ChartCourseListType<TEvent>* Map)
+		static void RefreshChart(ChartCourse* Course, ChartCourseListType<TEvent>* Map, Beat firstChangedBeat = Beat::Zero(), Beat lastChangedBeat = Beat::FromTicks(I32Max))
+		{
+			if constexpr (expect_type_v<TEvent, TempoChange>) { Map->RebuildAccelerationStructureFrom(firstChangedBeat); Course->RecalculateSENotes(); }
+			else if constexpr (TempoMapMemberPointer<TEvent> != nullptr) { Course->RecalculateSENotes(); }
+			else if constexpr (expect_type_v<TEvent, Note>) { RecalculateSENotesInRange(*Course, Map, firstChangedBeat, lastChangedBeat); }
+		}
+
+		template <typename TEvents>
+		static Beat FindFirstEventBeat(const TEvents& events)
+		{
+			Beat firstBeat = Beat::FromTicks(I32Max);
+			for (const auto& event : events)
+				firstBeat = Min(firstBeat, GetBeat(event));
+			return firstBeat;
+		}
+
+		template <typename TEvents>
+		static Beat FindLastEventBeat(const TEvents& events)
 		{
-			if constexpr (TempoMapMemberPointer<TEvent> != nullptr) { Map->RebuildAccelerationStructure(); Course->RecalculateSENotes(); }
-			else if constexpr (expect_type_v<TEvent, Note>) { Course->RecalculateSENotes(); }
+			Beat lastBeat = Beat::FromTicks(I32Min);
+			for (const auto& event : events)
+				lastBeat = Max(lastBeat, GetBeat(event));
+			return lastBeat;
 		}
 
 		template <typename TEvent>
@@ -100,12 +134,12 @@ namespace PeepoDrumKit
 					GetEventList<EventList>(*Map).InsertOrUpdate(ReplacedValue.value());
 				else
 					GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(NewValue));
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, GetBeat(NewValue), GetBeat(NewValue));
 			}
 			void Redo() override
 			{
 				GetEventList<EventList>(*Map).InsertOrFunc(NewValue, [&](TEvent& v, auto&&...) { ReplacedValue = std::move(v); v = NewValue; }); // safe replace
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, GetBeat(NewValue), GetBeat(NewValue));
 			}
 
 			Undo::MergeResult TryMerge(Command& commandToMerge) override { return Undo::MergeResult::Failed; }
@@ -126,24 +160,20 @@ namespace PeepoDrumKit
 			constexpr static auto EventList = TempoMapMemberPointer<TEvent>;
 			AddMultipleChartEventsBase(ChartCourse* course, ChartCourseListType* map, std::vector<TEvent> newValues) : Course(course), Map(map)
 			{
-				for (const auto& event : newValues)
-					NewEvents.InsertOrUpdate(event); // merge new events
+				NewEvents.InsertOrUpdateRange(std::move(newValues)); // merge new events
 			}
 
 			void Undo() override
 			{
-				for (const auto& event : NewEvents)
-					GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(event));
-				for (const auto& event : ReplacedEvents)
-					GetEventList<EventList>(*Map).InsertOrUpdate(event);
-				RefreshChart<TEvent>(Course, Map);
+				GetEventList<EventList>(*Map).RemoveRange(NewEvents);
+				GetEventList<EventList>(*Map).InsertOrUpdateRange(ReplacedEvents);
+				RefreshChart<TEvent>(Course, Map, FindFirstEventBeat(NewEvents), FindLastEventBeat(NewEvents));
 			}
 			void Redo() override
 			{
 				ReplacedEvents.clear();
-				for (const auto& event : NewEvents)
-					GetEventList<EventList>(*Map).InsertOrFunc(event, [&](TEvent& v, auto&&...) { ReplacedEvents.push_back(std::move(v)); v = event; }); // safe replace
-				RefreshChart<TEvent>(Course, Map);
+				GetEventList<EventList>(*Map).InsertOrFuncRange(NewEvents.Sorted, [&](TEvent& v, const TEvent& event) { ReplacedEvents.push_back(std::move(v)); v = event; }); // safe replace
+				RefreshChart<TEvent>(Course, Map, FindFirstEventBeat(NewEvents), FindLastEventBeat(NewEvents));
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
@@ -165,8 +195,8 @@ namespace PeepoDrumKit
 			RemoveSingleChartEventBase(ChartCourse* course, ChartCourseListType* map, TEvent oldValue) : Course(course), Map(map), OldValue(oldValue) { }
 			RemoveSingleChartEventBase(ChartCourse* course, ChartCourseListType* map, Beat beat) : Course(course), Map(map), OldValue(*GetEventList<EventList>(*Map).TryFindExactAtBeat(beat)) { assert(GetBeat(OldValue) == beat); }
 
-			void Undo() override { GetEventList<EventList>(*Map).InsertOrUpdate(OldValue); RefreshChart<TEvent>(Course, Map); }
-			void Redo() override { GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(OldValue)); RefreshChart<TEvent>(Course, Map); }
+			void Undo() override { GetEventList<EventList>(*Map).InsertOrUpdate(OldValue); RefreshChart<TEvent>(Course, Map, GetBeat(OldValue), GetBeat(OldValue)); }
+			void Redo() override { GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(OldValue)); RefreshChart<TEvent>(Course, Map, GetBeat(OldValue), GetBeat(OldValue)); }
 
 			Undo::MergeResult TryMerge(Command& commandToMerge) override { return Undo::MergeResult::Failed; }
 			Undo::CommandInfo GetInfo() const override { return { ConstevalStrJoined<ActionPrefixRemove, DisplayNameOfChartEvent<TEvent>> }; }
@@ -187,14 +217,13 @@ namespace PeepoDrumKit
 
 			void Undo() override
 			{
-				for (const auto& event : OldValues)
-					GetEventList<EventList>(*Map).InsertOrUpdate(event);
-				RefreshChart<TEvent>(Course, Map);
+				GetEventList<EventList>(*Map).InsertOrUpdateRange(OldValues);
+				RefreshChart<TEvent>(Course, Map, FindFirstEventBeat(OldValues), FindLastEventBeat(OldValues));
 			}
 			void Redo() override
 			{
-				for (const TEvent& event : OldValues) GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(event));
-				RefreshChart<TEvent>(Course, Map);
+				GetEventList<EventList>(*Map).RemoveRange(OldValues);
+				RefreshChart<TEvent>(Course, Map, FindFirstEventBeat(OldValues), FindLastEventBeat(OldValues));
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
@@ -218,13 +247,13 @@ namespace PeepoDrumKit
 			{
 				GetEventList<EventList>(*Map).RemoveAtBeat(GetBeat(NewValue));
 				EventsToRemove.Undo();
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, Min(GetBeat(NewValue), FindFirstEventBeat(EventsToRemove.OldValues)), Max(GetBeat(NewValue), FindLastEventBeat(EventsToRemove.OldValues)));
 			}
 			void Redo() override
 			{
 				EventsToRemove.Redo();
 				GetEventList<EventList>(*Map).InsertOrFunc(NewValue, [&](TEvent& v, auto&&...) { EventsToRemove.OldValues.push_back(std::move(v)); v = NewValue; }); // safe replace
-				RefreshChart<TEvent>(Course, Map);
+				RefreshChart<TEvent>(Course, Map, Min(GetBeat(NewValue), FindFirstEventBeat(EventsToRemove.OldValues)), Max(GetBeat(NewValue), FindLastEventBeat(EventsToRemove.OldValues)));
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
@@ -245,8 +274,8 @@ namespace PeepoDrumKit
 			constexpr static auto EventList = TempoMapMemberPointer<TEvent>;
 			UpdateSingleChartEventBase(ChartCourse* course, ChartCourseListType* map, TEvent newValue) : Course(course), Map(map), NewValue(newValue), OldValue(*GetEventList<EventList>(*Map).TryFindExactAtBeat(GetBeat(newValue))) { assert(GetBeat(newValue) == GetBeat(OldValue)); }
 
-			void Undo() override { GetEventList<EventList>(*Map).InsertOrUpdate(OldValue); RefreshChart<TEvent>(Course, Map); }
-			void Redo() override { GetEventList<EventList>(*Map).InsertOrUpdate(NewValue); RefreshChart<TEvent>(Course, Map); }
+			void Undo() override { GetEventList<EventList>(*Map).InsertOrUpdate(OldValue); RefreshChart<TEvent>(Course, Map, GetBeat(OldValue), GetBeat(OldValue)); }
+			void Redo() override { GetEventList<EventList>(*Map).InsertOrUpdate(NewValue); RefreshChart<TEvent>(Course, Map, GetBeat(NewValue), GetBeat(NewValue)); }
 
 			Undo::MergeResult TryMerge(Command& commandToMerge) override
 			{
@@ -406,8 +435,8 @@ namespace PeepoDrumKit
 
 			ChangeSingleNoteAttributeBase(ChartCourse* course, SortedNotesList* notes, Data newData) : Course(course), Notes(notes), NewData(std::move(newData)) { NewData.OldValue = (*Notes)[NewData.Index].*Attr; }
 
-			void Undo() override { (*Notes)[NewData.Index].*Attr = NewData.OldValue; RefreshChart<Note>(Course, nullptr); }
-			void Redo() override { (*Notes)[NewData.Index].*Attr = NewData.NewValue; RefreshChart<Note>(Course, nullptr); }
+			void Undo() override { (*Notes)[NewData.Index].*Attr = NewData.OldValue; RefreshChart<Note>(Course, Notes, (*Notes)[NewData.Index].BeatTime, (*Notes)[NewData.Index].BeatTime); }
+			void Redo() override { (*Notes)[NewData.Index].*Attr = NewData.NewValue; RefreshChart<Note>(Course, Notes, (*Notes)[NewData.Index].BeatTime, (*Notes)[NewData.Index].BeatTime); }
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override
 			{
@@ -449,14 +478,14 @@ namespace PeepoDrumKit
 			{
 				for (const auto& newData : NewData)
 					(*Notes)[newData.Index].*Attr = newData.OldValue;
-				RefreshChart<Note>(Course, nullptr);
+				RefreshChangedNotes();
 			}
 
 			void Redo() override
 			{
 				for (const auto& newData : NewData)
 					(*Notes)[newData.Index].*Attr = newData.NewValue;
-				RefreshChart<Note>(Course, nullptr);
+				RefreshChangedNotes();
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override
@@ -482,6 +511,17 @@ namespace PeepoDrumKit
 
 			Undo::CommandInfo GetInfo() const override { return { "Change Note Attributes" }; }
 
+			void RefreshChangedNotes()
+			{
+				Beat firstBeat = Beat::FromTicks(I32Max), lastBeat = Beat::FromTicks(I32Min);
+				for (const auto& newData : NewData)
+				{
+					firstBeat = Min(firstBeat, (*Notes)[newData.Index].BeatTime);
+					lastBeat = Max(lastBeat, (*Notes)[newData.Index].BeatTime);
+				}
+				RefreshChart<Note>(Course, Notes, firstBeat, lastBeat);
+			}
+
 			ChartCourse* Course;
 			SortedNotesList* Notes;
 			std::vector<Data> NewData;
@@ -551,44 +591,89 @@ namespace PeepoDrumKit
 	// NOTE: Generic chart commands
 	namespace Commands
 	{
+		// NOTE: Beat range of the edited notes of each branch, so that the generic commands too only have to update the SE of the notes around them
+		struct ChangedNotesBeatRanges
+		{
+			Beat BeatMin[EnumCount<BranchType>], BeatMax[EnumCount<BranchType>];
+
+			ChangedNotesBeatRanges()
+			{
+				for (size_t i = 0; i < EnumCount<BranchType>; i++) { BeatMin[i] = Beat::FromTicks(I32Max); BeatMax[i] = Beat::FromTicks(I32Min); }
+			}
+
+			void Include(GenericList list, Beat beatMin, Beat beatMax)
+			{
+				static_assert((EnumToIndex(GenericList::Notes_Expert) - EnumToIndex(GenericList::Notes_Normal)) == EnumToIndex(BranchType::Expert));
+				static_assert((EnumToIndex(GenericList::Notes_Master) - EnumToIndex(GenericList::Notes_Normal)) == EnumToIndex(BranchType::Master));
+				assert(IsNotesList(list));
+				const size_t branchIndex = EnumToIndex(list) - EnumToIndex(GenericList::Notes_Normal);
+				BeatMin[branchIndex] = Min(BeatMin[branchIndex], beatMin);
+				BeatMax[branchIndex] = Max(BeatMax[branchIndex], beatMax);
+			}
+
+			void Include(const ChangedNotesBeatRanges& other)
+			{
+				for (size_t i = 0; i < EnumCount<BranchType>; i++) { BeatMin[i] = Min(BeatMin[i], other.BeatMin[i]); BeatMax[i] = Max(BeatMax[i], other.BeatMax[i]); }
+			}
+		};
+
+		// NOTE: Same as RefreshChart, only a tempo change requires updating the SE of all notes
+		static void RefreshChartAfterGenericEdit(ChartCourse* Course, b8 updateTempoMap, Beat firstTempoChangeBeat, const ChangedNotesBeatRanges& changedNotes)
+		{
+			if (updateTempoMap)
+			{
+				Course->TempoMap.RebuildAccelerationStructureFrom(firstTempoChangeBeat);
+				Course->RecalculateSENotes();
+				return;
+			}
+
+			for (BranchType branch = BranchType::Normal; branch < BranchType::Count; IncrementEnum(branch))
+			{
+				if (changedNotes.BeatMin[EnumToIndex(branch)] <= changedNotes.BeatMax[EnumToIndex(branch)])
+					Course->RecalculateSENotesInRange(branch, changedNotes.BeatMin[EnumToIndex(branch)], changedNotes.BeatMax[EnumToIndex(branch)]);
+			}
+		}
+
 		struct AddMultipleGenericItems : Undo::Command
 		{
 			AddMultipleGenericItems(ChartCourse* course, std::vector<GenericListStructWithType> newData) : Course(course), UpdateTempoMap(false)
 			{
+				std::vector<GenericListStructWithType> newDataPerList[EnumCount<GenericList>];
 				for (const auto& data : newData) {
-					NewData[static_cast<size_t>(data.List)].InsertOrUpdate(data); // merge new data
-					if (data.List == GenericList::TempoChanges)
+					newDataPerList[static_cast<size_t>(data.List)].push_back(data);
+					if (data.List == GenericList::TempoChanges) {
 						UpdateTempoMap = true;
+						FirstTempoChangeBeat = Min(FirstTempoChangeBeat, GetBeat(data));
+					}
 					else if (IsNotesList(data.List))
-						UpdateNotes = true;
+						ChangedNotes.Include(data.List, GetBeat(data), GetBeat(data));
 				}
+				for (size_t i = 0; i < EnumCount<GenericList>; i++)
+					NewData[i].InsertOrUpdateRange(std::move(newDataPerList[i])); // merge new data
 			}
 
 			void Undo() override
 			{
-				for (const auto& list : NewData) {
-					for (const auto& data : list)
-						TryRemoveGenericStruct(*Course, data.List, data.Value);
+				for (size_t i = 0; i < EnumCount<GenericList>; i++) {
+					if (!NewData[i].empty())
+						TryRemoveGenericStructs(*Course, static_cast<GenericList>(i), NewData[i]);
 				}
-				for (const auto& data : ReplacedData)
-					TryAddOrReplaceGenericStruct(*Course, data.List, data.Value);
-				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
-				if (UpdateTempoMap || UpdateNotes)
-					Course->RecalculateSENotes();
+				for (size_t i = 0; i < EnumCount<GenericList>; i++) {
+					if (!ReplacedData[i].empty())
+						TryAddOrReplaceGenericStructs(*Course, static_cast<GenericList>(i), ReplacedData[i]);
+				}
+				RefreshChartAfterGenericEdit(Course, UpdateTempoMap, FirstTempoChangeBeat, ChangedNotes);
 			}
 
 			void Redo() override
 			{
-				ReplacedData.clear();
-				for (const auto& list : NewData) {
-					for (const auto& data : list)
-						TryAddOrFuncGenericStruct(*Course, data.List, data.Value, [&](auto& v, auto&& vNew) { ReplacedData.emplace_back(data.List, std::move(v)); v = vNew; }); // safe replace
+				for (size_t i = 0; i < EnumCount<GenericList>; i++) {
+					const GenericList list = static_cast<GenericList>(i);
+					ReplacedData[i].clear();
+					if (!NewData[i].empty())
+						TryAddOrFuncGenericStructs(*Course, list, NewData[i].Sorted, [&](auto& v, auto&& vNew) { ReplacedData[i].emplace_back(list, std::move(v)); v = vNew; }); // safe replace
 				}
-				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
-				if (UpdateTempoMap || UpdateNotes)
-					Course->RecalculateSENotes();
+				RefreshChartAfterGenericEdit(Course, UpdateTempoMap, FirstTempoChangeBeat, ChangedNotes);
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
@@ -596,49 +681,54 @@ namespace PeepoDrumKit
 
 			ChartCourse* Course;
 			BeatSortedList<GenericListStructWithType> NewData[EnumCount<GenericList>];
-			std::vector<GenericListStructWithType> ReplacedData;
-			b8 UpdateTempoMap, UpdateNotes;
+			std::vector<GenericListStructWithType> ReplacedData[EnumCount<GenericList>];
+			b8 UpdateTempoMap;
+			Beat FirstTempoChangeBeat = Beat::FromTicks(I32Max);
+			ChangedNotesBeatRanges ChangedNotes;
 		};
 
 		struct RemoveMultipleGenericItems : Undo::Command
 		{
-			RemoveMultipleGenericItems(ChartCourse* course, std::vector<GenericListStructWithType> oldData) : Course(course), OldData(std::move(oldData)), UpdateTempoMap(false)
+			RemoveMultipleGenericItems(ChartCourse* course, std::vector<GenericListStructWithType> oldData) : Course(course), UpdateTempoMap(false)
 			{
-				for (const auto& data : OldData)
+				for (const auto& data : oldData)
 				{
-					if (data.List == GenericList::TempoChanges)
+					OldData[static_cast<size_t>(data.List)].push_back(data);
+					if (data.List == GenericList::TempoChanges) {
 						UpdateTempoMap = true;
+						FirstTempoChangeBeat = Min(FirstTempoChangeBeat, GetBeat(data));
+					}
 					else if (IsNotesList(data.List))
-						UpdateNotes = true;
+						ChangedNotes.Include(data.List, GetBeat(data), GetBeat(data));
 				}
 			}
 
 			void Undo() override
 			{
-				for (const auto& data : OldData)
-					TryAddOrReplaceGenericStruct(*Course, data.List, data.Value);
-				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
-				if (UpdateTempoMap || UpdateNotes)
-					Course->RecalculateSENotes();
+				for (size_t i = 0; i < EnumCount<GenericList>; i++) {
+					if (!OldData[i].empty())
+						TryAddOrReplaceGenericStructs(*Course, static_cast<GenericList>(i), OldData[i]);
+				}
+				RefreshChartAfterGenericEdit(Course, UpdateTempoMap, FirstTempoChangeBeat, ChangedNotes);
 			}
 
 			void Redo() override
 			{
-				for (const auto& data : OldData)
-					TryRemoveGenericStruct(*Course, data.List, data.Value);
-				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
-				if (UpdateTempoMap || UpdateNotes)
-					Course->RecalculateSENotes();
+				for (size_t i = 0; i < EnumCount<GenericList>; i++) {
+					if (!OldData[i].empty())
+						TryRemoveGenericStructs(*Course, static_cast<GenericList>(i), OldData[i]);
+				}
+				RefreshChartAfterGenericEdit(Course, UpdateTempoMap, FirstTempoChangeBeat, ChangedNotes);
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override { return Undo::MergeResult::Failed; }
 			Undo::CommandInfo GetInfo() const override { return { "Remove Items" }; }
 
 			ChartCourse* Course;
-			std::vector<GenericListStructWithType> OldData;
-			b8 UpdateTempoMap, UpdateNotes;
+			std::vector<GenericListStructWithType> OldData[EnumCount<GenericList>];
+			b8 UpdateTempoMap;
+			Beat FirstTempoChangeBeat = Beat::FromTicks(I32Max);
+			ChangedNotesBeatRanges ChangedNotes;
 		};
 
 		struct AddMultipleGenericItems_Paste : AddMultipleGenericItems
@@ -682,10 +772,12 @@ namespace PeepoDrumKit
 				{
 					const b8 success = TryGet(*Course, data.List, data.Index, data.Member, data.OldValue);
 					assert(success);
-					if (data.List == GenericList::TempoChanges)
+					if (data.List == GenericList::TempoChanges) {
 						UpdateTempoMap = true;
+						FirstTempoChangeBeat = Min(FirstTempoChangeBeat, GetFirstChangedBeat(data));
+					}
 					else if (IsNotesList(data.List))
-						UpdateNotes = true;
+						ChangedNotes.Include(data.List, GetFirstChangedBeat(data), GetLastChangedBeat(data));
 				}
 			}
 
@@ -693,20 +785,14 @@ namespace PeepoDrumKit
 			{
 				for (const auto& newData : NewData)
 					TrySet(*Course, newData.List, newData.Index, newData.Member, newData.OldValue);
-				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
-				if (UpdateTempoMap || UpdateNotes)
-					Course->RecalculateSENotes();
+				RefreshChartAfterGenericEdit(Course, UpdateTempoMap, FirstTempoChangeBeat, ChangedNotes);
 			}
 
 			void Redo() override
 			{
 				for (const auto& newData : NewData)
 					TrySet(*Course, newData.List, newData.Index, newData.Member, newData.NewValue);
-				if (UpdateTempoMap)
-					Course->TempoMap.RebuildAccelerationStructure();
-				if (UpdateTempoMap || UpdateNotes)
-					Course->RecalculateSENotes();
+				RefreshChartAfterGenericEdit(Course, UpdateTempoMap, FirstTempoChangeBeat, ChangedNotes);
 			}
 
 			Undo::MergeResult TryMerge(Undo::Command& commandToMerge) override
@@ -728,15 +814,32 @@ namespace PeepoDrumKit
 
 				for (size_t i = 0; i < NewData.size(); i++)
 					NewData[i].NewValue = other->NewData[i].NewValue;
+				FirstTempoChangeBeat = Min(FirstTempoChangeBeat, other->FirstTempoChangeBeat);
+				ChangedNotes.Include(other->ChangedNotes);
 
 				return Undo::MergeResult::ValueUpdated;
 			}
 
 			Undo::CommandInfo GetInfo() const override { return { "Change Properties" }; }
 
+			// NOTE: Moving an item affects both its old and new position
+			Beat GetFirstChangedBeat(const Data& data) const
+			{
+				const Beat currentBeat = GetOrDefault<GenericMember::Beat_Start>(Beat::FromTicks(I32Max), *Course, data.List, data.Index);
+				return (data.Member == GenericMember::Beat_Start) ? Min(currentBeat, data.NewValue.Beat) : currentBeat;
+			}
+
+			Beat GetLastChangedBeat(const Data& data) const
+			{
+				const Beat currentBeat = GetOrDefault<GenericMember::Beat_Start>(Beat::FromTicks(I32Min), *Course, data.List, data.Index);
+				return (data.Member == GenericMember::Beat_Start) ? Max(currentBeat, data.NewValue.Beat) : currentBeat;
+			}
+
 			ChartCourse* Course;
 			std::vector<Data> NewData;
-			b8 UpdateTempoMap, UpdateNotes;
+			b8 UpdateTempoMap;
+			Beat FirstTempoChangeBeat = Beat::FromTicks(I32Max);
+			ChangedNotesBeatRanges ChangedNotes;
 		};
 
 		struct ChangeMultipleGenericProperties_MoveItems : ChangeMultipleGenericProperties
@@ -606,6 +606,76 @@ namespace PeepoDrumKit
 		Gui::PopFont();
 	}
 
+	static constexpr Time ChartStatsDensityHistogramBinDuration = Time::FromSec(1.0);
+	// NOTE: Way more than the plot is wide anyway, only there to keep extreme tempo or scroll data from allocating an absurd number of bins
+	static constexpr size_t ChartStatsDensityHistogramMaxBinCount = 4096;
+
+	static void RebuildChartStatsCache(ChartChartStatsWindow::StatsCacheData& out, const ChartCourse& course, BranchType branch)
+	{
+		out.DonCount = out.KaCount = out.KaDonCount = out.AdlibCount = out.BombCount = out.BigNoteCount = 0;
+		out.DrumrollCount = out.BalloonCount = out.BalloonPopCount = 0;
+		out.FirstNoteTime = out.LastNoteTime = Time::Zero();
+		out.DensityHistogram.clear();
+		out.DensityHistogramBinDuration = ChartStatsDensityHistogramBinDuration;
+		out.PeakDensity = 0.0f;
+
+		const SortedNotesList& notes = course.GetNotes(branch);
+		if (notes.empty())
+		{
+			out.MaxCombo = 0;
+			return;
+		}
+
+		out.FirstNoteTime = Time::FromSec(F64Max);
+		out.LastNoteTime = Time::FromSec(-F64Max);
+		for (const Note& note : notes)
+		{
+			out.DonCount += IsDonNote(note.Type);
+			out.KaCount += IsKaNote(note.Type);
+			out.KaDonCount += IsKaDonNote(note.Type);
+			out.AdlibCount += IsAdlibNote(note.Type);
+			out.BombCount += IsBombNote(note.Type);
+			out.BigNoteCount += ((IsDonNote(note.Type) || IsKaNote(note.Type)) && IsBigNote(note.Type));
+			out.DrumrollCount += IsDrumrollNote(note.Type);
+			out.BalloonCount += IsBalloonNote(note.Type);
+			out.BalloonPopCount += IsBalloonNote(note.Type) ? note.BalloonPopCount : 0;
+
+			const Time headTime = course.TempoMap.BeatToTime(note.BeatTime) + note.TimeOffset;
+			const Time tailTime = (note.BeatDuration > Beat::Zero()) ? (course.TempoMap.BeatToTime(note.BeatTime + note.BeatDuration) + note.TimeOffset) : headTime;
+			out.FirstNoteTime = Min(out.FirstNoteTime, headTime);
+			out.LastNoteTime = Max(out.LastNoteTime, Max(headTime, tailTime));
+		}
+		out.MaxCombo = out.DonCount + out.KaCount + out.KaDonCount;
+
+		// NOTE: Extreme tempos can result in a non-finite play time (in which case there just isn't any histogram) or a very long one, for which the bins are widened instead
+		const Time playTime = out.LastNoteTime - out.FirstNoteTime;
+		if (!std::isfinite(out.FirstNoteTime.Seconds) || !std::isfinite(out.LastNoteTime.Seconds) || !std::isfinite(playTime.Seconds))
+			return;
+
+		out.DensityHistogramBinDuration = Max(ChartStatsDensityHistogramBinDuration, playTime / static_cast<f64>(ChartStatsDensityHistogramMaxBinCount - 1));
+		const size_t binCount = Min(static_cast<size_t>(playTime / out.DensityHistogramBinDuration) + 1, ChartStatsDensityHistogramMaxBinCount);
+		out.DensityHistogram.resize(binCount, 0.0f);
+		for (const Note& note : notes)
+		{
+			if (!IsDonNote(note.Type) && !IsKaNote(note.Type) && !IsKaDonNote(note.Type))
+				continue;
+
+			const Time headTime = course.TempoMap.BeatToTime(note.BeatTime) + note.TimeOffset;
+			const f64 binPosition = (headTime - out.FirstNoteTime) / out.DensityHistogramBinDuration;
+			if (!std::isfinite(binPosition))
+				continue;
+
+			const size_t binIndex = static_cast<size_t>(Clamp(binPosition, 0.0, static_cast<f64>(binCount - 1)));
+			out.DensityHistogram[binIndex] += 1.0f;
+		}
+
+		for (f32& density : out.DensityHistogram)
+		{
+			density /= static_cast<f32>(out.DensityHistogramBinDuration.Seconds);
+			out.PeakDensity = Max(out.PeakDensity, density);
+		}
+	}
+
 	void ChartChartStatsWindow::DrawGui(ChartContext& context)
 	{
 		auto trimPrefix = [](std::string str) -> std::string {
@@ -660,14 +730,21 @@ namespace PeepoDrumKit
 
 			// Details
 			{
-				SortedNotesList& notes = context.ChartSelectedCourse->GetNotes(context.ChartSelectedBranch);
+				StatsCacheData& stats = StatsCache;
+				if (stats.ChangeGeneration != context.Undo.ChangeGeneration || stats.Course != &course || stats.Branch != context.ChartSelectedBranch)
+				{
+					stats.ChangeGeneration = context.Undo.ChangeGeneration;
+					stats.Course = &course;
+					stats.Branch = context.ChartSelectedBranch;
+					RebuildChartStatsCache(stats, course, context.ChartSelectedBranch);
+				}
 
-				int _donCount = notes.CountIf([](Note N) {return IsDonNote(N.Type);});
-				int _kaCount = notes.CountIf([](Note N) {return IsKaNote(N.Type);});
-				int _kaDonCount = notes.CountIf([](Note N) {return IsKaDonNote(N.Type);});
-				int _adLibCount = notes.CountIf([](Note N) {return IsAdlibNote(N.Type);});
-				int _bombCount = notes.CountIf([](Note N) {return IsBombNote(N.Type);});
-				int _maxCombo = _donCount + _kaCount + _kaDonCount;
+				const i32 _donCount = stats.DonCount;
+				const i32 _kaCount = stats.KaCount;
+				const i32 _kaDonCount = stats.KaDonCount;
+				const i32 _adLibCount = stats.AdlibCount;
+				const i32 _bombCount = stats.BombCount;
+				const i32 _maxCombo = stats.MaxCombo;
 
 				f64 _density = _maxCombo / chart.ChartDuration.Seconds;
 
@@ -681,8 +758,13 @@ namespace PeepoDrumKit
 
 				Gui::PushStyleColor(ImGuiCol_Text, colors.RedDark);
 				Gui::Text("Density: %.3f hit/s", _density);
+				Gui::Text("Peak Density: %.0f hit/s", stats.PeakDensity);
+				Gui::Text("Play Time: %s", (stats.LastNoteTime - stats.FirstNoteTime).ToString().Data);
 				Gui::PopStyleColor();
 
+				if (!stats.DensityHistogram.empty())
+					Gui::PlotHistogram("##DensityHistogram", stats.DensityHistogram.data(), static_cast<i32>(stats.DensityHistogram.size()), 0, nullptr, 0.0f, stats.PeakDensity, vec2(Gui::GetContentRegionAvail().x, GuiScale(48.0f)));
+
 				Gui::PushStyleColor(ImGuiCol_Text, IM_COL32(255, 122, 122, 255));
 				Gui::Text("Don: %d", _donCount);
 				Gui::PopStyleColor();
@@ -702,6 +784,12 @@ namespace PeepoDrumKit
 				Gui::PushStyleColor(ImGuiCol_Text, IM_COL32(122, 122, 122, 255));
 				Gui::Text("Bomb: %d", _bombCount);
 				Gui::PopStyleColor();
+
+				Gui::PushStyleColor(ImGuiCol_Text, colors.WhiteBright);
+				Gui::Text("Big Notes: %d", stats.BigNoteCount);
+				Gui::Text("Drumroll: %d", stats.DrumrollCount);
+				Gui::Text("Balloon: %d (%d hits)", stats.BalloonCount, stats.BalloonPopCount);
+				Gui::PopStyleColor();
 				
 				Gui::PopFont();
 
@@ -2643,6 +2731,8 @@ namespace PeepoDrumKit
 
 				Gui::Property::PropertyTextValueFunc(UI_Str("EVENT_GO_GO_TIME"), [&]
 				{
+					// NOTE: A plain binary search is enough here (no need for a BeatIntervalAccelerationStructure), as gogo ranges can never be nested
+					//		 with any intersecting ranges always being removed upon insertion (see below)
 					const GoGoRange* gogoRangeAtCursor = course.GoGoRanges.TryFindOverlappingBeat(cursorBeat, cursorBeat);
 					const b8 hasRangeSelection = timeline.RangeSelection.IsActiveAndHasEnd();
 
@@ -54,6 +54,23 @@ namespace PeepoDrumKit
 
 	struct ChartChartStatsWindow
 	{
+		// NOTE: Only recounted after the chart has been edited (or another course / branch has been selected) instead of every frame
+		struct StatsCacheData
+		{
+			u64 ChangeGeneration = 0;
+			const ChartCourse* Course = nullptr;
+			BranchType Branch = BranchType::Normal;
+
+			i32 DonCount, KaCount, KaDonCount, AdlibCount, BombCount, BigNoteCount;
+			i32 DrumrollCount, BalloonCount, BalloonPopCount;
+			i32 MaxCombo;
+			Time FirstNoteTime, LastNoteTime;
+			// NOTE: Combo notes per second, in one second wide bins starting at FirstNoteTime (only widened for very long play times to cap the bin count)
+			std::vector<f32> DensityHistogram;
+			Time DensityHistogramBinDuration;
+			f32 PeakDensity;
+		} StatsCache = {};
+
 		void DrawGui(ChartContext& context);
 	};
 
@@ -156,41 +173,14 @@ namespace PeepoDrumKit
 			return jPosCoord * coordRatio;
 		}
 
-		vec2 GetHitCircleCoordinatesJPOSScroll(const SortedJPOSScrollChangesList& jposScrollChanges, Time timeStamp, const TempoMapAccelerationStructure& accelerationStructure)
+		vec2 GetHitCircleCoordinatesJPOSScroll(const JPOSScrollPrefixSumTable& jposScrollTable, Time timeStamp) const
 		{
-			if (jposScrollChanges.empty())
-				return { 0, 0 };
-
-			f32 x = 0;
-			f32 y = 0;
-			Time jposTimeStamp = accelerationStructure.ConvertBeatToTimeUsingLookupTableIndexing(jposScrollChanges[0].BeatTime);
-			Time nextJposTimeStamp;
-			for (size_t i = 0; i < jposScrollChanges.size() && timeStamp >= jposTimeStamp; i++) {
-				JPOSScrollChange jposChange = jposScrollChanges[i];
-				nextJposTimeStamp = !(i + 1 < jposScrollChanges.size()) ? Time::FromSec(F32Max)
-					: accelerationStructure.ConvertBeatToTimeUsingLookupTableIndexing(jposScrollChanges[i + 1].BeatTime);
-
-				Complex jposMove = jposChange.Move;
-				Time jposDuration = Time::FromSec(jposChange.Duration);
-				Time jposDurationMax = nextJposTimeStamp - jposTimeStamp;
-
-				f32 xMove = jposMove.GetRealPart();
-				f32 yMove = jposMove.GetImaginaryPart();
-
-				Time timeSinceJpos = timeStamp - jposTimeStamp;
-				f32 timeRatio = (jposDuration <= Time::Zero()) ? 1.f
-					: (std::min({ jposDurationMax, jposDuration, timeSinceJpos }) / jposDuration);
-				x += xMove * timeRatio;
-				y += yMove * timeRatio;
-				jposTimeStamp = nextJposTimeStamp;
-			}
-
-			return vec2(x, y);
+			return jposScrollTable.GetMoveAtTime(timeStamp);
 		}
 
-		vec2 GetHitCircleCoordinatesLane(const SortedJPOSScrollChangesList& jposScrollChanges, Time timeStamp, const TempoMapAccelerationStructure& accelerationStructure)
+		vec2 GetHitCircleCoordinatesLane(const JPOSScrollPrefixSumTable& jposScrollTable, Time timeStamp) const
 		{
-			return JPOSScrollToLaneSpace(GetHitCircleCoordinatesJPOSScroll(jposScrollChanges, timeStamp, accelerationStructure));
+			return JPOSScrollToLaneSpace(GetHitCircleCoordinatesJPOSScroll(jposScrollTable, timeStamp));
 		}
 
 		vec2 GetNoteCoordinatesLane(
@@ -214,9 +204,9 @@ namespace PeepoDrumKit
 			);
 		}
 
-		vec2 GetHitCircleCoordinatesScreen(const SortedJPOSScrollChangesList& jposScrollChanges, Time timeStamp, const TempoMapAccelerationStructure& accelerationStructure)
+		vec2 GetHitCircleCoordinatesScreen(const JPOSScrollPrefixSumTable& jposScrollTable, Time timeStamp) const
 		{
-			return LaneToScreenSpace(GetHitCircleCoordinatesLane(jposScrollChanges, timeStamp, accelerationStructure));
+			return LaneToScreenSpace(GetHitCircleCoordinatesLane(jposScrollTable, timeStamp));
 		}
 
 		// NOTE: Same scale as world space but with (0,0) starting at the hit-circle center point
@@ -235,7 +225,7 @@ namespace PeepoDrumKit
 				case (ScrollMethod::HBSCROLL):
 				case (ScrollMethod::BMSCROLL):
 				{
-					f64 noteHBScrollBeatTick = accelerationStructure.ConvertBeatAndTimeToHBScrollBeatTickUsingLookupTableIndexing(noteBeat, noteTime);
+					f64 noteHBScrollBeatTick = accelerationStructure.ConvertBeatAndTimeToHBScrollBeatTickUsingSegmentLookup(noteBeat, noteTime);
 					return scrollSpeed * ((noteHBScrollBeatTick - cursorHBScrollBeatTick) / Beat::TicksPerBeat) * GameWorldSpaceDistancePerLaneBeat;
 				}
 				case (ScrollMethod::NMSCROLL):
@@ -253,12 +243,47 @@ namespace PeepoDrumKit
 		constexpr b8 IsRangeVisibleOnLane(f32 laneHeadX, f32 laneTailX, f32 threshold = 280.0f) const { return (laneTailX >= -threshold) && (laneHeadX <= (LaneWidth() + threshold)); }
 	};
 
+	struct ForEachNoteLaneData
+	{
+		const Note* OriginalNote;
+		Beat Beat;
+		Time Time;
+		Tempo Tempo;
+		Complex ScrollSpeed;
+		ScrollMethod ScrollType;
+		struct {
+			struct Beat Beat;
+			struct Time Time;
+			struct Tempo Tempo;
+			Complex ScrollSpeed;
+			ScrollMethod ScrollType;
+		} Tail;
+	};
+
+	// NOTE: JPOS scroll table and lane data of every note of a single course branch, only rebuilt after the chart (or the lane width) has changed.
+	//		 Each note also stores a conservative estimate of the cursor time range during which it could be on screen,
+	//		 with the running max / min of those allowing for binary searching the slice of notes that have to be checked each frame
+	struct GameNoteLaneLayoutCache
+	{
+		const ChartCourse* Course = nullptr;
+		BranchType Branch = BranchType::Normal;
+		u64 ChangeGeneration = 0;
+		f32 LaneWidth = 0.0f;
+		b8 WasUsedThisFrame = false;
+
+		JPOSScrollPrefixSumTable JPOSScroll;
+		std::vector<ForEachNoteLaneData> Notes;
+		std::vector<Time> VisibleFrom, VisibleUntil;
+		std::vector<Time> PrefixMaxVisibleUntil, SuffixMinVisibleFrom;
+	};
+
 	struct ChartGamePreview
 	{
 		GameCamera Camera = {};
 
 		struct DeferredNoteDrawData { f32 LaneHeadX, LaneTailX, LaneHeadY, LaneTailY; Tempo Tempo; Complex ScrollSpeed; const Note* OriginalNote; Time NoteStartTime, NoteEndTime; };
 		std::vector<DeferredNoteDrawData> ReverseNoteDrawBuffer;
+		std::vector<GameNoteLaneLayoutCache> NoteLaneLayoutCaches;
 
 		void DrawGui(ChartContext& context, Time animatedCursorTime);
 	};
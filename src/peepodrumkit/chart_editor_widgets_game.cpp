@@ -388,23 +388,6 @@ namespace PeepoDrumKit
 		});
 	}
 
-	struct ForEachNoteLaneData
-	{
-		const Note* OriginalNote;
-		Beat Beat;
-		Time Time;
-		Tempo Tempo;
-		Complex ScrollSpeed;
-		ScrollMethod ScrollType;
-		struct {
-			struct Beat Beat;
-			struct Time Time;
-			struct Tempo Tempo;
-			Complex ScrollSpeed;
-			ScrollMethod ScrollType;
-		} Tail;
-	};
-
 	template <typename Func>
 	static void ForEachNoteOnNoteLane(const ChartCourse& course, BranchType branch, Func perNoteFunc)
 	{
@@ -433,120 +416,69 @@ namespace PeepoDrumKit
 		}
 	}
 
-	void ChartCourse::RecalculateSENotes(BranchType branch) const
-	{
-		enum class SEFormType { Long, Short, Alternate, Final };
-
-		// prev, curr, next, n(ext)2nd
-		ForEachNoteLaneData noteDataRingBuffer[4] = {};
-		i32 noteDataRingOffset = 0;
-		auto getNoteData = [&](i32 idx) -> decltype(auto) { return noteDataRingBuffer[(noteDataRingOffset + idx) & 3]; };
+	// NOTE: Same default threshold as GameCamera::IsPointVisibleOnLane()
+	static constexpr f32 GameLaneNoteVisibilityThreshold = 280.0f;
 
-		// distance when curr is on the judgement mark
-		// other is NMScroll: visual beat distance = sec_time * visual_beat_per_second_other
-		// other is HBScroll: visual beat distance = scroll_other * beat_distance
-		auto getVisualBeat = [&](const auto& curr, const auto& other, f32 scrollOther, f32 vbpsOther, Time timeDistance)
+	static void RebuildNoteLaneLayoutCache(GameNoteLaneLayoutCache& cache, const GameCamera& camera, const ChartCourse& course, BranchType branch)
+	{
+		cache.JPOSScroll.Rebuild(course.JPOSScrollChanges, course.TempoMap.AccelerationStructure);
+		cache.Notes.clear();
+		ForEachNoteOnNoteLane(course, branch, [&](const ForEachNoteLaneData& it) { cache.Notes.push_back(it); });
+
+		// NOTE: Upper bound for how far the hit circle could have been moved away from its origin
+		f32 maxJPOSScrollDistanceX = 0.0f;
+		for (const JPOSScrollPrefixSumTable::Entry& it : cache.JPOSScroll.Entries)
+			maxJPOSScrollDistanceX += Absolute(it.Move.x);
+		const f32 maxLaneDistance = camera.LaneWidth() + GameLaneNoteVisibilityThreshold + camera.JPOSScrollToLaneSpace(vec2(maxJPOSScrollDistanceX, 0.0f)).x;
+
+		// NOTE: HBSCROLL / BMSCROLL positions depend on the cursor HBScroll beat instead of time (which doesn't have to be monotonic with negative tempos)
+		//		 so notes using those (or not moving horizontally at all) have to be treated as always potentially visible
+		auto getTimeToCrossLane = [&](Tempo tempo, Complex scrollSpeed, ScrollMethod scrollType) -> Time
 		{
-			return (other.OriginalNote == nullptr) ? F32Max
-				: (other.ScrollType == ScrollMethod::NMSCROLL) ? vbpsOther * timeDistance.Seconds
-				: (other.ScrollType == ScrollMethod::HBSCROLL) ? scrollOther * abs(curr.Beat - other.Beat).Ticks / Beat::TicksPerBeat
-				: /* (prev.ScrollType == ScrollMethod::BMSCROLL) ? */ abs(curr.Beat - other.Beat).Ticks / Beat::TicksPerBeat;
+			const f64 laneDistancePerSec = Absolute((tempo.BPM * scrollSpeed.GetRealPart()) / 60.0f) * GameWorldSpaceDistancePerLaneBeat;
+			return (scrollType == ScrollMethod::NMSCROLL && laneDistancePerSec > 0.0) ? Time::FromSec(maxLaneDistance / laneDistancePerSec) : Time::FromSec(F64Max);
 		};
 
-		auto getNoteDistance = [&]()
+		const size_t noteCount = cache.Notes.size();
+		cache.VisibleFrom.resize(noteCount);
+		cache.VisibleUntil.resize(noteCount);
+		for (size_t i = 0; i < noteCount; i++)
 		{
-			const auto& prev = getNoteData(0);
-			const auto& curr = getNoteData(1);
-			const auto& next = getNoteData(2);
-			const auto& n2nd = getNoteData(3);
-			const f32 scrollPrev = abs(prev.ScrollSpeed.cpx);
-			const f32 scrollNextCapped = std::min(1.0f, abs(next.ScrollSpeed.cpx));
-			// visual beat per second
-			const f32 vbpsPrev = scrollPrev * prev.Tempo.BPM / 60;
-			const f32 vbpsNextCapped = scrollNextCapped * next.Tempo.BPM / 60;
-			// time distance
-			const Time tdToPrev = (prev.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (curr.Time - prev.Time);
-			const Time tdToNext = (next.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (next.Time - curr.Time);
-			const Time tdToN2nd = (n2nd.OriginalNote == nullptr) ? Time::FromSec(F32Max) : (n2nd.Time - next.Time);
-			const f32 vbdToPrev = getVisualBeat(curr, prev, scrollPrev, vbpsPrev, tdToPrev);
-			const f32 vbdToNextCapped = getVisualBeat(curr, next, scrollNextCapped, vbpsNextCapped, tdToNext);
-			return std::tuple{ tdToPrev, vbdToPrev, tdToNext, vbdToNextCapped, tdToN2nd };
-		};
+			const ForEachNoteLaneData& it = cache.Notes[i];
+			const NoteType noteType = it.OriginalNote->Type;
+			const Time timeToCrossLane = Max(getTimeToCrossLane(it.Tempo, it.ScrollSpeed, it.ScrollType), getTimeToCrossLane(it.Tail.Tempo, it.Tail.ScrollSpeed, it.Tail.ScrollType));
+
+			cache.VisibleFrom[i] = Min(it.Time, it.Tail.Time) - timeToCrossLane;
+			cache.VisibleUntil[i] = IsRegularNote(noteType) ? (it.Time + GetTotalGameNoteHitAnimationDuration(noteType)) :
+				IsBalloonNote(noteType) ? it.Tail.Time :
+				(Max(it.Time, it.Tail.Time) + Max(timeToCrossLane, GameNoteHitAnimationDuration));
+		}
 
-		const SortedNotesList& notes = GetNotes(branch);
-		std::vector<const Note*> alterChain;
-		b8 isAlterChain = true;
-		Time timeIntervalAlter = Time::Zero();
-		Time timeStartAlter = Time::Zero();
+		cache.PrefixMaxVisibleUntil.resize(noteCount);
+		for (size_t i = 0; i < noteCount; i++)
+			cache.PrefixMaxVisibleUntil[i] = (i > 0) ? Max(cache.PrefixMaxVisibleUntil[i - 1], cache.VisibleUntil[i]) : cache.VisibleUntil[i];
 
-		auto assignSingleNote = [&]()
-		{
-			auto& curr = getNoteData(1);
-			const Note& it = *getNoteData(1).OriginalNote;
-			auto [tdToPrev, vbdToPrev, tdToNext, vbdToNextCapped, tdToN2nd] = getNoteDistance();
-			const Time timeEpsilon = Time::FromMS(1e-3);
-			const b8 denseToSparse = (tdToNext >= tdToPrev + timeEpsilon);
-			const b8 sparseToDense = (tdToN2nd <= tdToNext - timeEpsilon);
-			const f32 beatsEpsilon = 4 / 192.0;
-			const b8 isLongAvoided = (vbdToPrev <= 4 / 16.0 - beatsEpsilon
-				|| vbdToNextCapped <= 4 / 12.0 - beatsEpsilon); // avoid text from overlapping or extending under next note
-			const b8 isPrePause = (vbdToNextCapped >= 4 / 8.0 + beatsEpsilon);
-			auto se = (!isLongAvoided && (denseToSparse || sparseToDense || isPrePause)) ? SEFormType::Long : SEFormType::Short;
-			if (isAlterChain) {
-				if (it.Type == NoteType::Don && alterChain.empty()) {
-					timeIntervalAlter = tdToNext;
-					timeStartAlter = curr.Time;
-					alterChain.push_back(&it);
-				} else if (it.Type == NoteType::Don && abs(tdToPrev - timeIntervalAlter) < timeEpsilon && abs(timeStartAlter - curr.Time) < Time::FromSec(0.5) + timeEpsilon) {
-					alterChain.push_back(&it);
-				} else {
-					isAlterChain = false;
-					alterChain.clear();
-				}
-			}
-			if (denseToSparse || sparseToDense) {
-				if (denseToSparse && isAlterChain && !isLongAvoided && size(alterChain) % 2 != 0 && abs(timeStartAlter - curr.Time) < Time::FromSec(0.5) + timeEpsilon) {
-					for (i32 ia = 0; ia < size(alterChain); ++ia) {
-						if (ia % 2 == 1)
-							alterChain[ia]->TempSEType = NoteSEType::Ko;
-					}
-				}
-				alterChain.clear();
-				isAlterChain = sparseToDense;
-			}
+		cache.SuffixMinVisibleFrom.resize(noteCount);
+		for (size_t i = noteCount; i-- > 0;)
+			cache.SuffixMinVisibleFrom[i] = (i + 1 < noteCount) ? Min(cache.SuffixMinVisibleFrom[i + 1], cache.VisibleFrom[i]) : cache.VisibleFrom[i];
+	}
 
-			switch (it.Type)
-			{
-			case NoteType::Don: { it.TempSEType = (se == SEFormType::Long) ? NoteSEType::Don : NoteSEType::Do; } break;
-			case NoteType::DonBig: { it.TempSEType = NoteSEType::DonBig; } break;
-			case NoteType::DonBigHand: { it.TempSEType = NoteSEType::DonHand; } break;
-			case NoteType::Ka: { it.TempSEType = (se == SEFormType::Long) ? NoteSEType::Katsu : NoteSEType::Ka; } break;
-			case NoteType::KaBig: { it.TempSEType = NoteSEType::KatsuBig; } break;
-			case NoteType::KaBigHand: { it.TempSEType = NoteSEType::KatsuHand; } break;
-			case NoteType::Drumroll: { it.TempSEType = NoteSEType::Drumroll; } break;
-			case NoteType::DrumrollBig: { it.TempSEType = NoteSEType::DrumrollBig; } break;
-			case NoteType::Balloon: { it.TempSEType = NoteSEType::Balloon; } break;
-			case NoteType::BalloonSpecial: { it.TempSEType = NoteSEType::BalloonSpecial; } break;
-			default: { it.TempSEType = NoteSEType::Count; } break;
-			}
-		};
+	static const GameNoteLaneLayoutCache& GetUpdatedNoteLaneLayoutCache(std::vector<GameNoteLaneLayoutCache>& caches, const GameCamera& camera, const ChartCourse& course, BranchType branch, u64 changeGeneration)
+	{
+		auto existing = std::find_if(caches.begin(), caches.end(), [&](const GameNoteLaneLayoutCache& it) { return (it.Course == &course && it.Branch == branch); });
+		GameNoteLaneLayoutCache& cache = (existing != caches.end()) ? *existing : caches.emplace_back();
 
-		// fetch 2nd next note, update current note
-		i32 lastFilled = 0;
-		ForEachNoteOnNoteLane(*this, branch, [&](const ForEachNoteLaneData& dataIt)
+		if (cache.Course != &course || cache.Branch != branch || cache.ChangeGeneration != changeGeneration || cache.LaneWidth != camera.LaneWidth())
 		{
-			if (getNoteData(1).OriginalNote != nullptr)
-				assignSingleNote();
-			noteDataRingOffset = (noteDataRingOffset + 1) & 3;
-			getNoteData(3) = dataIt;
-			lastFilled = 3;
-		});
-		for (; lastFilled >= 1; --lastFilled) {
-			if (getNoteData(1).OriginalNote != nullptr)
-				assignSingleNote();
-			noteDataRingOffset = (noteDataRingOffset + 1) & 3;
-			getNoteData(3).OriginalNote = nullptr;
+			cache.Course = &course;
+			cache.Branch = branch;
+			cache.ChangeGeneration = changeGeneration;
+			cache.LaneWidth = camera.LaneWidth();
+			RebuildNoteLaneLayoutCache(cache, camera, course, branch);
 		}
+
+		cache.WasUsedThisFrame = true;
+		return cache;
 	}
 
 	void ChartGamePreview::DrawGui(ChartContext& context, Time animatedCursorTime)
@@ -608,6 +540,9 @@ namespace PeepoDrumKit
 		drawList->ChannelsSplit(4); // 0: lane, 1: judgement mark, 2: bar lines, 3: notes
 		drawList->PushClipRect(Camera.ScreenSpaceViewportRect.TL, Camera.ScreenSpaceViewportRect.BR, true);
 
+		for (auto& cache : NoteLaneLayoutCaches)
+			cache.WasUsedThisFrame = false;
+
 		i32 iLane = -1;
 		for (auto it = cbegin(context.Chart.Courses); it != cend(context.Chart.Courses); ++it) {
 			const auto* course = it->get();
@@ -687,7 +622,8 @@ namespace PeepoDrumKit
 
 			// NOTE: Hit indicator circle
 			drawList->ChannelsSetCurrent(1);
-			const vec2 hitCirclePosJPos = Camera.GetHitCircleCoordinatesJPOSScroll(jposScrollChanges, cursorTimeOrAnimated, tempoChanges);
+			const GameNoteLaneLayoutCache& noteLayout = GetUpdatedNoteLaneLayoutCache(NoteLaneLayoutCaches, Camera, *course, branch, context.Undo.ChangeGeneration);
+			const vec2 hitCirclePosJPos = Camera.GetHitCircleCoordinatesJPOSScroll(noteLayout.JPOSScroll, cursorTimeOrAnimated);
 			const vec2 hitCirclePosLane = Camera.JPOSScrollToLaneSpace(hitCirclePosJPos);
 			const vec2 hitCirclePos = Camera.LaneToScreenSpace(hitCirclePosLane);
 			if (gogoFireZoomAmount > 0) {
@@ -750,8 +686,14 @@ namespace PeepoDrumKit
 #endif
 
 			drawList->ChannelsSetCurrent(3);
-			ForEachNoteOnNoteLane(*course, branch, [&](const ForEachNoteLaneData& it)
+			const size_t visibleNotesBegin = static_cast<size_t>(std::partition_point(noteLayout.PrefixMaxVisibleUntil.begin(), noteLayout.PrefixMaxVisibleUntil.end(), [&](Time until) { return until < cursorTimeOrAnimated; }) - noteLayout.PrefixMaxVisibleUntil.begin());
+			const size_t visibleNotesEnd = static_cast<size_t>(std::partition_point(noteLayout.SuffixMinVisibleFrom.begin(), noteLayout.SuffixMinVisibleFrom.end(), [&](Time from) { return from <= cursorTimeOrAnimated; }) - noteLayout.SuffixMinVisibleFrom.begin());
+			for (size_t i = visibleNotesBegin; i < visibleNotesEnd; i++)
 			{
+				if (cursorTimeOrAnimated < noteLayout.VisibleFrom[i] || cursorTimeOrAnimated > noteLayout.VisibleUntil[i])
+					continue;
+
+				const ForEachNoteLaneData& it = noteLayout.Notes[i];
 				vec2 laneHead = Camera.GetNoteCoordinatesLane(hitCirclePosLane, cursorTimeOrAnimated, cursorHBScrollBeatOrAnimated, it.Time, it.Beat, it.Tempo, it.ScrollSpeed, it.ScrollType, tempoChanges, jposScrollChanges);
 				vec2 laneTail = Camera.GetNoteCoordinatesLane(hitCirclePosLane, cursorTimeOrAnimated, cursorHBScrollBeatOrAnimated, it.Tail.Time, it.Tail.Beat, it.Tail.Tempo, it.Tail.ScrollSpeed, it.Tail.ScrollType, tempoChanges, jposScrollChanges);
 
@@ -781,7 +723,7 @@ namespace PeepoDrumKit
 				}
 				if (isVisible)
 					ReverseNoteDrawBuffer.push_back(DeferredNoteDrawData{ laneHead.x, laneTail.x, laneHead.y, laneTail.y, it.Tempo, it.ScrollSpeed, it.OriginalNote, it.Time, it.Tail.Time });
-			});
+			}
 
 			const Beat drummrollHitInterval = GetGridBeatSnap(*Settings.General.DrumrollAutoHitBarDivision);
 			for (auto it = ReverseNoteDrawBuffer.rbegin(); it != ReverseNoteDrawBuffer.rend(); it++)
@@ -833,7 +775,7 @@ namespace PeepoDrumKit
 								{
 									// TODO: Scale duration, animation speed and path by extended lane width
 									const auto hitAnimation = GetNoteHitPathAnimation(timeSinceSubHit, Camera.ExtendedLaneWidthFactor(), nLanes, iLane, it->OriginalNote->Type);
-									const vec2 laneOrigin = Camera.GetHitCircleCoordinatesLane(jposScrollChanges, subHitTime, tempoChanges);
+									const vec2 laneOrigin = Camera.GetHitCircleCoordinatesLane(noteLayout.JPOSScroll, subHitTime);
 									const vec2 noteCenter = Camera.LaneToWorldSpace(laneOrigin.x, laneOrigin.y) + hitAnimation.PositionOffset;
 
 									if (hitAnimation.AlphaFadeOut >= 1.0f)
@@ -847,7 +789,7 @@ namespace PeepoDrumKit
 				{
 					// TODO: Instead of offseting the lane x position just draw as HitCenter + PositionOffset directly (?)
 					auto hitAnimation = GetNoteHitPathAnimation(timeSinceHit, Camera.ExtendedLaneWidthFactor(), nLanes, iLane, it->OriginalNote->Type);
-					const vec2 noteOrigin = (timeSinceHit >= Time::Zero()) ? Camera.GetHitCircleCoordinatesLane(jposScrollChanges, it->NoteEndTime, tempoChanges) // keep flying note's start position
+					const vec2 noteOrigin = (timeSinceHit >= Time::Zero()) ? Camera.GetHitCircleCoordinatesLane(noteLayout.JPOSScroll, it->NoteEndTime) // keep flying note's start position
 						: vec2{ it->LaneHeadX, it->LaneHeadY };
 					const vec2 noteCenter = Camera.LaneToWorldSpace(noteOrigin.x, noteOrigin.y) + hitAnimation.PositionOffset;
 
@@ -867,6 +809,7 @@ namespace PeepoDrumKit
 			}
 			ReverseNoteDrawBuffer.clear();
 		}
+		std::erase_if(NoteLaneLayoutCaches, [](const GameNoteLaneLayoutCache& it) { return !it.WasUsedThisFrame; });
 		drawList->PopClipRect();
 	}
 }
@@ -1,5 +1,6 @@
 #include "test_gui_audio.h"
 #include "imgui/imgui_include.h"
+#include "audio/audio_simd.h"
 
 namespace PeepoDrumKit
 {
@@ -117,6 +118,11 @@ namespace PeepoDrumKit
 						Audio::Engine.SetBufferFrameSize(newBufferFrameCount);
 				});
 
+				Gui::Property::PropertyTextValueFunc("Mixing Kernels", [&]
+				{
+					Gui::Text("%s", Audio::SIMDInstructionSetNames[EnumToIndex(Audio::GetSupportedSIMDInstructionSet())]);
+				});
+
 				Gui::Property::PropertyTextValueFunc("Render Performance", [&]
 				{
 					const auto durations = Audio::Engine.DebugGetRenderPerformanceHistory();
@@ -399,10 +399,11 @@ namespace PeepoDrumKit
 							case TJA::ParsedChartCommandType::MeasureNotes:
 							{
 								static std::string strBuffer; strBuffer.clear();
-								for (const TJA::NoteType& note : param.MeasureNotes.Notes)
+								const std::span<const TJA::NoteType> notes = LoadedTJAFile.Parsed.Arena.GetNotes(param.MeasureNotes.Notes);
+								for (const TJA::NoteType& note : notes)
 								{
 									strBuffer += TJANoteTypeNames[EnumToIndex(note)];
-									if (&note != &param.MeasureNotes.Notes.back())
+									if (&note != &notes.back())
 										strBuffer += " ";
 								}
 								if (!strBuffer.empty())
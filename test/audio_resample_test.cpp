@@ -0,0 +1,83 @@
+#include "../src/audio/audio_resample.h"
+#include <iostream>
+#include <cmath>
+
+using namespace Audio;
+
+// NOTE: Long enough to be split into multiple parallel blocks
+static constexpr f64 TestDurationSec = 10.0;
+static constexpr u32 TestChannelCount = 2;
+static constexpr f64 TestAmplitude = 16000.0;
+// NOTE: Skip the zero padded edges where the filter only partially overlaps the input
+static constexpr i64 TestEdgeFrameCount = 1024;
+
+struct ResampleTestCase
+{
+	u32 SourceRate, TargetRate;
+	f64 ToneFrequency;
+	// NOTE: For tones inside the passband the max absolute difference to an ideal sine in the target rate,
+	//		 for tones past the target nyquist frequency the max absolute amplitude of whatever is left after filtering
+	f64 MaxError;
+	b8 IsStopband;
+};
+
+static constexpr ResampleTestCase TestCases[] =
+{
+	{ 48000, 44100, 1000.0, 4.0, false },
+	{ 44100, 48000, 1000.0, 4.0, false },
+	// NOTE: Still inside the transition band which only reaches the full stopband attenuation further past the target nyquist frequency
+	{ 48000, 44100, 24000.0, 64.0, true },
+	// NOTE: Coprime rates for which the number of filter phases is capped and the output positions are rounded to the closest phase
+	{ 44100, 47999, 1000.0, 3.0, false },
+	{ 47999, 44100, 1000.0, 3.0, false },
+};
+
+static f64 GetSineSample(f64 frequency, i64 frame, u32 sampleRate, u32 channel)
+{
+	constexpr f64 pi = 3.14159265358979323846;
+	return TestAmplitude * std::sin((2.0 * pi * frequency * static_cast<f64>(frame) / static_cast<f64>(sampleRate)) + static_cast<f64>(channel));
+}
+
+int main()
+{
+	size_t failureCount = 0;
+	auto fail = [&](auto&&... args) { ((std::cerr << args), ...) << std::endl; failureCount++; };
+
+	for (const ResampleTestCase& test : TestCases)
+	{
+		const i64 inFrameCount = static_cast<i64>(TestDurationSec * test.SourceRate);
+		auto samples = UniqueSampleBuffer<i16>(new i16[inFrameCount * TestChannelCount]);
+		for (i64 frame = 0; frame < inFrameCount; frame++)
+			for (u32 c = 0; c < TestChannelCount; c++)
+				samples[(frame * TestChannelCount) + c] = static_cast<i16>(Round(GetSineSample(test.ToneFrequency, frame, test.SourceRate, c)));
+
+		i64 frameCount = inFrameCount;
+		u32 sampleRate = test.SourceRate;
+		ResampleBuffer(samples, frameCount, sampleRate, TestChannelCount, test.TargetRate);
+
+		const i64 expectedFrameCount = static_cast<i64>(std::llround(static_cast<f64>(inFrameCount) * test.TargetRate / test.SourceRate));
+		if (frameCount != expectedFrameCount || sampleRate != test.TargetRate)
+		{
+			fail(test.SourceRate, " -> ", test.TargetRate, ": Expected ", expectedFrameCount, " frames at ", test.TargetRate, " Hz, got ", frameCount, " frames at ", sampleRate, " Hz");
+			continue;
+		}
+
+		f64 maxError = 0.0;
+		for (i64 frame = TestEdgeFrameCount; frame < (frameCount - TestEdgeFrameCount); frame++)
+		{
+			for (u32 c = 0; c < TestChannelCount; c++)
+			{
+				const f64 actual = static_cast<f64>(samples[(frame * TestChannelCount) + c]);
+				const f64 expected = test.IsStopband ? 0.0 : GetSineSample(test.ToneFrequency, frame, test.TargetRate, c);
+				maxError = Max(maxError, Absolute(actual - expected));
+			}
+		}
+
+		std::cout << test.SourceRate << " -> " << test.TargetRate << " Hz, " << test.ToneFrequency << " Hz tone: max " << (test.IsStopband ? "amplitude " : "error ") << maxError << "\n";
+		if (maxError > test.MaxError)
+			fail(test.SourceRate, " -> ", test.TargetRate, ": ", test.ToneFrequency, " Hz tone exceeded the max ", (test.IsStopband ? "amplitude " : "error "), test.MaxError);
+	}
+
+	std::cout << ArrayCount(TestCases) << " test cases, " << failureCount << " failures\n";
+	return (failureCount > 0) ? 1 : 0;
+}
@@ -0,0 +1,253 @@
+#include "../src/core/core_types.h"
+#include "../src/core/core_beat.h"
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <cassert>
+
+struct BenchmarkNote
+{
+	Beat BeatStart;
+	Beat BeatDuration;
+};
+
+constexpr Beat GetBeat(const BenchmarkNote& note) { return note.BeatStart; }
+constexpr Beat GetBeatDuration(const BenchmarkNote& note) { return note.BeatDuration; }
+
+// NOTE: The original linear scans, kept around as the baseline to compare against (and to verify the results against)
+namespace Linear
+{
+	static const BenchmarkNote* TryFindLastAtBeat(const BeatSortedList<BenchmarkNote>& list, Beat beat)
+	{
+		const BenchmarkNote* found = nullptr;
+		for (const BenchmarkNote& v : list)
+		{
+			if (GetBeat(v) <= beat)
+				found = &v;
+			else
+				break;
+		}
+		return found;
+	}
+
+	static const BenchmarkNote* TryFindExactAtBeat(const BeatSortedList<BenchmarkNote>& list, Beat beat)
+	{
+		for (const BenchmarkNote& v : list)
+		{
+			if (GetBeat(v) == beat)
+				return &v;
+		}
+		return nullptr;
+	}
+
+	static const BenchmarkNote* TryFindOverlappingBeat(const BeatSortedList<BenchmarkNote>& list, Beat beatStart, Beat beatEnd, b8 inclusiveBeatCheck)
+	{
+		const BenchmarkNote* found = nullptr;
+		for (const BenchmarkNote& v : list)
+		{
+			if (inclusiveBeatCheck ? (GetBeat(v) <= beatEnd && beatStart <= (GetBeat(v) + GetBeatDuration(v))) : (GetBeat(v) < beatEnd && beatStart < (GetBeat(v) + GetBeatDuration(v))))
+				found = &v;
+			else if ((GetBeat(v) + GetBeatDuration(v)) > beatEnd)
+				break;
+		}
+		return found;
+	}
+
+	static size_t SearchForInsertionIndex(const BeatSortedList<BenchmarkNote>& list, Beat beat)
+	{
+		for (size_t i = 0; i < list.size(); i++)
+			if (beat <= GetBeat(list[i])) return i;
+		return list.size();
+	}
+}
+
+// NOTE: Roughly resembles a dense Oni / Ura course, mostly 16th notes with the occasional drumroll
+//		 (optionally with notes placed inside of the drumrolls, which is invalid but should still be handled correctly)
+static BeatSortedList<BenchmarkNote> CreateBenchmarkCourse(size_t noteCount, std::mt19937& random, b8 nestNotesInsideDrumrolls = false)
+{
+	BeatSortedList<BenchmarkNote> course;
+	course.Sorted.reserve(noteCount);
+
+	Beat beat = Beat::Zero();
+	for (size_t i = 0; i < noteCount; i++)
+	{
+		const b8 isDrumroll = (random() % 64) == 0;
+		const Beat duration = isDrumroll ? (GetGridBeatSnap(16) * static_cast<i32>(4 + (random() % 12))) : Beat::Zero();
+		course.Sorted.push_back(BenchmarkNote { beat, duration });
+		if (isDrumroll && nestNotesInsideDrumrolls && (i + 1) < noteCount)
+		{
+			course.Sorted.push_back(BenchmarkNote { beat + GetGridBeatSnap(16), Beat::Zero() });
+			i++;
+		}
+		beat += duration + (GetGridBeatSnap(16) * static_cast<i32>(1 + (random() % 2)));
+	}
+	return course;
+}
+
+template <typename Func>
+static f64 MeasureNanosecondsPerCall(const std::vector<Beat>& queryBeats, Func func)
+{
+	size_t checksum = 0;
+	const auto startTime = std::chrono::high_resolution_clock::now();
+	for (const Beat beat : queryBeats)
+		checksum += func(beat);
+	const auto endTime = std::chrono::high_resolution_clock::now();
+
+	// NOTE: Printed so that the calls can't be optimized away
+	std::cout << "  (checksum " << checksum << ")";
+	return static_cast<f64>(std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count()) / static_cast<f64>(queryBeats.size());
+}
+
+template <typename LinearFunc, typename BinaryFunc>
+static b8 RunBenchmark(const char* name, const std::vector<Beat>& queryBeats, LinearFunc linearFunc, BinaryFunc binaryFunc)
+{
+	for (const Beat beat : queryBeats)
+	{
+		if (linearFunc(beat) != binaryFunc(beat))
+		{
+			std::cerr << name << ": Mismatched result at tick " << beat.Ticks << std::endl;
+			return false;
+		}
+	}
+
+	std::cout << name << ":\n";
+	const f64 linearNanoseconds = MeasureNanosecondsPerCall(queryBeats, linearFunc);
+	std::cout << " linear " << linearNanoseconds << " ns/call\n";
+	const f64 binaryNanoseconds = MeasureNanosecondsPerCall(queryBeats, binaryFunc);
+	std::cout << " binary " << binaryNanoseconds << " ns/call\n";
+	std::cout << "  -> " << (linearNanoseconds / binaryNanoseconds) << "x speedup\n";
+	return true;
+}
+
+int main(int argc, char** argv)
+{
+	const size_t noteCount = (argc > 1) ? static_cast<size_t>(std::atoi(argv[1])) : 5000;
+	const size_t queryCount = 100000;
+
+	std::mt19937 random(0x5EED);
+	const BeatSortedList<BenchmarkNote> course = CreateBenchmarkCourse(noteCount, random);
+	assert(ValidateIsSortedByBeat(course));
+
+	const Beat lastBeat = course.empty() ? Beat::Zero() : (GetBeat(course.Sorted.back()) + GetBeatDuration(course.Sorted.back()));
+	std::vector<Beat> queryBeats(queryCount);
+	for (Beat& beat : queryBeats)
+	{
+		// NOTE: Mix of exact hits (snapped to 16ths) and arbitrary beats, including a few out of range on either side
+		beat = Beat::FromTicks(static_cast<i32>(random() % static_cast<u32>(lastBeat.Ticks + GetGridBeatSnap(4).Ticks * 2)) - GetGridBeatSnap(4).Ticks);
+		if (random() % 2)
+			beat = RoundBeatToGrid(beat, GetGridBeatSnap(16));
+	}
+
+	std::cout << "BeatSortedList with " << course.size() << " notes, " << queryBeats.size() << " queries\n";
+	b8 allMatched = true;
+
+	allMatched &= RunBenchmark("TryFindLastAtBeat", queryBeats,
+		[&](Beat beat) { return reinterpret_cast<size_t>(Linear::TryFindLastAtBeat(course, beat)); },
+		[&](Beat beat) { return reinterpret_cast<size_t>(course.TryFindLastAtBeat(beat)); });
+
+	allMatched &= RunBenchmark("TryFindExactAtBeat", queryBeats,
+		[&](Beat beat) { return reinterpret_cast<size_t>(Linear::TryFindExactAtBeat(course, beat)); },
+		[&](Beat beat) { return reinterpret_cast<size_t>(course.TryFindExactAtBeat(beat)); });
+
+	allMatched &= RunBenchmark("TryFindOverlappingBeat (inclusive)", queryBeats,
+		[&](Beat beat) { return reinterpret_cast<size_t>(Linear::TryFindOverlappingBeat(course, beat, beat, true)); },
+		[&](Beat beat) { return reinterpret_cast<size_t>(course.TryFindOverlappingBeat(beat, beat, true)); });
+
+	allMatched &= RunBenchmark("TryFindOverlappingBeat (exclusive)", queryBeats,
+		[&](Beat beat) { return reinterpret_cast<size_t>(Linear::TryFindOverlappingBeat(course, beat, beat + GetGridBeatSnap(8), false)); },
+		[&](Beat beat) { return reinterpret_cast<size_t>(course.TryFindOverlappingBeat(beat, beat + GetGridBeatSnap(8), false)); });
+
+	allMatched &= RunBenchmark("TryFindOverlappingBeatUntrusted (inverted)", queryBeats,
+		[&](Beat beat) { return reinterpret_cast<size_t>(Linear::TryFindOverlappingBeat(course, beat, beat - GetGridBeatSnap(8), true)); },
+		[&](Beat beat) { return reinterpret_cast<size_t>(course.TryFindOverlappingBeatUntrusted(beat, beat - GetGridBeatSnap(8), true)); });
+
+	allMatched &= RunBenchmark("InsertionIndex", queryBeats,
+		[&](Beat beat) { return Linear::SearchForInsertionIndex(course, beat); },
+		[&](Beat beat) { return BinarySearchForInsertionIndex(course, beat); });
+
+	allMatched &= RunBenchmark("FindOverlappingRange", queryBeats,
+		[&](Beat beat)
+		{
+			size_t count = 0;
+			for (const BenchmarkNote& v : course)
+				count += (GetBeat(v) <= (beat + GetGridBeatSnap(1)) && beat <= (GetBeat(v) + GetBeatDuration(v)));
+			return count;
+		},
+		[&](Beat beat) { return course.FindOverlappingRange(beat, beat + GetGridBeatSnap(1)).size(); });
+
+	BeatIntervalAccelerationStructure intervalIndex {};
+	intervalIndex.Rebuild(course);
+
+	allMatched &= RunBenchmark("BeatIntervalAccelerationStructure::TryFindOverlappingBeat (inclusive)", queryBeats,
+		[&](Beat beat) { return reinterpret_cast<size_t>(Linear::TryFindOverlappingBeat(course, beat, beat, true)); },
+		[&](Beat beat) { return reinterpret_cast<size_t>(intervalIndex.TryFindOverlappingBeat(course, beat, beat, true)); });
+
+	const BeatSortedList<BenchmarkNote> nestedCourse = CreateBenchmarkCourse(noteCount, random, true);
+	BeatIntervalAccelerationStructure nestedIntervalIndex {};
+	nestedIntervalIndex.Rebuild(nestedCourse);
+
+	allMatched &= RunBenchmark("BeatIntervalAccelerationStructure::TryFindOverlappingBeat (nested, exclusive)", queryBeats,
+		[&](Beat beat) { return reinterpret_cast<size_t>(Linear::TryFindOverlappingBeat(nestedCourse, beat, beat + GetGridBeatSnap(8), false)); },
+		[&](Beat beat) { return reinterpret_cast<size_t>(nestedIntervalIndex.TryFindOverlappingBeat(nestedCourse, beat, beat + GetGridBeatSnap(8), false)); });
+
+	allMatched &= RunBenchmark("BeatIntervalAccelerationStructure::ForEachOverlappingBeat (nested)", queryBeats,
+		[&](Beat beat)
+		{
+			size_t sum = 0;
+			for (const BenchmarkNote& v : nestedCourse)
+				sum += (GetBeat(v) <= (beat + GetGridBeatSnap(1)) && beat <= (GetBeat(v) + GetBeatDuration(v))) ? reinterpret_cast<size_t>(&v) : 0;
+			return sum;
+		},
+		[&](Beat beat)
+		{
+			size_t sum = 0;
+			nestedIntervalIndex.ForEachOverlappingBeat(nestedCourse, beat, beat + GetGridBeatSnap(1), true, [&](const BenchmarkNote& v) { sum += reinterpret_cast<size_t>(&v); });
+			return sum;
+		});
+
+	{
+		// NOTE: Pasting a large number of notes (partially overlapping the existing ones) and then removing them again, as done by the undo commands
+		std::vector<BenchmarkNote> notesToPaste = CreateBenchmarkCourse(noteCount * 2, random).Sorted;
+		for (BenchmarkNote& note : notesToPaste)
+			note.BeatStart = RoundBeatToGrid(note.BeatStart + GetGridBeatSnap(4) * 64, GetGridBeatSnap(8));
+		std::shuffle(notesToPaste.begin(), notesToPaste.end(), random);
+
+		BeatSortedList<BenchmarkNote> sequentialCourse = course, batchedCourse = course;
+		size_t sequentialReplacedCount = 0, batchedReplacedCount = 0;
+
+		const auto sequentialStartTime = std::chrono::high_resolution_clock::now();
+		for (const BenchmarkNote& note : notesToPaste)
+			sequentialCourse.InsertOrFunc(note, [&](BenchmarkNote& v, const BenchmarkNote& vNew) { sequentialReplacedCount++; v = vNew; });
+		const b8 sequentialInsertMatched = (sequentialCourse.size() + sequentialReplacedCount == course.size() + notesToPaste.size());
+		for (const BenchmarkNote& note : notesToPaste)
+			sequentialCourse.RemoveAtBeat(GetBeat(note));
+		const auto sequentialEndTime = std::chrono::high_resolution_clock::now();
+
+		const auto batchedStartTime = std::chrono::high_resolution_clock::now();
+		batchedCourse.InsertOrFuncRange(notesToPaste, [&](BenchmarkNote& v, const BenchmarkNote& vNew) { batchedReplacedCount++; v = vNew; });
+		const b8 batchedInsertMatched = (batchedCourse.size() + batchedReplacedCount == course.size() + notesToPaste.size());
+		batchedCourse.RemoveRange(notesToPaste);
+		const auto batchedEndTime = std::chrono::high_resolution_clock::now();
+
+		const b8 resultsMatched = sequentialInsertMatched && batchedInsertMatched && (sequentialReplacedCount == batchedReplacedCount) && (sequentialCourse.size() == batchedCourse.size()) &&
+			std::equal(sequentialCourse.begin(), sequentialCourse.end(), batchedCourse.begin(), [](const BenchmarkNote& a, const BenchmarkNote& b) { return (a.BeatStart == b.BeatStart) && (a.BeatDuration == b.BeatDuration); });
+		if (!resultsMatched)
+			std::cerr << "InsertOrFuncRange / RemoveRange: Mismatched result" << std::endl;
+		allMatched &= resultsMatched;
+
+		const f64 sequentialMilliseconds = static_cast<f64>(std::chrono::duration_cast<std::chrono::microseconds>(sequentialEndTime - sequentialStartTime).count()) / 1000.0;
+		const f64 batchedMilliseconds = static_cast<f64>(std::chrono::duration_cast<std::chrono::microseconds>(batchedEndTime - batchedStartTime).count()) / 1000.0;
+		std::cout << "Paste and remove " << notesToPaste.size() << " notes:\n";
+		std::cout << " sequential " << sequentialMilliseconds << " ms\n";
+		std::cout << " batched " << batchedMilliseconds << " ms\n";
+		std::cout << "  -> " << (sequentialMilliseconds / Max(batchedMilliseconds, 0.001)) << "x speedup\n";
+	}
+
+	if (!allMatched)
+	{
+		std::cerr << "Binary search results don't match the linear scans" << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,97 @@
+#include "../src/peepodrumkit/chart.h"
+#include <iostream>
+#include <random>
+#include <algorithm>
+
+using namespace PeepoDrumKit;
+
+static constexpr size_t TestIterationCount = 500;
+static constexpr size_t TestQueryCount = 200;
+static constexpr f32 TestMoveTolerance = 0.001f;
+
+// NOTE: The original linear sum over all changes, kept around as the reference to verify the prefix sum table against
+static vec2 GetMoveAtTimeLinear(const SortedJPOSScrollChangesList& jposScrollChanges, Time timeStamp, const TempoMapAccelerationStructure& accelerationStructure)
+{
+	if (jposScrollChanges.empty())
+		return vec2(0.0f);
+
+	f32 x = 0.0f, y = 0.0f;
+	Time jposTimeStamp = accelerationStructure.ConvertBeatToTimeUsingSegmentLookup(jposScrollChanges[0].BeatTime);
+	for (size_t i = 0; i < jposScrollChanges.size() && timeStamp >= jposTimeStamp; i++)
+	{
+		const JPOSScrollChange& jposChange = jposScrollChanges[i];
+		const Time nextJposTimeStamp = (i + 1 < jposScrollChanges.size()) ? accelerationStructure.ConvertBeatToTimeUsingSegmentLookup(jposScrollChanges[i + 1].BeatTime) : Time::FromSec(F32Max);
+
+		const Time jposDuration = Time::FromSec(jposChange.Duration);
+		const Time jposDurationMax = nextJposTimeStamp - jposTimeStamp;
+		const Time timeSinceJpos = timeStamp - jposTimeStamp;
+		const f32 timeRatio = (jposDuration <= Time::Zero()) ? 1.0f : static_cast<f32>(Min(Min(jposDurationMax, jposDuration), timeSinceJpos) / jposDuration);
+		x += jposChange.Move.GetRealPart() * timeRatio;
+		y += jposChange.Move.GetImaginaryPart() * timeRatio;
+		jposTimeStamp = nextJposTimeStamp;
+	}
+	return vec2(x, y);
+}
+
+// NOTE: Tempo changes with the occasional negative tempo and JPOS scroll changes
+//		 with durations both shorter and longer than the distance to the next change (as well as zero durations)
+static void CreateRandomTestCourse(ChartCourse& course, std::mt19937& random, b8 withNegativeTempos)
+{
+	course.TempoMap.Tempo.Sorted = { TempoChange { Beat::Zero(), Tempo(160.0f) } };
+	course.JPOSScrollChanges.Sorted.clear();
+
+	Beat beat = Beat::Zero();
+	for (size_t i = 0; i < 64; i++)
+	{
+		beat += GetGridBeatSnap(4) * static_cast<i32>(1 + (random() % 4));
+		if (random() % 4 == 0)
+		{
+			const b8 isNegative = withNegativeTempos && (random() % 3 == 0);
+			course.TempoMap.Tempo.Sorted.push_back(TempoChange { beat, Tempo(static_cast<f32>(60 + (random() % 240)) * (isNegative ? -1.0f : 1.0f)) });
+		}
+		if (random() % 2 == 0)
+		{
+			const Complex move = Complex(static_cast<f32>(static_cast<i32>(random() % 801) - 400), static_cast<f32>(static_cast<i32>(random() % 801) - 400));
+			const f32 duration = (random() % 4 == 0) ? 0.0f : (static_cast<f32>(random() % 4000) / 1000.0f);
+			course.JPOSScrollChanges.Sorted.push_back(JPOSScrollChange { beat, move, duration });
+		}
+	}
+	course.TempoMap.RebuildAccelerationStructure();
+}
+
+int main()
+{
+	std::mt19937 random(0x5EED);
+	size_t mismatchCount = 0, negativeTempoCourseCount = 0;
+
+	for (size_t i = 0; i < TestIterationCount; i++)
+	{
+		ChartCourse course {};
+		CreateRandomTestCourse(course, random, (i % 2) == 1);
+		negativeTempoCourseCount += std::any_of(course.TempoMap.Tempo.begin(), course.TempoMap.Tempo.end(), [](const TempoChange& it) { return it.Tempo.BPM < 0.0f; });
+
+		JPOSScrollPrefixSumTable table {};
+		table.Rebuild(course.JPOSScrollChanges, course.TempoMap.AccelerationStructure);
+
+		Time minTime = Time::Zero(), maxTime = Time::Zero();
+		for (const JPOSScrollPrefixSumTable::Entry& it : table.Entries) { minTime = Min(minTime, it.StartTime); maxTime = Max(maxTime, it.StartTime + it.Duration); }
+
+		for (size_t j = 0; j < TestQueryCount; j++)
+		{
+			// NOTE: Including a few queries exactly at the start of a change as well as before and after all of them
+			const Time timeStamp = (!table.Entries.empty() && (j % 8) == 0) ? table.Entries[random() % table.Entries.size()].StartTime :
+				Time::FromSec(std::uniform_real_distribution<f64>((minTime - Time::FromSec(1.0)).Seconds, (maxTime + Time::FromSec(1.0)).Seconds)(random));
+
+			const vec2 expected = GetMoveAtTimeLinear(course.JPOSScrollChanges, timeStamp, course.TempoMap.AccelerationStructure);
+			const vec2 actual = table.GetMoveAtTime(timeStamp);
+			if (!ApproxmiatelySame(expected.x, actual.x, TestMoveTolerance) || !ApproxmiatelySame(expected.y, actual.y, TestMoveTolerance))
+			{
+				std::cerr << "Iteration " << i << ": Mismatched move at " << timeStamp.Seconds << " sec: expected (" << expected.x << ", " << expected.y << "), got (" << actual.x << ", " << actual.y << ")" << std::endl;
+				mismatchCount++;
+			}
+		}
+	}
+
+	std::cout << TestIterationCount << " courses (" << negativeTempoCourseCount << " with negative tempos), " << mismatchCount << " mismatches\n";
+	return (mismatchCount > 0) ? 1 : 0;
+}
@@ -0,0 +1,163 @@
+#include "../src/peepodrumkit/chart.h"
+#include "../src/peepodrumkit/chart_editor_undo.h"
+#include <iostream>
+#include <random>
+#include <algorithm>
+
+using namespace PeepoDrumKit;
+
+static Note CreateTestNote(Beat beat, NoteType type)
+{
+	Note note {};
+	note.BeatTime = beat;
+	note.Type = type;
+	note.BeatDuration = IsLongNote(type) ? (GetGridBeatSnap(16) * 4) : Beat::Zero();
+	note.TempSEType = NoteSEType::Count;
+	return note;
+}
+
+// NOTE: Mostly runs of Dons (for the alternating Do / Ko chains) with varying spacing (for the dense / sparse transitions)
+static NoteType GetRandomNoteType(std::mt19937& random)
+{
+	static constexpr NoteType noteTypes[] = { NoteType::Don, NoteType::Don, NoteType::Don, NoteType::Don, NoteType::Ka, NoteType::Ka, NoteType::DonBig, NoteType::KaBig, NoteType::Drumroll, NoteType::Balloon };
+	return noteTypes[random() % ArrayCount(noteTypes)];
+}
+
+static Beat GetRandomNoteSpacing(std::mt19937& random)
+{
+	static constexpr i32 barDivisions[] = { 16, 16, 16, 12, 8, 8, 4, 24, 32 };
+	return GetGridBeatSnap(barDivisions[random() % ArrayCount(barDivisions)]);
+}
+
+static void CreateRandomTestCourse(ChartCourse& course, size_t noteCount, std::mt19937& random)
+{
+	course.TempoMap.Tempo.Sorted = { TempoChange { Beat::Zero(), Tempo(160.0f) } };
+	Beat beat = Beat::Zero();
+	for (size_t i = 0; i < noteCount; i++)
+	{
+		course.Notes_Normal.Sorted.push_back(CreateTestNote(beat, GetRandomNoteType(random)));
+		beat += GetRandomNoteSpacing(random) * static_cast<i32>(1 + (random() % 4 == 0));
+
+		if (random() % 128 == 0)
+			course.TempoMap.Tempo.Sorted.push_back(TempoChange { beat, Tempo(static_cast<f32>(100 + (random() % 160))) });
+		if (random() % 128 == 0)
+			course.ScrollChanges.Sorted.push_back(ScrollChange { beat, Complex(static_cast<f32>(random() % 5) * 0.5f, 0.0f) });
+		if (random() % 256 == 0)
+			course.ScrollTypes.Sorted.push_back(ScrollType { beat, static_cast<ScrollMethod>(random() % EnumCount<ScrollMethod>) });
+	}
+	course.TempoMap.RebuildAccelerationStructure();
+}
+
+static std::vector<NoteSEType> GetSENoteTypes(const SortedNotesList& notes)
+{
+	std::vector<NoteSEType> seTypes;
+	for (const Note& note : notes)
+		seTypes.push_back(note.TempSEType);
+	return seTypes;
+}
+
+int main(int argc, char** argv)
+{
+	const size_t noteCount = (argc > 1) ? static_cast<size_t>(std::atoi(argv[1])) : 2000;
+	const size_t editCount = 5000;
+
+	std::mt19937 random(0x5EED);
+	ChartCourse course {};
+	CreateRandomTestCourse(course, noteCount, random);
+	SortedNotesList& notes = course.Notes_Normal;
+	course.RecalculateSENotes();
+
+	size_t mismatchCount = 0;
+	for (size_t i = 0; i < editCount; i++)
+	{
+		// NOTE: Same kinds of edits as the note undo commands, each reporting the beat range of the notes it added, removed or changed.
+		//		 The generic multi item commands (paste, cut and moving items) are executed directly as they update the SE themselves
+		Beat beatMin = Beat::Zero(), beatMax = Beat::Zero();
+		b8 isUpdatedByCommand = false;
+		const Beat lastBeat = notes.empty() ? GetGridBeatSnap(1) : (notes.Sorted.back().BeatTime + GetGridBeatSnap(1));
+		const Beat randomBeat = RoundBeatToGrid(Beat::FromTicks(static_cast<i32>(random() % static_cast<u32>(lastBeat.Ticks))), GetGridBeatSnap(48));
+		switch (random() % 6)
+		{
+		case 0:
+		{
+			notes.InsertOrUpdate(CreateTestNote(randomBeat, GetRandomNoteType(random)));
+			beatMin = beatMax = randomBeat;
+		} break;
+		case 1:
+		{
+			if (notes.empty()) continue;
+			const Beat beat = notes[random() % notes.size()].BeatTime;
+			notes.RemoveAtBeat(beat);
+			beatMin = beatMax = beat;
+		} break;
+		case 2:
+		{
+			if (notes.empty()) continue;
+			Note& note = notes[random() % notes.size()];
+			note.Type = GetRandomNoteType(random);
+			beatMin = beatMax = note.BeatTime;
+		} break;
+		case 3:
+		{
+			std::vector<GenericListStructWithType> notesToPaste;
+			Beat beat = randomBeat;
+			for (size_t j = 0; j < 1 + (random() % 12); j++, beat += GetRandomNoteSpacing(random))
+				notesToPaste.emplace_back(GenericList::Notes_Normal, CreateTestNote(beat, GetRandomNoteType(random)));
+			Commands::AddMultipleGenericItems_Paste command(&course, std::move(notesToPaste));
+			command.Redo();
+			if (random() % 4 == 0)
+				command.Undo();
+			isUpdatedByCommand = true;
+		} break;
+		case 4:
+		{
+			if (notes.empty()) continue;
+			const size_t first = random() % notes.size();
+			const size_t last = Min(notes.size() - 1, first + (random() % 8));
+			std::vector<GenericListStructWithType> notesToCut;
+			for (size_t j = first; j <= last; j++)
+				notesToCut.emplace_back(GenericList::Notes_Normal, notes[j]);
+			Commands::RemoveMultipleGenericItems_Cut command(&course, std::move(notesToCut));
+			command.Redo();
+			if (random() % 4 == 0)
+				command.Undo();
+			isUpdatedByCommand = true;
+		} break;
+		case 5:
+		{
+			// NOTE: Moving a single note anywhere in between its neighbors so that the notes stay sorted
+			if (notes.size() < 3) continue;
+			const size_t index = 1 + (random() % (notes.size() - 2));
+			const Beat moveMin = notes[index - 1].GetEnd() + Beat::FromTicks(1), moveMax = notes[index + 1].BeatTime - Beat::FromTicks(1);
+			if (moveMin > moveMax) continue;
+
+			Commands::ChangeMultipleGenericProperties::Data data {};
+			data.Index = index;
+			data.List = GenericList::Notes_Normal;
+			data.Member = GenericMember::Beat_Start;
+			data.NewValue.Beat = Beat::FromTicks(moveMin.Ticks + static_cast<i32>(random() % static_cast<u32>(moveMax.Ticks - moveMin.Ticks + 1)));
+			Commands::ChangeMultipleGenericProperties_MoveItems command(&course, { data });
+			command.Redo();
+			if (random() % 4 == 0)
+				command.Undo();
+			isUpdatedByCommand = true;
+		} break;
+		}
+
+		if (!isUpdatedByCommand)
+			course.RecalculateSENotesInRange(BranchType::Normal, beatMin, beatMax);
+		const std::vector<NoteSEType> incrementalSETypes = GetSENoteTypes(notes);
+		course.RecalculateSENotes(BranchType::Normal);
+		const std::vector<NoteSEType> fullSETypes = GetSENoteTypes(notes);
+
+		if (incrementalSETypes != fullSETypes)
+		{
+			const size_t index = static_cast<size_t>(std::mismatch(incrementalSETypes.begin(), incrementalSETypes.end(), fullSETypes.begin()).first - incrementalSETypes.begin());
+			std::cerr << "Edit " << i << ": Mismatched SE of note " << index << " (beat ticks [" << beatMin.Ticks << ", " << beatMax.Ticks << "] edited)" << std::endl;
+			mismatchCount++;
+		}
+	}
+
+	std::cout << editCount << " edits on " << notes.size() << " notes, " << mismatchCount << " mismatches\n";
+	return (mismatchCount > 0) ? 1 : 0;
+}
@@ -0,0 +1,83 @@
+#include "../src/core/file_format_tja.h"
+#include <iostream>
+#include <chrono>
+
+// NOTE: Well past the 16-bit line index limit tokens used to be restricted to
+static constexpr size_t TestLineCount = 200000;
+static constexpr size_t TestHeaderLineCount = 6;
+static constexpr size_t TestBadLineIndices[] = { 100, 32767, 32768, 65535, 65536, 131072, 199990 };
+
+static b8 IsBadLineIndex(size_t lineIndex)
+{
+	for (const size_t badLineIndex : TestBadLineIndices)
+		if (lineIndex == badLineIndex)
+			return true;
+	return false;
+}
+
+static std::string CreateLargeTestTJA()
+{
+	std::string tja;
+	tja.reserve(TestLineCount * 16);
+	tja += "TITLE:Large File Test\nBPM:160\nOFFSET:0\nCOURSE:Oni\nLEVEL:10\n#START\n";
+	for (size_t lineIndex = TestHeaderLineCount; lineIndex < (TestLineCount - 1); lineIndex++)
+		tja += IsBadLineIndex(lineIndex) ? "#BPMCHANGE bad\n" : "1020102010201020,\n";
+	tja += "#END\n";
+	return tja;
+}
+
+int main()
+{
+	const std::string fileContent = CreateLargeTestTJA();
+
+	const auto startTime = std::chrono::high_resolution_clock::now();
+	const std::vector<std::string_view> lines = TJA::SplitLines(fileContent);
+	const std::vector<TJA::Token> tokens = TJA::TokenizeLines(lines);
+	TJA::ErrorList errors {};
+	const TJA::ParsedTJA parsed = TJA::ParseTokens(tokens, errors);
+	const f64 parseTimeSec = std::chrono::duration<f64>(std::chrono::high_resolution_clock::now() - startTime).count();
+
+	size_t failureCount = 0;
+	auto fail = [&](auto&&... args) { ((std::cerr << args), ...) << std::endl; failureCount++; };
+
+	if (lines.size() < TestLineCount)
+		fail("Expected at least ", TestLineCount, " lines, got ", lines.size());
+
+	// NOTE: One token per (non-indented, comment-free) line plus the implicit end-of-file token
+	if (tokens.size() != (lines.size() + 1))
+		fail("Expected ", lines.size() + 1, " tokens, got ", tokens.size());
+
+	for (size_t tokenIndex = 0; tokenIndex < tokens.size(); tokenIndex++)
+	{
+		const TJA::Token& token = tokens[tokenIndex];
+		const size_t expectedLineIndex = Min(tokenIndex, lines.size() - 1);
+		if (token.LineIndex < 0 || static_cast<size_t>(token.LineIndex) != expectedLineIndex)
+		{
+			fail("Token ", tokenIndex, ": Expected line index ", expectedLineIndex, ", got ", token.LineIndex);
+			continue;
+		}
+
+		// NOTE: Every token should point back to the exact start of its own source line (or the end of the file)
+		const size_t expectedByteOffset = (tokenIndex < lines.size()) ? static_cast<size_t>(lines[tokenIndex].data() - fileContent.data()) : fileContent.size();
+		if (const size_t byteOffset = TJA::GetTokenByteOffset(token, fileContent); byteOffset != expectedByteOffset)
+			fail("Token ", tokenIndex, ": Expected byte offset ", expectedByteOffset, ", got ", byteOffset);
+	}
+
+	size_t badLineErrorCount = 0;
+	for (const TJA::ErrorList::ErrorLine& error : errors.Errors)
+	{
+		if (IsBadLineIndex(static_cast<size_t>(error.LineIndex)))
+			badLineErrorCount++;
+		else
+			fail("Line ", error.LineIndex, ": Unexpected error '", error.Description, "'");
+	}
+	if (badLineErrorCount != ArrayCount(TestBadLineIndices))
+		fail("Expected ", ArrayCount(TestBadLineIndices), " errors on the bad lines, got ", badLineErrorCount);
+
+	if (parsed.Courses.size() != 1 || parsed.Courses[0].ChartCommands.empty())
+		fail("Expected a single parsed course with chart commands");
+
+	// NOTE: Timing is only reported, not checked, as it depends too much on the build type and machine
+	std::cout << lines.size() << " lines, " << tokens.size() << " tokens, " << errors.Errors.size() << " errors parsed in " << (parseTimeSec * 1000.0) << " ms, " << failureCount << " failures\n";
+	return (failureCount > 0) ? 1 : 0;
+}
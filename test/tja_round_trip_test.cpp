@@ -0,0 +1,176 @@
+#include "../src/core/file_format_tja.h"
+#include <iostream>
+#include <random>
+#include <charconv>
+
+using namespace TJA;
+
+static constexpr size_t TestIterationCount = 200;
+static constexpr size_t TestMeasureCount = 64;
+
+// NOTE: Deliberately "ugly" values with more significant digits than "%g" preserves
+static f32 GetRandomF32(std::mt19937& random, f32 min, f32 max) { return std::uniform_real_distribution<f32>(min, max)(random); }
+static std::string F32ToString(f32 value) { char buffer[64]; return std::string(buffer, std::to_chars(buffer, std::end(buffer), value).ptr); }
+
+static std::string CreateRandomTestTJA(std::mt19937& random)
+{
+	std::string tja;
+	tja += "TITLE:Round Trip Test\n";
+	tja += "BPM:" + F32ToString(GetRandomF32(random, 60.0f, 400.0f)) + "\n";
+	tja += "WAVE:test.ogg\n";
+	tja += "OFFSET:" + F32ToString(GetRandomF32(random, -5.0f, 5.0f)) + "\n";
+	tja += "DEMOSTART:" + F32ToString(GetRandomF32(random, 0.0f, 120.0f)) + "\n";
+	tja += "SONGVOL:" + F32ToString(GetRandomF32(random, 0.0f, 200.0f)) + "\n";
+	tja += "SEVOL:" + F32ToString(GetRandomF32(random, 0.0f, 200.0f)) + "\n";
+	tja += "HEADSCROLL:" + F32ToString(GetRandomF32(random, 0.1f, 4.0f)) + "\n";
+	tja += "BGMOVIE:test.mp4\n";
+	tja += "MOVIEOFFSET:" + F32ToString(GetRandomF32(random, -5.0f, 5.0f)) + "\n";
+
+	static constexpr cstr courseNames[] = { "Easy", "Normal", "Hard", "Oni", "Tower" };
+	for (const cstr courseName : courseNames)
+	{
+		tja += "\nCOURSE:"; tja += courseName; tja += "\n";
+		tja += "LEVEL:" + std::to_string(1 + (random() % 10)) + ((random() % 2) ? ("." + std::to_string(random() % 10)) : "") + "\n";
+		tja += "BALLOON:" + std::to_string(random() % 100) + "," + std::to_string(random() % 100) + "\n";
+		tja += "SCOREINIT:" + std::to_string(random() % 2000) + "\n";
+		tja += "SCOREDIFF:" + std::to_string(random() % 2000) + "\n";
+		if (std::string_view(courseName) == "Tower")
+			tja += "LIFE:" + std::to_string(1 + (random() % 50)) + "\nSIDE:Both\n";
+		tja += "#START\n";
+		for (size_t i = 0; i < TestMeasureCount; i++)
+		{
+			switch (random() % 8)
+			{
+			case 0: tja += "#MEASURE " + std::to_string(1 + (random() % 15)) + "/4\n"; break;
+			case 1: tja += "#BPMCHANGE " + F32ToString(GetRandomF32(random, 60.0f, 400.0f)) + "\n"; break;
+			case 2: tja += "#DELAY " + F32ToString(GetRandomF32(random, -1.0f, 1.0f)) + "\n"; break;
+			case 3: tja += "#SCROLL " + F32ToString(GetRandomF32(random, -4.0f, 4.0f)) + "+" + F32ToString(GetRandomF32(random, 0.1f, 4.0f)) + "i\n"; break;
+			case 4: tja += "#SCROLL " + F32ToString(GetRandomF32(random, -4.0f, 4.0f)) + "\n"; break;
+			case 5: tja += "#SUDDEN " + F32ToString(GetRandomF32(random, 0.0f, 4.0f)) + " " + F32ToString(GetRandomF32(random, 0.0f, 4.0f)) + "\n"; break;
+			case 6: tja += "#JPOSSCROLL " + F32ToString(GetRandomF32(random, 0.0f, 4.0f)) + " " + F32ToString(GetRandomF32(random, -500.0f, 500.0f)) + "-" + F32ToString(GetRandomF32(random, 0.1f, 500.0f)) + "i 1\n"; break;
+			case 7: tja += "#BRANCHSTART p," + std::to_string(random() % 100) + "," + std::to_string(random() % 100) + "\n#N\n1111,\n#E\n2222,\n#M\n3333,\n#BRANCHEND\n"; break;
+			}
+			tja += "1020304050607080,\n";
+		}
+		tja += "#END\n";
+	}
+	return tja;
+}
+
+static ParsedTJA ParseTJA(std::string_view fileContent, ErrorList& outErrors)
+{
+	return ParseTokens(TokenizeLines(SplitLines(fileContent)), outErrors);
+}
+
+struct FieldComparer
+{
+	size_t MismatchCount = 0;
+
+	template <typename T>
+	void operator()(cstr fieldName, const T& expected, const T& actual)
+	{
+		if (expected == actual)
+			return;
+		std::cerr << "Mismatched " << fieldName << ": expected " << expected << ", got " << actual << std::endl;
+		MismatchCount++;
+	}
+
+	void operator()(cstr fieldName, const Complex& expected, const Complex& actual)
+	{
+		(*this)(fieldName, expected.GetRealPart(), actual.GetRealPart());
+		(*this)(fieldName, expected.GetImaginaryPart(), actual.GetImaginaryPart());
+	}
+};
+
+static void CompareNumericFields(const ParsedTJA& expected, const ParsedTJA& actual, FieldComparer& compare)
+{
+	compare("BPM", expected.Metadata.BPM.BPM, actual.Metadata.BPM.BPM);
+	compare("OFFSET", expected.Metadata.OFFSET.Seconds, actual.Metadata.OFFSET.Seconds);
+	compare("DEMOSTART", expected.Metadata.DEMOSTART.Seconds, actual.Metadata.DEMOSTART.Seconds);
+	compare("SONGVOL", expected.Metadata.SONGVOL, actual.Metadata.SONGVOL);
+	compare("SEVOL", expected.Metadata.SEVOL, actual.Metadata.SEVOL);
+	compare("HEADSCROLL", expected.Metadata.HEADSCROLL, actual.Metadata.HEADSCROLL);
+	compare("MOVIEOFFSET", expected.Metadata.MOVIEOFFSET.Seconds, actual.Metadata.MOVIEOFFSET.Seconds);
+
+	compare("Courses", expected.Courses.size(), actual.Courses.size());
+	for (size_t courseIndex = 0; courseIndex < Min(expected.Courses.size(), actual.Courses.size()); courseIndex++)
+	{
+		const ParsedCourse& expectedCourse = expected.Courses[courseIndex];
+		const ParsedCourse& actualCourse = actual.Courses[courseIndex];
+		compare("LEVEL", expectedCourse.Metadata.LEVEL, actualCourse.Metadata.LEVEL);
+		compare("LEVEL_DECIMALTAG", expectedCourse.Metadata.LEVEL_DECIMALTAG, actualCourse.Metadata.LEVEL_DECIMALTAG);
+		compare("BALLOON", expectedCourse.Metadata.BALLOON.size(), actualCourse.Metadata.BALLOON.size());
+		for (size_t i = 0; i < Min(expectedCourse.Metadata.BALLOON.size(), actualCourse.Metadata.BALLOON.size()); i++)
+			compare("BALLOON", expectedCourse.Metadata.BALLOON[i], actualCourse.Metadata.BALLOON[i]);
+		compare("SCOREINIT", expectedCourse.Metadata.SCOREINIT, actualCourse.Metadata.SCOREINIT);
+		compare("SCOREDIFF", expectedCourse.Metadata.SCOREDIFF, actualCourse.Metadata.SCOREDIFF);
+		compare("LIFE", expectedCourse.Metadata.LIFE, actualCourse.Metadata.LIFE);
+
+		compare("ChartCommands", expectedCourse.ChartCommands.size(), actualCourse.ChartCommands.size());
+		for (size_t i = 0; i < Min(expectedCourse.ChartCommands.size(), actualCourse.ChartCommands.size()); i++)
+		{
+			const ParsedChartCommand& e = expectedCourse.ChartCommands[i];
+			const ParsedChartCommand& a = actualCourse.ChartCommands[i];
+			if (e.Type != a.Type) { compare("ChartCommand.Type", static_cast<i32>(e.Type), static_cast<i32>(a.Type)); continue; }
+
+			switch (e.Type)
+			{
+			case ParsedChartCommandType::MeasureNotes:
+			{
+				const std::span<const NoteType> expectedNotes = expected.Arena.GetNotes(e.Param.MeasureNotes.Notes), actualNotes = actual.Arena.GetNotes(a.Param.MeasureNotes.Notes);
+				compare("MeasureNotes", std::vector<NoteType>(expectedNotes.begin(), expectedNotes.end()) == std::vector<NoteType>(actualNotes.begin(), actualNotes.end()), true);
+			} break;
+			case ParsedChartCommandType::ChangeTimeSignature:
+			{
+				compare("MEASURE", e.Param.ChangeTimeSignature.Value.Numerator, a.Param.ChangeTimeSignature.Value.Numerator);
+				compare("MEASURE", e.Param.ChangeTimeSignature.Value.Denominator, a.Param.ChangeTimeSignature.Value.Denominator);
+			} break;
+			case ParsedChartCommandType::ChangeTempo: { compare("BPMCHANGE", e.Param.ChangeTempo.Value.BPM, a.Param.ChangeTempo.Value.BPM); } break;
+			case ParsedChartCommandType::ChangeDelay: { compare("DELAY", e.Param.ChangeDelay.Value.Seconds, a.Param.ChangeDelay.Value.Seconds); } break;
+			case ParsedChartCommandType::ChangeScrollSpeed: { compare("SCROLL", e.Param.ChangeScrollSpeed.Value, a.Param.ChangeScrollSpeed.Value); } break;
+			case ParsedChartCommandType::BranchStart:
+			{
+				compare("BRANCHSTART", static_cast<i32>(e.Param.BranchStart.Condition), static_cast<i32>(a.Param.BranchStart.Condition));
+				compare("BRANCHSTART", e.Param.BranchStart.RequirementExpert, a.Param.BranchStart.RequirementExpert);
+				compare("BRANCHSTART", e.Param.BranchStart.RequirementMaster, a.Param.BranchStart.RequirementMaster);
+			} break;
+			case ParsedChartCommandType::SetSudden:
+			{
+				compare("SUDDEN", e.Param.SetSudden.AppearanceOffset.Seconds, a.Param.SetSudden.AppearanceOffset.Seconds);
+				compare("SUDDEN", e.Param.SetSudden.MovementWaitDelay.Seconds, a.Param.SetSudden.MovementWaitDelay.Seconds);
+			} break;
+			case ParsedChartCommandType::SetJPOSScroll:
+			{
+				compare("JPOSSCROLL", e.Param.ChangeJPOSScroll.Duration.Seconds, a.Param.ChangeJPOSScroll.Duration.Seconds);
+				compare("JPOSSCROLL", e.Param.ChangeJPOSScroll.Move, a.Param.ChangeJPOSScroll.Move);
+			} break;
+			default: {} break;
+			}
+		}
+	}
+}
+
+int main()
+{
+	std::mt19937 random(0x5EED);
+	FieldComparer compare {};
+
+	for (size_t i = 0; i < TestIterationCount; i++)
+	{
+		// NOTE: parse(export(x)) == x, with x itself being the result of parsing to start with the exact values the parser can represent
+		ErrorList originalErrors {}, roundTripErrors {};
+		const ParsedTJA original = ParseTJA(CreateRandomTestTJA(random), originalErrors);
+
+		std::string exported;
+		ConvertParsedToText(original, exported, Encoding::Unknown);
+		const ParsedTJA roundTrip = ParseTJA(exported, roundTripErrors);
+
+		const size_t previousMismatchCount = compare.MismatchCount;
+		CompareNumericFields(original, roundTrip, compare);
+		if (compare.MismatchCount != previousMismatchCount)
+			std::cerr << "Iteration " << i << ": " << (compare.MismatchCount - previousMismatchCount) << " mismatches" << std::endl;
+	}
+
+	std::cout << TestIterationCount << " round trips, " << compare.MismatchCount << " mismatches\n";
+	return (compare.MismatchCount > 0) ? 1 : 0;
+}
@@ -0,0 +1,216 @@
+#include "../src/audio/audio_waveform.h"
+#include <iostream>
+#include <random>
+
+using namespace Audio;
+
+static constexpr u32 TestSampleRate = 48000;
+// NOTE: Tiny, odd, exactly power of two and long enough to be split into multiple parallel worker slices
+static constexpr i64 TestFrameCounts[] = { 3, 511, 4096, 48000 * 3 + 1, 48000 * 30 };
+static constexpr u32 TestChannelCounts[] = { 1, 2, 3 };
+static constexpr size_t TestIncrementalChunkFrameCount = 1021;
+static constexpr size_t TestQueryCount = 2000;
+// NOTE: Each mip level rounds its RMS to the closest integer sample, so allow for the error adding up across all of them
+static constexpr f32 TestRMSTolerance = (8.0f / static_cast<f32>(I16Max));
+
+// NOTE: The original serial per-sample generation of each level (one separate vector per level), kept around as the reference to verify the mip chain against
+struct ReferenceMip
+{
+	std::vector<i16> Peaks, RMS;
+};
+
+static std::vector<ReferenceMip> CreateReferenceMips(const PCMSampleBuffer& buffer, u32 channelIndex, b8 includeFullSizeMip)
+{
+	std::vector<ReferenceMip> mips(1);
+	ReferenceMip& baseMip = mips[0];
+
+	const size_t basePowerOfTwoSampleCount = RoundUpToPowerOfTwo(static_cast<u32>(buffer.FrameCount)) / (includeFullSizeMip ? 1 : 2);
+	baseMip.Peaks.resize(includeFullSizeMip ? static_cast<size_t>(buffer.FrameCount) : basePowerOfTwoSampleCount, 0);
+	baseMip.RMS.resize(baseMip.Peaks.size(), 0);
+
+	auto sampleAt = [&](i64 frame) { return AbsoluteSampleSaturated(buffer.InterleavedSamples[(frame * buffer.ChannelCount) + channelIndex]); };
+	if (includeFullSizeMip)
+	{
+		for (i64 frame = 0; frame < buffer.FrameCount; frame++)
+			baseMip.Peaks[frame] = baseMip.RMS[frame] = sampleAt(frame);
+	}
+	else
+	{
+		for (size_t i = 0; i < Min(baseMip.Peaks.size(), static_cast<size_t>(buffer.FrameCount / 2)); i++)
+		{
+			const i16 a = sampleAt(i * 2 + 0), b = sampleAt(i * 2 + 1);
+			baseMip.Peaks[i] = Max(a, b);
+			baseMip.RMS[i] = static_cast<i16>(Min<i32>(static_cast<i32>(::sqrtf(static_cast<f32>((static_cast<i32>(a) * a) + (static_cast<i32>(b) * b)) * 0.5f) + 0.5f), I16Max));
+		}
+	}
+
+	for (size_t powerOfTwoSampleCount = basePowerOfTwoSampleCount; powerOfTwoSampleCount > WaveformMipChain::MinMipSampleCount && mips.size() < WaveformMipChain::MaxMipLevels; powerOfTwoSampleCount /= 2)
+	{
+		const ReferenceMip parentMip = mips.back();
+		ReferenceMip& thisMip = mips.emplace_back();
+		thisMip.Peaks.resize(powerOfTwoSampleCount / 2, 0);
+		thisMip.RMS.resize(powerOfTwoSampleCount / 2, 0);
+		for (size_t i = 0; i < Min(thisMip.Peaks.size(), parentMip.Peaks.size() / 2); i++)
+		{
+			const i16 a = parentMip.RMS[i * 2 + 0], b = parentMip.RMS[i * 2 + 1];
+			thisMip.Peaks[i] = Max(parentMip.Peaks[i * 2 + 0], parentMip.Peaks[i * 2 + 1]);
+			thisMip.RMS[i] = static_cast<i16>(Min<i32>(static_cast<i32>(::sqrtf(static_cast<f32>((static_cast<i32>(a) * a) + (static_cast<i32>(b) * b)) * 0.5f) + 0.5f), I16Max));
+		}
+	}
+	return mips;
+}
+
+// NOTE: Peak and RMS of all frames inside of [frameBegin, frameEnd) computed directly from the source samples, treating frames past the used frame count as silence
+static WaveformAmplitude GetReferenceAmplitudeOfFrames(const PCMSampleBuffer& buffer, u32 channelIndex, i64 usedFrameCount, i64 frameBegin, i64 frameEnd)
+{
+	i16 peak = 0;
+	f64 sumOfSquares = 0.0;
+	for (i64 frame = frameBegin; frame < Min(frameEnd, usedFrameCount); frame++)
+	{
+		const i16 sample = AbsoluteSampleSaturated(buffer.InterleavedSamples[(frame * buffer.ChannelCount) + channelIndex]);
+		peak = Max(peak, sample);
+		sumOfSquares += (static_cast<f64>(sample) * sample);
+	}
+	const f64 rms = (frameEnd > frameBegin) ? ::sqrt(sumOfSquares / static_cast<f64>(frameEnd - frameBegin)) : 0.0;
+	return WaveformAmplitude { peak / static_cast<f32>(I16Max), static_cast<f32>(rms / I16Max) };
+}
+
+static PCMSampleBuffer CreateRandomTestBuffer(std::mt19937& random, i64 frameCount, u32 channelCount)
+{
+	PCMSampleBuffer buffer { channelCount, TestSampleRate, frameCount, UniqueSampleBuffer<i16>(new i16[frameCount * channelCount]) };
+
+	// NOTE: Noise with a slowly changing envelope (so that the peaks differ between buckets) as well as the occasional full scale sample, including I16Min
+	for (i64 frame = 0; frame < frameCount; frame++)
+	{
+		const i32 envelope = 1 + static_cast<i32>((frame / 997) % I16Max);
+		for (u32 c = 0; c < channelCount; c++)
+		{
+			const u32 r = static_cast<u32>(random());
+			buffer.InterleavedSamples[(frame * channelCount) + c] = ((r % 4093) == 0) ? (((r >> 16) & 1) ? I16Min : I16Max) : static_cast<i16>(static_cast<i32>(r % (envelope * 2 + 1)) - envelope);
+		}
+	}
+	return buffer;
+}
+
+struct TestContext
+{
+	size_t FailureCount = 0;
+
+	template <typename... Args>
+	void Fail(Args&&... args) { ((std::cerr << args), ...) << std::endl; FailureCount++; }
+
+	void CompareMipChain(cstr description, const WaveformMipChain& actual, const std::vector<ReferenceMip>& expected)
+	{
+		if (actual.GetUsedMipCount() != static_cast<i32>(expected.size()))
+			return Fail(description, ": Expected ", expected.size(), " mip levels, got ", actual.GetUsedMipCount());
+
+		for (size_t level = 0; level < expected.size(); level++)
+		{
+			const WaveformMip& mip = actual.AllMips[level];
+			if (mip.SampleCount != expected[level].Peaks.size())
+			{
+				Fail(description, ": Mip ", level, ": Expected ", expected[level].Peaks.size(), " samples, got ", mip.SampleCount);
+				continue;
+			}
+
+			for (size_t i = 0; i < mip.SampleCount; i++)
+			{
+				if (mip.PeakSamples[i] != expected[level].Peaks[i] || mip.RMSSamples[i] != expected[level].RMS[i])
+				{
+					Fail(description, ": Mip ", level, " sample ", i, ": Expected peak ", expected[level].Peaks[i], " RMS ", expected[level].RMS[i], ", got peak ", mip.PeakSamples[i], " RMS ", mip.RMSSamples[i]);
+					break;
+				}
+			}
+		}
+	}
+
+	// NOTE: Replaces walking every sample inside each pixel sized time range, so the looked up peak has to cover the entire range
+	//		 while both peak and RMS have to match those of all source frames inside of the (at most two) buckets that were read
+	void CompareAmplitudeLookups(cstr description, const WaveformMipChain& waveform, const PCMSampleBuffer& buffer, u32 channelIndex, std::mt19937& random)
+	{
+		// NOTE: Without the full size mip the odd last frame never makes it into any bucket
+		const WaveformMip& baseMip = waveform.AllMips[0];
+		const i64 usedFrameCount = (buffer.FrameCount / 2) * 2;
+
+		for (size_t q = 0; q < TestQueryCount; q++)
+		{
+			const Time timePerPixel = baseMip.TimePerSample * std::uniform_real_distribution<f64>(1.0, 4096.0)(random);
+			const Time startTime = Time::FromSec(std::uniform_real_distribution<f64>(0.0, waveform.Duration.Seconds)(random));
+			const Time endTime = (startTime + timePerPixel);
+
+			// NOTE: Skip the (interpolated) ranges shorter than a single bucket as well as ranges longer than even the last mip level
+			const WaveformMip& mip = waveform.FindMipForTimeRange(timePerPixel);
+			const i64 mipSampleIndex = static_cast<i64>(Floor(startTime.Seconds * mip.SamplesPerSecond));
+			if (timePerPixel > mip.TimePerSample || static_cast<i64>(Floor(endTime.Seconds * mip.SamplesPerSecond)) <= mipSampleIndex)
+				continue;
+
+			const i64 framesPerMipSample = static_cast<i64>((baseMip.PowerOfTwoSampleCount * 2) / mip.PowerOfTwoSampleCount);
+			const WaveformAmplitude actual = waveform.GetAmplitudeAt(mip, startTime, timePerPixel);
+			const WaveformAmplitude expected = GetReferenceAmplitudeOfFrames(buffer, channelIndex, usedFrameCount, mipSampleIndex * framesPerMipSample, (mipSampleIndex + 2) * framesPerMipSample);
+			const WaveformAmplitude expectedInRange = GetReferenceAmplitudeOfFrames(buffer, channelIndex, usedFrameCount, TimeToFrames(startTime, TestSampleRate), TimeToFrames(endTime, TestSampleRate));
+
+			if (actual.Peak != expected.Peak || !ApproxmiatelySame(actual.RMS, expected.RMS, TestRMSTolerance) || actual.Peak < expectedInRange.Peak)
+			{
+				Fail(description, ": Amplitude at ", startTime.Seconds, " sec over ", timePerPixel.Seconds, " sec: Expected peak ", expected.Peak, " (at least ", expectedInRange.Peak, ") RMS ", expected.RMS, ", got peak ", actual.Peak, " RMS ", actual.RMS);
+				break;
+			}
+		}
+	}
+};
+
+int main()
+{
+	std::mt19937 random(0x5EED);
+	TestContext test {};
+	size_t testCount = 0;
+
+	for (const i64 frameCount : TestFrameCounts)
+	{
+		for (const u32 channelCount : TestChannelCounts)
+		{
+			const PCMSampleBuffer buffer = CreateRandomTestBuffer(random, frameCount, channelCount);
+			std::vector<std::vector<ReferenceMip>> expectedPerChannel;
+			for (u32 c = 0; c < channelCount; c++)
+				expectedPerChannel.push_back(CreateReferenceMips(buffer, c, false));
+
+			const std::string description = std::to_string(frameCount) + " frames, " + std::to_string(channelCount) + " channels";
+			for (u32 c = 0; c < channelCount; c++)
+			{
+				WaveformMipChain waveform {};
+				waveform.GenerateEntireMipChainFromSampleBuffer(buffer, c);
+				test.CompareMipChain((description + ", entire").c_str(), waveform, expectedPerChannel[c]);
+				if (frameCount > 4)
+					test.CompareAmplitudeLookups((description + ", lookup").c_str(), waveform, buffer, c, random);
+
+				WaveformMipChain fullSizeWaveform {};
+				fullSizeWaveform.GenerateEntireMipChainFromSampleBuffer(buffer, c, true);
+				test.CompareMipChain((description + ", full size").c_str(), fullSizeWaveform, CreateReferenceMips(buffer, c, true));
+
+				// NOTE: Copies rebase all of the mip views onto their own storage
+				const WaveformMipChain copiedWaveform = waveform;
+				waveform = WaveformMipChain {};
+				test.CompareMipChain((description + ", copy").c_str(), copiedWaveform, expectedPerChannel[c]);
+
+				WaveformMipChain incrementalWaveform {};
+				incrementalWaveform.BeginIncrementalGeneration(frameCount, TestSampleRate);
+				for (i64 frame = 0; frame < frameCount; frame += TestIncrementalChunkFrameCount)
+					incrementalWaveform.AppendIncrementalFrames(&buffer.InterleavedSamples[frame * channelCount], Min<i64>(TestIncrementalChunkFrameCount, frameCount - frame), channelCount, c);
+				incrementalWaveform.FinishIncrementalGeneration();
+				test.CompareMipChain((description + ", incremental").c_str(), incrementalWaveform, expectedPerChannel[c]);
+				testCount += 4;
+			}
+
+			if (channelCount >= 2)
+			{
+				WaveformMipChain waveformL {}, waveformR {};
+				WaveformMipChain::GenerateStereoMipChainsFromSampleBuffer(buffer, waveformL, waveformR);
+				test.CompareMipChain((description + ", stereo L").c_str(), waveformL, expectedPerChannel[0]);
+				test.CompareMipChain((description + ", stereo R").c_str(), waveformR, expectedPerChannel[1]);
+				testCount += 2;
+			}
+		}
+	}
+
+	std::cout << testCount << " mip chains (" << SIMDInstructionSetNames[static_cast<u8>(GetSupportedSIMDInstructionSet())] << " kernels), " << test.FailureCount << " failures\n";
+	return (test.FailureCount > 0) ? 1 : 0;
+}
@@ -166,4 +166,123 @@ target("PeepoDrumKit_test_fumen")
         add_defines("PEEPO_DEBUG=(1)", "PEEPO_RELEASE=(0)")
     else
         add_defines("PEEPO_DEBUG=(0)", "PEEPO_RELEASE=(1)")
-    end
\ No newline at end of file
+    end
+
+target("PeepoDrumKit_test_beat_sorted_list")
+    set_kind("binary")
+    set_languages("cxxlatest")
+    set_default(false)
+    set_optimize("fastest")
+    add_files("test/beat_sorted_list_benchmark.cpp")
+    add_files("src/core/core_types.cpp")
+    add_includedirs("src")
+    add_includedirs("src/core")
+    add_packages("stb", "libsdl3", "icu4c")
+    if is_mode("debug") then
+        add_defines("PEEPO_DEBUG=(1)", "PEEPO_RELEASE=(0)")
+    else
+        add_defines("PEEPO_DEBUG=(0)", "PEEPO_RELEASE=(1)")
+    end
+
+target("PeepoDrumKit_test_se_notes")
+    set_kind("binary")
+    set_languages("cxxlatest")
+    set_default(false)
+    add_files("test/se_notes_test.cpp")
+    add_files("src/core/*.cpp")
+    add_files("src/peepodrumkit/chart.cpp")
+    add_files("src/peepodrumkit/chart_editor_i18n.cpp")
+    add_includedirs("src")
+    add_includedirs("src/core")
+    add_includedirs("src/peepodrumkit")
+    add_defines("IMGUI_USER_CONFIG=\"imgui/peepodrumkit_imconfig.h\"")
+    add_packages("imgui", "stb", "libsdl3", "icu4c", "gzip-hpp")
+    if is_mode("debug") then
+        add_defines("PEEPO_DEBUG=(1)", "PEEPO_RELEASE=(0)")
+    else
+        add_defines("PEEPO_DEBUG=(0)", "PEEPO_RELEASE=(1)")
+    end
+
+target("PeepoDrumKit_test_tja_large_file")
+    set_kind("binary")
+    set_languages("cxxlatest")
+    set_default(false)
+    add_files("test/tja_large_file_test.cpp")
+    add_files("src/core/*.cpp")
+    add_includedirs("src")
+    add_includedirs("src/core")
+    add_packages("stb", "libsdl3", "icu4c")
+    if is_mode("debug") then
+        add_defines("PEEPO_DEBUG=(1)", "PEEPO_RELEASE=(0)")
+    else
+        add_defines("PEEPO_DEBUG=(0)", "PEEPO_RELEASE=(1)")
+    end
+
+target("PeepoDrumKit_test_tja_round_trip")
+    set_kind("binary")
+    set_languages("cxxlatest")
+    set_default(false)
+    add_files("test/tja_round_trip_test.cpp")
+    add_files("src/core/*.cpp")
+    add_includedirs("src")
+    add_includedirs("src/core")
+    add_packages("stb", "libsdl3", "icu4c")
+    if is_mode("debug") then
+        add_defines("PEEPO_DEBUG=(1)", "PEEPO_RELEASE=(0)")
+    else
+        add_defines("PEEPO_DEBUG=(0)", "PEEPO_RELEASE=(1)")
+    end
+
+target("PeepoDrumKit_test_jpos_scroll")
+    set_kind("binary")
+    set_languages("cxxlatest")
+    set_default(false)
+    add_files("test/jpos_scroll_test.cpp")
+    add_files("src/core/*.cpp")
+    add_files("src/peepodrumkit/chart.cpp")
+    add_files("src/peepodrumkit/chart_editor_i18n.cpp")
+    add_includedirs("src")
+    add_includedirs("src/core")
+    add_includedirs("src/peepodrumkit")
+    add_defines("IMGUI_USER_CONFIG=\"imgui/peepodrumkit_imconfig.h\"")
+    add_packages("imgui", "stb", "libsdl3", "icu4c", "gzip-hpp")
+    if is_mode("debug") then
+        add_defines("PEEPO_DEBUG=(1)", "PEEPO_RELEASE=(0)")
+    else
+        add_defines("PEEPO_DEBUG=(0)", "PEEPO_RELEASE=(1)")
+    end
+
+target("PeepoDrumKit_test_audio_resample")
+    set_kind("binary")
+    set_languages("cxxlatest")
+    set_default(false)
+    add_files("test/audio_resample_test.cpp")
+    add_files("src/core/*.cpp")
+    add_files("src/audio/audio_resample.cpp")
+    add_files("src/audio/audio_simd.cpp")
+    add_includedirs("src")
+    add_includedirs("src/core")
+    add_includedirs("src/audio")
+    add_packages("stb", "libsdl3", "icu4c")
+    if is_mode("debug") then
+        add_defines("PEEPO_DEBUG=(1)", "PEEPO_RELEASE=(0)")
+    else
+        add_defines("PEEPO_DEBUG=(0)", "PEEPO_RELEASE=(1)")
+    end
+
+target("PeepoDrumKit_test_waveform_mip_chain")
+    set_kind("binary")
+    set_languages("cxxlatest")
+    set_default(false)
+    add_files("test/waveform_mip_chain_test.cpp")
+    add_files("src/core/*.cpp")
+    add_files("src/audio/audio_simd.cpp")
+    add_includedirs("src")
+    add_includedirs("src/core")
+    add_includedirs("src/audio")
+    add_packages("stb", "libsdl3", "icu4c")
+    if is_mode("debug") then
+        add_defines("PEEPO_DEBUG=(1)", "PEEPO_RELEASE=(0)")
+    else
+        add_defines("PEEPO_DEBUG=(0)", "PEEPO_RELEASE=(1)")
+    end